@@ -0,0 +1,161 @@
+/**
+ * @file AnimationManager.cpp
+ * @brief Implementierung des Animations-Managers
+ */
+
+#include "AnimationManager.h"
+
+//=============================================================================
+// Animationen (PROGMEM)
+//=============================================================================
+
+namespace Animation {
+
+    const Keyframe STARTUP[9] PROGMEM = {
+        // actions          repeat                  status        r    g    b    ms
+        { FILL,             1,                      0,            0,   0,   0,     0 },  // Alles aus
+        { RAINBOW,          LEDStrip::NUM_ELEMENTS, 0,            0,   0,   0,   200 },  // Element für Element
+        { HOLD,             1,                      0,            0,   0,   0,   800 },  // Alle Elemente leuchten
+        { FILL | STATUS,    1,                      STATUS_GREEN, 0,   0,   0,   200 },  // Strip aus, Grün
+        { STATUS,           1,                      STATUS_YELLOW,0,   0,   0,   200 },  // Gelb
+        { STATUS,           1,                      STATUS_RED,   0,   0,   0,   200 },  // Rot
+        { STATUS,           1,                      0,            0,   0,   0,   200 },  // Pause
+        { STATUS,           1,                      STATUS_ALL,   0,   0,   0,   300 },  // Alle gleichzeitig
+        { FILL | STATUS,    1,                      0,            0,   0,   0,     0 }   // Endzustand: alles aus
+    };
+
+    const Keyframe INIT_BLINK[7] PROGMEM = {
+        // actions          repeat                  status        r    g    b    ms
+        { FILL,             1,                      0,            0,   0, 255,   200 },  // Blau
+        { FILL,             1,                      0,            0,   0,   0,   200 },  // Aus
+        { FILL,             1,                      0,            0,   0, 255,   200 },
+        { FILL,             1,                      0,            0,   0,   0,   200 },
+        { FILL,             1,                      0,            0,   0, 255,   200 },
+        { FILL,             1,                      0,            0,   0,   0,   200 },
+        { FILL,             1,                      0,            0,   0,   0,     0 }   // Endzustand: aus
+    };
+
+} // namespace Animation
+
+//=============================================================================
+// AnimationManager
+//=============================================================================
+
+AnimationManager::AnimationManager(DisplayManager& display)
+    : display(display)
+    , frames(nullptr)
+    , frameCount(0)
+    , frameIndex(0)
+    , repetition(0)
+    , nextStep(0)
+    , onDone(nullptr)
+    , pulseActive(false)
+    , pulsePin(0)
+    , pulseRestore(LOW)
+    , pulseStart(0)
+    , pulseDuration(0) {
+}
+
+void AnimationManager::play(const Animation::Keyframe* frames, uint8_t count, DoneCallback onDone) {
+    // Laufende Animation wird ersetzt (ohne Endzustand, die neue zeichnet ohnehin)
+    this->frames = (count > 0) ? frames : nullptr;
+    this->onDone = onDone;
+    frameCount = count;
+    frameIndex = 0;
+    repetition = 0;
+    nextStep = millis();
+}
+
+void AnimationManager::stop() {
+    if (frames == nullptr) return;
+
+    // Endzustand = letzter Keyframe
+    Animation::Keyframe frame;
+    memcpy_P(&frame, &frames[frameCount - 1], sizeof(frame));
+    apply(frame, frame.repeat > 0 ? frame.repeat - 1 : 0);
+    finish();
+}
+
+void AnimationManager::update() {
+    uint32_t now = millis();
+
+    // LED-Puls beenden
+    if (pulseActive && (now - pulseStart) >= pulseDuration) {
+        digitalWrite(pulsePin, pulseRestore);
+        pulseActive = false;
+    }
+
+    // Alle fälligen Keyframes ausführen (nach einer Verzögerung auch mehrere,
+    // die Änderungen landen im selben Display-Frame)
+    while (frames != nullptr && (int32_t)(now - nextStep) >= 0) {
+        Animation::Keyframe frame;
+        memcpy_P(&frame, &frames[frameIndex], sizeof(frame));
+        apply(frame, repetition);
+
+        // Absoluter Zeitplan: Verzögerungen in loop() verschieben nicht den Rest
+        nextStep += frame.durationMs;
+
+        if (++repetition >= frame.repeat) {
+            repetition = 0;
+            if (++frameIndex >= frameCount) {
+                finish();
+            }
+        }
+    }
+}
+
+void AnimationManager::pulseLed(uint8_t pin, uint16_t durationMs) {
+    if (pulseActive && pulsePin != pin) {
+        // Vorherigen Puls auf anderem Pin sofort beenden
+        digitalWrite(pulsePin, pulseRestore);
+        pulseActive = false;
+    }
+    if (!pulseActive) {
+        pulseRestore = digitalRead(pin);  // Ausgang: liefert den geschriebenen Pegel
+    }
+
+    pulseActive = true;
+    pulsePin = pin;
+    pulseStart = millis();
+    pulseDuration = durationMs;
+    digitalWrite(pin, HIGH);
+}
+
+void AnimationManager::writeLed(uint8_t pin, uint8_t level) {
+    if (pulseActive && pin == pulsePin) {
+        pulseRestore = level;  // Wird nach dem Puls gesetzt
+    } else {
+        digitalWrite(pin, level);
+    }
+}
+
+//=============================================================================
+// Private Hilfsfunktionen
+//=============================================================================
+
+void AnimationManager::apply(const Animation::Keyframe& frame, uint8_t rep) {
+    if (frame.actions & Animation::FILL) {
+        display.fill(CRGB(frame.r, frame.g, frame.b));
+    }
+
+    if (frame.actions & Animation::RAINBOW) {
+        uint8_t hue = (rep * 256) / LEDStrip::NUM_ELEMENTS;
+        display.setElement(rep, CHSV(hue, 255, 255));
+    }
+
+    if (frame.actions & Animation::STATUS) {
+        writeLed(Pins::LED_GREEN, (frame.status & Animation::STATUS_GREEN) ? HIGH : LOW);
+        writeLed(Pins::LED_YELLOW, (frame.status & Animation::STATUS_YELLOW) ? HIGH : LOW);
+        writeLed(Pins::LED_RED, (frame.status & Animation::STATUS_RED) ? HIGH : LOW);
+    }
+}
+
+void AnimationManager::finish() {
+    DoneCallback callback = onDone;
+    frames = nullptr;
+    onDone = nullptr;
+
+    if (callback != nullptr) {
+        callback();
+    }
+}
@@ -0,0 +1,171 @@
+/**
+ * @file AnimationManager.h
+ * @brief Nicht-blockierende Animationen (Keyframes) für LED-Strip und Status-LEDs
+ *
+ * Ersetzt die delay()-basierten Effekte (Regenbogen beim Start, blaues
+ * Blinken bei CMD_INIT, Empfangs-Blinken der gelben LED). Die Animation
+ * wird in loop() weitergeschaltet, der Funkempfang läuft dabei weiter.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "Config.h"
+#include "DisplayManager.h"
+
+namespace Animation {
+
+    /**
+     * @brief Aktionen eines Keyframes (Bitmaske, kombinierbar)
+     */
+    enum Action : uint8_t {
+        HOLD    = 0x00,  // Nichts ändern, nur warten
+        FILL    = 0x01,  // Ganzen Strip auf (r, g, b) setzen
+        RAINBOW = 0x02,  // Element <Wiederholung> in Regenbogenfarbe setzen
+        STATUS  = 0x04   // Status-LEDs laut Maske setzen
+    };
+
+    // Masken für Keyframe::status
+    constexpr uint8_t STATUS_GREEN = 0x01;
+    constexpr uint8_t STATUS_YELLOW = 0x02;
+    constexpr uint8_t STATUS_RED = 0x04;
+    constexpr uint8_t STATUS_ALL = STATUS_GREEN | STATUS_YELLOW | STATUS_RED;
+
+    /**
+     * @brief Ein Schritt einer Animation (liegt im PROGMEM)
+     *
+     * Der Keyframe wird repeat-mal hintereinander ausgeführt, jeweils
+     * gefolgt von durationMs Wartezeit. Der letzte Keyframe einer
+     * Animation beschreibt den Endzustand (wird auch beim Abbruch gesetzt).
+     */
+    struct Keyframe {
+        uint8_t actions;      // Action-Bitmaske
+        uint8_t repeat;       // Anzahl Wiederholungen (RAINBOW: Element 0..repeat-1)
+        uint8_t status;       // Status-LED-Maske (bei STATUS)
+        uint8_t r, g, b;      // Farbe (bei FILL)
+        uint16_t durationMs;  // Wartezeit nach dem Schritt
+    };
+
+    // Start-Animation: Regenbogen über alle Elemente (ca. 5.4s),
+    // danach Status-LEDs Grün → Gelb → Rot → alle
+    extern const Keyframe STARTUP[9] PROGMEM;
+
+    // CMD_INIT: Ganzer Strip 3x blau blinken (1.2s)
+    extern const Keyframe INIT_BLINK[7] PROGMEM;
+
+} // namespace Animation
+
+/**
+ * @brief Manager-Klasse für nicht-blockierende Animationen
+ *
+ * Eine Animation ist eine Keyframe-Tabelle im PROGMEM. update() führt alle
+ * fälligen Keyframes aus (Zeitbasis: absolute Zeitpunkte, kein Aufsummieren
+ * von Verzögerungen). Es läuft immer höchstens eine Animation; stop() bricht
+ * sie sofort ab und setzt ihren Endzustand.
+ *
+ * Zusätzlich kann eine Status-LED kurz aufblinken (pulseLed()). Schreibt die
+ * Anwendung währenddessen über writeLed() auf dieselbe LED, wird der Wert
+ * nach dem Puls übernommen statt überschrieben.
+ *
+ * Usage:
+ * @code
+ * animation.play(Animation::INIT_BLINK, showInitDisplay);
+ * // in loop():
+ * animation.update();
+ * @endcode
+ */
+class AnimationManager {
+public:
+    /**
+     * @brief Callback nach Ende (oder Abbruch) einer Animation
+     */
+    typedef void (*DoneCallback)();
+
+    /**
+     * @brief Konstruktor
+     * @param display Display-Manager, auf den die Animationen zeichnen
+     */
+    AnimationManager(DisplayManager& display);
+
+    /**
+     * @brief Startet eine Animation (bricht eine laufende ab)
+     * @param frames Keyframe-Tabelle im PROGMEM
+     * @param count Anzahl Keyframes
+     * @param onDone Wird nach dem letzten Keyframe aufgerufen (optional)
+     *
+     * Der erste Keyframe wird beim nächsten update() ausgeführt.
+     */
+    void play(const Animation::Keyframe* frames, uint8_t count, DoneCallback onDone = nullptr);
+
+    /**
+     * @brief Startet eine Animation (Anzahl Keyframes aus der Tabelle)
+     */
+    template <uint8_t N>
+    void play(const Animation::Keyframe (&frames)[N], DoneCallback onDone = nullptr) {
+        play(frames, N, onDone);
+    }
+
+    /**
+     * @brief Bricht die laufende Animation ab
+     *
+     * Setzt den Endzustand (letzter Keyframe) und ruft den Callback auf.
+     */
+    void stop();
+
+    /**
+     * @brief Führt fällige Keyframes aus (nicht-blockierend)
+     *
+     * WICHTIG: Muss regelmäßig in loop() aufgerufen werden!
+     */
+    void update();
+
+    /**
+     * @brief Prüft ob eine Animation läuft
+     * @return true wenn Animation aktiv, false sonst
+     */
+    bool isActive() const { return frames != nullptr; }
+
+    /**
+     * @brief Lässt eine Status-LED kurz aufleuchten (nicht-blockierend)
+     * @param pin GPIO-Pin der LED
+     * @param durationMs Leuchtdauer
+     */
+    void pulseLed(uint8_t pin, uint16_t durationMs);
+
+    /**
+     * @brief Setzt eine Status-LED, ohne einen laufenden Puls abzuschneiden
+     * @param pin GPIO-Pin der LED
+     * @param level HIGH oder LOW (gilt nach Ende eines Pulses auf diesem Pin)
+     */
+    void writeLed(uint8_t pin, uint8_t level);
+
+private:
+    DisplayManager& display;
+
+    // Laufende Animation
+    const Animation::Keyframe* frames;  // nullptr = keine Animation
+    uint8_t frameCount;                 // Anzahl Keyframes
+    uint8_t frameIndex;                 // Aktueller Keyframe
+    uint8_t repetition;                 // Aktuelle Wiederholung des Keyframes
+    uint32_t nextStep;                  // Zeitpunkt des nächsten Schritts (millis)
+    DoneCallback onDone;                // Callback nach Ende
+
+    // LED-Puls
+    bool pulseActive;                   // Leuchtet gerade ein Puls?
+    uint8_t pulsePin;                   // Pin des Pulses
+    uint8_t pulseRestore;               // Pegel nach dem Puls
+    uint32_t pulseStart;                // Startzeitpunkt des Pulses
+    uint16_t pulseDuration;             // Dauer des Pulses
+
+    /**
+     * @brief Führt einen Keyframe aus
+     * @param frame Keyframe (bereits aus PROGMEM gelesen)
+     * @param rep Wiederholung (RAINBOW: Element-Index)
+     */
+    void apply(const Animation::Keyframe& frame, uint8_t rep);
+
+    /**
+     * @brief Beendet die Animation und ruft den Callback auf
+     */
+    void finish();
+};
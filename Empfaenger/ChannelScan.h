@@ -0,0 +1,106 @@
+/**
+ * @file ChannelScan.h
+ * @brief Belegung der 2.4 GHz Kanäle (RPD-Scan beim Start)
+ *
+ * Der NRF24L01+ meldet im Empfangsmodus über das RPD-Bit, ob auf dem
+ * eingestellten Kanal mehr als -64dBm ankommen (WLAN, andere Funkampeln,
+ * Handys). Der Scan misst alle 126 Kanäle mehrmals und zählt die Treffer.
+ *
+ * Sender und Empfänger scannen jeweils beim Start auf ihrer Seite. Der
+ * Empfänger meldet seine Werte für die Kanal-Kandidaten in der ACK-Payload
+ * (ReceiverStatus::channelReport), der Sender wählt daraus den Kanal und
+ * handelt ihn mit CMD_CHANNEL aus. Treffpunkt ist immer RF::CHANNEL.
+ *
+ * WICHTIG: Diese Datei MUSS identisch im Sender und Empfänger sein!
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <RF24.h>
+
+/**
+ * @brief RPD-Scan und Belegungskarte aller Kanäle
+ *
+ * Pro Kanal: CE low, Kanal setzen, CE high, 170µs warten (130µs PLL +
+ * 40µs AGC), RPD lesen. Ein Durchlauf über 126 Kanäle dauert damit ca.
+ * 25ms, 8 Durchläufe bleiben deutlich unter einer Sekunde.
+ *
+ * Usage:
+ * @code
+ * ChannelScan channelScan(radio, Pins::NRF_CE);
+ *
+ * // nach radio.begin(), vor dem Öffnen der Pipes:
+ * channelScan.scan(RF::SCAN_PASSES);
+ * radio.setChannel(RF::CHANNEL);
+ *
+ * uint8_t level = channelScan.candidateLevel(3);  // 0 = frei, 15 = belegt
+ * @endcode
+ */
+class ChannelScan {
+public:
+    static constexpr uint8_t CHANNELS = 126;          // Kanal 0-125 (2400-2525 MHz)
+    static constexpr uint8_t CANDIDATES = 16;         // Auswählbare Kanäle (siehe candidateChannel())
+    static constexpr uint8_t MAX_PASSES = 15;         // Treffer werden in 4 Bit gezählt
+    static constexpr uint8_t LEVEL_MAX = 15;          // Belegt (bzw. nicht gemessen)
+    static constexpr uint8_t NO_CANDIDATE = 0xFF;
+
+    ChannelScan(RF24& radio, uint8_t cePin);
+
+    /**
+     * @brief Misst alle Kanäle (blockiert ca. 25ms pro Durchlauf)
+     * @param passes Anzahl Durchläufe (1-15)
+     *
+     * Danach steht das Funkmodul im Standby (CE LOW, noch als Empfänger
+     * konfiguriert) auf Kanal 125 - der Aufrufer setzt Kanal und Modus wieder
+     * (setChannel(), stop-/startListening()).
+     */
+    void scan(uint8_t passes);
+
+    /**
+     * @brief Anzahl Durchläufe des letzten Scans (0 = noch nicht gescannt)
+     */
+    uint8_t passes() const { return passCount; }
+
+    /**
+     * @brief Treffer eines Kanals (0 bis passes())
+     * @param channel Kanal 0-125
+     */
+    uint8_t hits(uint8_t channel) const;
+
+    /**
+     * @brief Belegung rund um einen Kandidaten (Kanal ±1, Mitte doppelt gewichtet)
+     * @param index Kandidat 0 bis CANDIDATES-1
+     * @return 0 (frei) bis LEVEL_MAX (belegt oder nicht gemessen)
+     */
+    uint8_t candidateLevel(uint8_t index) const;
+
+    /**
+     * @brief Kanal eines Kandidaten
+     *
+     * Die Kandidaten liegen im 5 MHz Raster von Kanal 2 bis 77 - innerhalb
+     * des ISM-Bands (bis 2483.5 MHz) und mit Abstand für 2 Mbps.
+     */
+    static constexpr uint8_t candidateChannel(uint8_t index) { return 2 + 5 * index; }
+
+    /**
+     * @brief Kandidat zu einem Kanal
+     * @return Index oder NO_CANDIDATE
+     */
+    static uint8_t candidateOf(uint8_t channel);
+
+    /**
+     * @brief Meldung eines Kandidaten für ReceiverStatus::channelReport
+     * @return Bit 4-7: Index, Bit 0-3: Belegung
+     */
+    uint8_t report(uint8_t index) const { return (uint8_t)((index << 4) | candidateLevel(index)); }
+
+    static constexpr uint8_t reportIndex(uint8_t report) { return report >> 4; }
+    static constexpr uint8_t reportLevel(uint8_t report) { return report & 0x0F; }
+
+private:
+    RF24& radio;
+    uint8_t cePin;
+    uint8_t passCount;
+    uint8_t counts[CHANNELS / 2];   // Treffer, 2 Kanäle pro Byte (gerade: Bit 0-3)
+};
@@ -20,6 +20,7 @@
 #include <Arduino.h>
 #include <avr/pgmspace.h>
 #include <RF24.h>  // Für rf24_pa_dbm_e und rf24_datarate_e
+#include "LedLayout.h"
 
 //=============================================================================
 // HARDWARE PIN-DEFINITIONEN
@@ -39,6 +40,8 @@ namespace Pins {
     //-------------------------------------------------------------------------
     constexpr uint8_t NRF_CE   = 9;   // NRF24 Chip Enable (D9)
     constexpr uint8_t NRF_CSN  = 8;   // NRF24 Chip Select (D8)
+    constexpr uint8_t NRF_IRQ  = 6;   // NRF24 IRQ (D6, PCINT22) - nur mit nachgerüstetem Draht
+                                      // (HARDWARE.md), dann RF::USE_IRQ_PIN = true
 
     //-------------------------------------------------------------------------
     // Ausgänge: Status-LEDs
@@ -72,20 +75,30 @@ namespace Pins {
 namespace RF {
 
     // RF-Kanal (MUSS IDENTISCH MIT SENDER SEIN!)
+    // Treffpunkt beim Start und nach Funkstille, danach wählt der Sender den Kanal
     constexpr uint8_t CHANNEL = 76;  // 2.476 GHz
 
-    // RF-Datenrate (verwende RF24-Library Enums direkt)
-    // RF24_250KBPS = robuster bei schlechten Verbindungen/langen Kabeln!
-    constexpr rf24_datarate_e DATA_RATE = RF24_250KBPS;
+    // Durchläufe des Kanal-Scans beim Start (je ca. 25ms, max. 15)
+    constexpr uint8_t SCAN_PASSES = 8;
 
-    // RF-Power Level (verwende RF24-Library Enums direkt)
-    // RF24_PA_MAX = 0dBm (höchste Leistung, ~50m Reichweite)
-    // WICHTIG: Benötigt externe 3.3V Versorgung (AMS1117) + 100µF Kondensator!
-    constexpr rf24_pa_dbm_e POWER_LEVEL = RF24_PA_HIGH;
+    // Datenrate und Sendeleistung (des ACKs) kommen aus dem Funkprofil:
+    // Start mit RADIO_PROFILE_BASE (Commands.h, 250kbps, PA_HIGH), danach
+    // handelt der Sender das Profil mit CMD_RADIO_PROFILE aus.
+    // WICHTIG: PA_MAX benötigt externe 3.3V Versorgung (AMS1117) + 100µF Kondensator!
 
     // Pipe-Adressen (5 Bytes) - MUSS IDENTISCH MIT SENDER SEIN!
     const uint8_t PIPE_ADDRESS[5] PROGMEM = {'B', '4', 'M', 'P', 'L'};  // "BAMPL" = Bogenampel
 
+    // Anzeige-ID (0 bis MAX_DISPLAYS-1, jede Anzeige am selben Sender braucht eine eigene)
+    // Pipe 1: eigene Adresse mit ACK (Byte 0 = displayAddressByte(DISPLAY_ID))
+    // Pipe 2: Multicast-Adresse ohne ACK (Byte 0 = MULTICAST_ADDRESS_BYTE)
+    // Anzeige 0 ist die Hauptanzeige (Zeitabgleich und Zustands-Rückmeldung am Sender)
+    constexpr uint8_t DISPLAY_ID = 0;
+
+    // Gleiche Sequenznummer innerhalb dieser Zeit: Wiederholung desselben Pakets
+    // (Multicast-Kopie bzw. Einzelabfrage), das Kommando wird nicht erneut ausgeführt
+    constexpr uint16_t DUPLICATE_WINDOW_MS = 500;
+
     // Auto-ACK aktiviert (Empfänger sendet automatisch ACK zurück an Sender)
     constexpr bool AUTO_ACK_ENABLED = true;
 
@@ -94,7 +107,29 @@ namespace RF {
     constexpr uint8_t RETRY_COUNT = 15;   // Max 15 Retries
 
     // Payload-Größe
-    constexpr uint8_t PAYLOAD_SIZE = 2;   // 2 Bytes (Command + Checksum)
+    constexpr uint8_t PAYLOAD_SIZE = 13;  // 13 Bytes (Command + Sequenz + Zustand + CRC-8)
+
+    // Abweichung vom Zustand des Senders, ab der die Passe neu ausgerichtet wird
+    // (Startzeitpunkt laut Paket vs. eigener Startzeitpunkt)
+    constexpr uint16_t STATE_TOLERANCE_MS = 250;
+
+    // Empfang per IRQ-Leitung (Pins::NRF_IRQ)
+    // Auf der Platine ist der IRQ-Pin des Moduls NICHT verbunden - true nur mit
+    // nachgerüstetem Draht an D6 (HARDWARE.md, "Empfänger: IRQ-Leitung nachrüsten"),
+    // sonst empfängt der Empfänger nie ein Paket.
+    // true  = die ISR holt die Pakete in die Warteschlange, loop() schläft bis
+    //         RX_DR (bzw. Timer-Interrupt) und liest ohne SPI, Latenz < 1ms
+    // false = FIFO wird bei jedem Aufwachen abgefragt (Timer0 weckt jede ms)
+    constexpr bool USE_IRQ_PIN = false;
+
+    // Plätze der Empfangswarteschlange (RF24RxQueue, Zweierpotenz, 19 Bytes pro Platz).
+    // Ist sie voll, bleiben die Pakete im RX-FIFO (schon bestätigt, gehen nicht
+    // verloren) und werden nach dem Abarbeiten geholt. Erst wenn auch der FIFO
+    // voll ist, bestätigt das Funkmodul nicht mehr und der Sender wiederholt.
+    constexpr uint8_t RX_QUEUE_SLOTS = 8;
+
+    // Maximale Anzahl Pakete pro loop()-Durchlauf (der Rest folgt im nächsten Durchlauf)
+    constexpr uint8_t RX_BATCH_MAX = 8;
 
 } // namespace RF
 
@@ -122,38 +157,79 @@ namespace Timing {
 
 namespace LEDStrip {
 
-    // LED Strip Konfiguration:
+    // Geometrie-Variante
+    // 0 = Standard: 3 Ziffern, 6 LEDs pro Segment (158 LEDs)
+    // 1 = Großfeld: 4 Ziffern, 8 LEDs pro Segment (256 LEDs)
+    #define LED_LAYOUT_BIG_FIELD 0
+
+    // LED Strip Konfiguration (Standard):
     // - 16 LEDs für Gruppe A/B (LED 1-16, Array Index 0-15)
     // - 16 LEDs für Gruppe C/D (LED 17-32, Array Index 16-31)
     // - 3 Digits × 7 Segmente × 6 LEDs = 126 LEDs (LED 33-158, Array Index 32-157)
     // Total: 158 LEDs
-
-    constexpr uint8_t GROUP_AB_LEDS = 16;      // LEDs 1-16 (Index 0-15)
-    constexpr uint8_t GROUP_CD_LEDS = 16;      // LEDs 17-32 (Index 16-31)
-    constexpr uint8_t GROUP_AB_START = 0;      // Start-Index für Gruppe A/B
-    constexpr uint8_t GROUP_CD_START = 16;     // Start-Index für Gruppe C/D
-
-    constexpr uint8_t LEDS_PER_SEGMENT = 6;    // 6 LEDs pro 7-Segment-Balken
-    constexpr uint8_t SEGMENTS_PER_DIGIT = 7;  // 7 Segmente pro Ziffer (B, A, F, G, C, D, E)
-    constexpr uint8_t NUM_DIGITS = 3;          // 3 Ziffern (1er, 10er, 100er)
-    constexpr uint8_t DIGIT_START = 32;        // Start-Index der 7-Segment-Anzeigen (nach A/B + C/D)
-
-    constexpr uint8_t LEDS_PER_DIGIT = LEDS_PER_SEGMENT * SEGMENTS_PER_DIGIT;  // 42 LEDs pro Ziffer
-    constexpr uint8_t TOTAL_LEDS = GROUP_AB_LEDS + GROUP_CD_LEDS + (NUM_DIGITS * LEDS_PER_DIGIT);  // 158 LEDs
-
-    // Start-Indizes für die einzelnen Ziffern
-    // Physische Hardware-Anordnung im Strip:
+    //
+    // Physische Hardware-Anordnung der Ziffern im Strip:
     // - LED 33-74 (Index 32): Erste Display-Position → 1er-Stelle
     // - LED 75-116 (Index 74): Zweite Display-Position → 10er-Stelle
     // - LED 117-158 (Index 116): Dritte Display-Position → 100er-Stelle
-    constexpr uint8_t DIGIT_1_START = DIGIT_START;                              // LED 33 (Index 32): 1er-Stelle (links)
-    constexpr uint8_t DIGIT_10_START = DIGIT_START + LEDS_PER_DIGIT;           // LED 75 (Index 74): 10er-Stelle (mitte)
-    constexpr uint8_t DIGIT_100_START = DIGIT_START + (2 * LEDS_PER_DIGIT);    // LED 117 (Index 116): 100er-Stelle (rechts)
+    // Segment-Reihenfolge innerhalb einer Ziffer: B, A, F, G, C, D, E
+    //
+    // Alle Tabellen (Segment-Masken, Element-Längen, Stellen) werden daraus
+    // zur Compile-Zeit erzeugt, siehe LedLayout.h.
+#if LED_LAYOUT_BIG_FIELD
+    typedef LedLayout::StripLayout<4, 8, 16, 16, LedLayout::DigitOrder::ONES_FIRST,
+        LedLayout::SEG_B, LedLayout::SEG_A, LedLayout::SEG_F, LedLayout::SEG_G,
+        LedLayout::SEG_C, LedLayout::SEG_D, LedLayout::SEG_E> Layout;
+#else
+    typedef LedLayout::StripLayout<3, 6, 16, 16, LedLayout::DigitOrder::ONES_FIRST,
+        LedLayout::SEG_B, LedLayout::SEG_A, LedLayout::SEG_F, LedLayout::SEG_G,
+        LedLayout::SEG_C, LedLayout::SEG_D, LedLayout::SEG_E> Layout;
+#endif
+
+    constexpr uint8_t GROUP_AB_LEDS = Layout::GROUP_AB_LEDS;            // LEDs 1-16 (Index 0-15)
+    constexpr uint8_t GROUP_CD_LEDS = Layout::GROUP_CD_LEDS;            // LEDs 17-32 (Index 16-31)
+    constexpr uint16_t GROUP_AB_START = Layout::GROUP_AB_START;         // Start-Index für Gruppe A/B
+    constexpr uint16_t GROUP_CD_START = Layout::GROUP_CD_START;         // Start-Index für Gruppe C/D
+
+    constexpr uint8_t LEDS_PER_SEGMENT = Layout::LEDS_PER_SEGMENT;      // 6 LEDs pro 7-Segment-Balken
+    constexpr uint8_t SEGMENTS_PER_DIGIT = Layout::SEGMENTS_PER_DIGIT;  // 7 Segmente pro Ziffer
+    constexpr uint8_t NUM_DIGITS = Layout::NUM_DIGITS;                  // 3 Ziffern (1er, 10er, 100er)
+    constexpr uint16_t DIGIT_START = Layout::DIGIT_START;               // Start-Index der 7-Segment-Anzeigen
+
+    constexpr uint16_t LEDS_PER_DIGIT = Layout::LEDS_PER_DIGIT;         // 42 LEDs pro Ziffer
+    constexpr uint16_t TOTAL_LEDS = Layout::TOTAL_LEDS;                 // 158 LEDs
+    constexpr uint16_t MAX_VALUE = Layout::MAX_VALUE;                   // 999 (größte anzeigbare Zahl)
+
+    // Logische Elemente (Framebuffer des DisplayManagers)
+    // Alle LEDs eines Elements haben immer dieselbe Farbe. Reihenfolge = Strip-Reihenfolge:
+    // - Element 0: Gruppe A/B, Element 1: Gruppe C/D
+    // - Danach je 7 Segmente pro Ziffer (Standard: Element 2-22)
+    constexpr uint8_t NUM_ELEMENTS = Layout::NUM_ELEMENTS;              // 23 Elemente
+    constexpr uint8_t GROUP_AB_ELEMENT = Layout::GROUP_AB_ELEMENT;
+    constexpr uint8_t GROUP_CD_ELEMENT = Layout::GROUP_CD_ELEMENT;
+
+    // Farbpalette: Schwarz + eine eigene Farbe pro Element (Regenbogen-Effekt nutzt 23 Farben)
+    constexpr uint8_t PALETTE_SIZE = NUM_ELEMENTS + 1;
 
     // Helligkeit (0-255)
     constexpr uint8_t BRIGHTNESS_NORMAL = 255;  // 100% Helligkeit
     constexpr uint8_t BRIGHTNESS_DEBUG = 64;    // 25% Helligkeit (255 * 0.25 = 64)
 
+    // Leistungsbudget für den Strip (Powerbank-Port 5V / 2.4A)
+    // 2.0A für die LEDs, der Rest bleibt für Nano, nRF24 und Buzzer.
+    // Volles Rot auf 158 LEDs bräuchte ca. 13.4W → Helligkeit wird pro Frame
+    // so weit reduziert, dass der Strip im Budget bleibt (DisplayManager::commit()).
+    constexpr uint32_t POWER_BUDGET_MW = 5UL * 2000;
+
+    // Interrupt-Fenster beim Strip-Update (FastLED, platforms/avr/clockless_trinket.h)
+    // 1 = Strip wird in Blöcken zu 24 LEDs (ca. 0.7ms) gesendet, dazwischen laufen
+    //     anstehende Interrupts (Timer1-Sekundentakt, millis()). Dauert eine Lücke
+    //     länger als 40µs, wird der Frame nach 300µs Low (Reset, FASTLED_AVR_RESET_US)
+    //     wiederholt (DisplayManager::retriedFrames()).
+    // 0 = Interrupts während des ganzen Updates gesperrt (bis 4.7ms)
+    // Muss vor <FastLED.h> definiert sein → Config.h immer zuerst einbinden!
+    #define FASTLED_AVR_INTERRUPT_WINDOWS 1
+
 } // namespace LEDStrip
 
 //=============================================================================
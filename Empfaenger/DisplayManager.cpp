@@ -4,14 +4,90 @@
  */
 
 #include "DisplayManager.h"
-#include "Config.h"
 
-DisplayManager::DisplayManager(CRGB* ledArray)
-    : leds(ledArray) {
+#ifdef FASTLED_MAX_PIXEL_RUNS
+static_assert(LEDStrip::PALETTE_SIZE <= FASTLED_MAX_PIXEL_RUNS,
+              "Palette/Elemente passen nicht in LedStripController::showRuns() (FASTLED_MAX_PIXEL_RUNS erhöhen)");
+#endif
+
+DisplayManager::DisplayManager()
+    : frameOpen(false),
+      dirtyEnd(0),
+      reportedRetries(0),
+      sentBrightness(0),
+      limitedCount(0) {
+    memset(elements, 0, sizeof(elements));
+    fill_solid(palette, LEDStrip::PALETTE_SIZE, CRGB::Black);
+}
+
+void DisplayManager::begin() {
+    // Kein CRGB-Array: der Controller wird nur für init() und die Refresh-Rate registriert
+    FastLED.addLeds(&strip, nullptr, 0);
+
+    // Zustand des Strips ist unbekannt → erster commit() sendet alles
+    dirtyEnd = LEDStrip::NUM_ELEMENTS;
+}
+
+void DisplayManager::beginFrame() {
+    frameOpen = true;
+}
+
+bool DisplayManager::commit() {
+    frameOpen = false;
+
+    if (dirtyEnd == 0) {
+        return false;  // Nichts geändert → kein Update, keine Interrupt-Sperre
+    }
+
+    // Nur bis zum höchsten geänderten Element senden, der Rest behält seine Farbe
+    uint8_t lengths[LEDStrip::NUM_ELEMENTS];
+    LEDStrip::Layout::copyElementLengths(lengths);
+
+    // Leistungsbudget gilt für den ganzen Strip, nicht nur den gesendeten Teil
+    uint8_t target = FastLED.getBrightness();
+    uint8_t brightness = calculate_max_brightness_for_power_mW(
+        palette, elements, lengths, LEDStrip::NUM_ELEMENTS, target, LEDStrip::POWER_BUDGET_MW);
+    if (brightness < target && limitedCount < 0xFFFF) {
+        limitedCount++;
+    }
+    if (brightness != sentBrightness) {
+        // Nicht gesendete LEDs hätten sonst noch die alte Helligkeit
+        if (brightness < target) {
+            DEBUG_PRINT(F("LED: Helligkeit begrenzt auf "));
+            DEBUG_PRINTLN(brightness);
+        }
+        sentBrightness = brightness;
+        dirtyEnd = LEDStrip::NUM_ELEMENTS;
+    }
+
+    uint16_t maxLeds = 0;
+    for (uint8_t e = 0; e < dirtyEnd; e++) {
+        maxLeds += lengths[e];
+    }
+
+    strip.showRuns(palette, LEDStrip::PALETTE_SIZE, elements, lengths,
+                   LEDStrip::NUM_ELEMENTS, maxLeds, brightness);
+    dirtyEnd = 0;
+
+    if (retriedFrames() != reportedRetries) {
+        reportedRetries = retriedFrames();
+        DEBUG_PRINT(F("LED: Frame wiederholt (ISR-Lücke), gesamt: "));
+        DEBUG_PRINTLN(reportedRetries);
+    }
+    return true;
+}
+
+uint16_t DisplayManager::retriedFrames() const {
+#if FASTLED_AVR_INTERRUPT_WINDOWS
+    return LedStripController::retriedFrames();
+#else
+    return 0;
+#endif
 }
 
 void DisplayManager::displayTimer(uint16_t seconds, CRGB color, bool showLeadingZeros) {
     displayNumber(seconds, color, showLeadingZeros);
+    commitIfIdle();
 }
 
 void DisplayManager::setGroup(uint8_t group, CRGB color) {
@@ -25,90 +101,142 @@ void DisplayManager::setGroup(uint8_t group, CRGB color) {
         setGroupCD(color);
     } else {
         // Keine Gruppe (0xFF oder andere)
-        clearGroups();
+        setGroupAB(CRGB::Black);
+        setGroupCD(CRGB::Black);
     }
+    commitIfIdle();
 }
 
 void DisplayManager::clearGroups() {
     setGroupAB(CRGB::Black);
     setGroupCD(CRGB::Black);
+    commitIfIdle();
+}
+
+void DisplayManager::fill(CRGB color) {
+    setElements(0, LEDStrip::NUM_ELEMENTS, paletteIndex(color, 0, LEDStrip::NUM_ELEMENTS));
+    commitIfIdle();
+}
+
+void DisplayManager::setElement(uint8_t element, CRGB color) {
+    if (element >= LEDStrip::NUM_ELEMENTS) {
+        return;
+    }
+    setElements(element, 1, paletteIndex(color, element, 1));
+    commitIfIdle();
 }
 
 //=============================================================================
 // Private Hilfsfunktionen
 //=============================================================================
 
-void DisplayManager::setGroupAB(CRGB color) {
-    fill_solid(leds + LEDStrip::GROUP_AB_START, LEDStrip::GROUP_AB_LEDS, color);
-    FastLED.show();
-}
+uint8_t DisplayManager::paletteIndex(CRGB color, uint8_t first, uint8_t count) {
+    if (color == CRGB(CRGB::Black)) {
+        return 0;
+    }
 
-void DisplayManager::setGroupCD(CRGB color) {
-    fill_solid(leds + LEDStrip::GROUP_CD_START, LEDStrip::GROUP_CD_LEDS, color);
-    FastLED.show();
-}
+    // Belegung ermitteln: Bit 0 = von irgendeinem Element benutzt,
+    // Bit 1 = von einem Element außerhalb des zu setzenden Bereichs benutzt
+    uint8_t usage[LEDStrip::PALETTE_SIZE] = {0};
+    for (uint8_t e = 0; e < LEDStrip::NUM_ELEMENTS; e++) {
+        usage[elements[e]] |= (e >= first && e < first + count) ? 0x01 : 0x03;
+    }
 
-void DisplayManager::displayNumber(uint16_t number, CRGB color, bool showLeadingZeros) {
-    // Begrenze auf 0-999
-    if (number > 999) {
-        number = 999;
+    // Farbe schon vorhanden? (dann bleibt der Index gleich → kein Update nötig)
+    for (uint8_t i = 1; i < LEDStrip::PALETTE_SIZE; i++) {
+        if ((usage[i] & 0x01) && palette[i] == color) {
+            return i;
+        }
     }
 
-    // Extrahiere einzelne Ziffern
-    uint8_t digit100 = number / 100;
-    uint8_t digit10 = (number / 10) % 10;
-    uint8_t digit1 = number % 10;
+    // Freien Eintrag belegen - es gibt immer einen, da PALETTE_SIZE > NUM_ELEMENTS
+    for (uint8_t i = 1; i < LEDStrip::PALETTE_SIZE; i++) {
+        if (!(usage[i] & 0x02)) {
+            palette[i] = color;
+
+            // Elemente im Bereich, die diesen Eintrag schon nutzen, ändern ihre Farbe
+            for (uint8_t e = first; e < first + count; e++) {
+                if (elements[e] == i) {
+                    markDirty(e);
+                }
+            }
+            return i;
+        }
+    }
 
-    // Zeige Ziffern an
-    // 100er-Stelle
-    if (showLeadingZeros || number >= 100) {
-        displayDigit(LEDStrip::DIGIT_100_START, digit100, color);
-    } else {
-        displayDigit(LEDStrip::DIGIT_100_START, 0, CRGB::Black);  // Ausschalten
+    return 0;  // Nicht erreichbar
+}
+
+void DisplayManager::setElements(uint8_t first, uint8_t count, uint8_t index) {
+    // Nur schreiben, was sich wirklich ändert - sonst bleibt der Frame "sauber"
+    for (uint8_t e = first; e < first + count; e++) {
+        if (elements[e] != index) {
+            elements[e] = index;
+            markDirty(e);
+        }
     }
+}
 
-    // 10er-Stelle
-    if (showLeadingZeros || number >= 10) {
-        displayDigit(LEDStrip::DIGIT_10_START, digit10, color);
-    } else {
-        displayDigit(LEDStrip::DIGIT_10_START, 0, CRGB::Black);  // Ausschalten
+void DisplayManager::markDirty(uint8_t element) {
+    if (element >= dirtyEnd) {
+        dirtyEnd = element + 1;
     }
+}
 
-    // 1er-Stelle: Immer anzeigen
-    displayDigit(LEDStrip::DIGIT_1_START, digit1, color);
+void DisplayManager::commitIfIdle() {
+    if (!frameOpen) {
+        commit();
+    }
+}
 
-    FastLED.show();
+void DisplayManager::setGroupAB(CRGB color) {
+    setElements(LEDStrip::GROUP_AB_ELEMENT, 1, paletteIndex(color, LEDStrip::GROUP_AB_ELEMENT, 1));
 }
 
-void DisplayManager::displayDigit(uint8_t digitStartIndex, uint8_t digit, CRGB color) {
-    // 7-Segment-Mapping für Ziffern 0-9
-    // Jedes Bit repräsentiert ein Segment in der Reihenfolge: B, A, F, G, C, D, E
-    const uint8_t segmentMap[10] = {
-        0b1110111,  // 0: B, A, F, C, D, E (kein G)
-        0b1000100,  // 1: B, C
-        0b1101011,  // 2: B, A, G, D, E
-        0b1101110,  // 3: B, A, G, C, D
-        0b1011100,  // 4: B, F, G, C
-        0b0111110,  // 5: A, F, G, C, D
-        0b0111111,  // 6: A, F, G, C, D, E
-        0b1100100,  // 7: B, A, C
-        0b1111111,  // 8: B, A, F, G, C, D, E (alle)
-        0b1111110   // 9: B, A, F, G, C, D
-    };
+void DisplayManager::setGroupCD(CRGB color) {
+    setElements(LEDStrip::GROUP_CD_ELEMENT, 1, paletteIndex(color, LEDStrip::GROUP_CD_ELEMENT, 1));
+}
 
+void DisplayManager::displayNumber(uint16_t number, CRGB color, bool showLeadingZeros) {
+    // Begrenze auf den Anzeigebereich (999 bei 3 Ziffern)
+    if (number > LEDStrip::MAX_VALUE) {
+        number = LEDStrip::MAX_VALUE;
+    }
+
+    // Von der höchsten Stelle abwärts; Ziffer per Subtraktion (keine Division/Modulo)
+    bool leading = !showLeadingZeros;
+    for (uint8_t place = LEDStrip::NUM_DIGITS; place-- > 0; ) {
+        uint16_t placeValue = LEDStrip::Layout::placeValue(place);
+        uint8_t digit = 0;
+        while (number >= placeValue) {
+            number -= placeValue;
+            digit++;
+        }
+
+        // Führende Nullen ausschalten, 1er-Stelle immer anzeigen
+        if (digit != 0 || place == 0) {
+            leading = false;
+        }
+
+        if (leading) {
+            displayDigit(LEDStrip::Layout::digitElement(place), 0, CRGB::Black);  // Ausschalten
+        } else {
+            displayDigit(LEDStrip::Layout::digitElement(place), digit, color);
+        }
+    }
+}
+
+void DisplayManager::displayDigit(uint8_t firstElement, uint8_t digit, CRGB color) {
     if (digit > 9) {
         digit = 0;  // Fallback auf 0 bei ungültiger Ziffer
     }
 
-    uint8_t pattern = segmentMap[digit];
+    // Segment-Maske in Strip-Reihenfolge (Bit 0 = erstes Segment der Ziffer)
+    uint8_t pattern = LEDStrip::Layout::digitMask(digit);
+    uint8_t colorIndex = paletteIndex(color, firstElement, LEDStrip::SEGMENTS_PER_DIGIT);
 
-    // Segment-Reihenfolge: B, A, F, G, C, D, E
     for (uint8_t seg = 0; seg < LEDStrip::SEGMENTS_PER_DIGIT; seg++) {
-        bool segmentOn = (pattern >> (LEDStrip::SEGMENTS_PER_DIGIT - 1 - seg)) & 0x01;
-        CRGB segmentColor = segmentOn ? color : CRGB::Black;
-
-        // Setze alle 6 LEDs dieses Segments
-        uint8_t segmentStart = digitStartIndex + (seg * LEDStrip::LEDS_PER_SEGMENT);
-        fill_solid(leds + segmentStart, LEDStrip::LEDS_PER_SEGMENT, segmentColor);
+        setElements(firstElement + seg, 1, (pattern & 0x01) ? colorIndex : 0);
+        pattern >>= 1;
     }
 }
@@ -5,25 +5,89 @@
  * Kapselt die Anzeige-Logik für:
  * - 7-Segment Timer-Anzeige (3 Ziffern)
  * - Gruppen-LEDs (A/B und C/D)
+ *
+ * Änderungen werden gesammelt und mit einem einzigen Strip-Update
+ * übertragen (Frame: beginFrame() → Änderungen → commit()).
  */
 
 #pragma once
 
 #include <Arduino.h>
+#include "Config.h"   // Vor FastLED.h (FASTLED_AVR_INTERRUPT_WINDOWS)
 #include <FastLED.h>
 
+/**
+ * @brief LED-Controller für den Strip (WS2812, GRB, Pin aus Config.h)
+ */
+typedef WS2812Controller800Khz<Pins::LED_STRIP, GRB> LedStripController;
+
 /**
  * @brief Manager-Klasse für LED-Strip Anzeige
  *
  * Verwaltet die Anzeige von Timer und Gruppen auf dem LED-Strip.
+ *
+ * Framebuffer: Statt 158 × CRGB (474 Bytes) wird pro logischem Element
+ * (2 Gruppen + 21 Segmente, siehe LEDStrip::Layout) nur ein
+ * Paletten-Index gespeichert. Beim Senden expandiert der Controller die
+ * Elemente direkt in GRB-Bytes (LedStripController::showRuns()), Helligkeit
+ * und Farbkorrektur werden einmal pro Palettenfarbe berechnet.
+ *
+ * Ein Strip-Update dauert ca. 4.7ms bei 158 LEDs. Mit
+ * FASTLED_AVR_INTERRUPT_WINDOWS (Config.h) sind die Interrupts dabei nur
+ * blockweise (max. ca. 0.7ms) gesperrt, der Timer1-Sekundentakt und
+ * millis() laufen ohne Korrektur weiter. Hält eine ISR die Datenleitung zu
+ * lange auf Low, wird der Frame wiederholt (retriedFrames()).
+ * Deshalb werden alle Änderungen innerhalb eines Frames gesammelt und
+ * erst bei commit() übertragen - und nur, wenn sich der Puffer
+ * tatsächlich geändert hat.
+ *
+ * Leistungsbegrenzung: Vor jedem Update wird der Strombedarf des ganzen
+ * Strips aus Palette und Element-Längen geschätzt (23 Elemente statt
+ * 158 LEDs, power_mgt.h). Liegt er über LEDStrip::POWER_BUDGET_MW, wird die
+ * Helligkeit für diesen Frame reduziert (limitedFrames()). Ändert sich die
+ * Helligkeit, wird der komplette Strip neu gesendet.
+ *
+ * Übertragen wird nur der Bereich [0, höchstes geändertes Element]:
+ * WS2812-Pixel hinter der letzten gesendeten LED behalten ihre Farbe.
+ * Eine reine Gruppen-Änderung (LED 0-31) dauert so ca. 1ms statt 4.7ms,
+ * die 1er-Stelle (LED 32-73) ca. 2.2ms.
+ *
+ * Usage:
+ * @code
+ * display.begin();
+ * display.beginFrame();
+ * display.displayTimer(42, CRGB::Green);
+ * display.setGroup(0, CRGB::Green);
+ * display.commit();  // Genau ein Strip-Update (oder keins)
+ * @endcode
+ *
+ * Außerhalb eines Frames wird jede Änderung sofort übertragen.
  */
 class DisplayManager {
 public:
     /**
-     * @brief Konstruktor
-     * @param ledArray Zeiger auf LED-Array (FastLED)
+     * @brief Konstruktor (alle Elemente schwarz)
+     */
+    DisplayManager();
+
+    /**
+     * @brief Initialisiert den LED-Controller
+     *
+     * Der erste commit() danach überträgt den kompletten Strip.
+     * Helligkeit kommt aus FastLED.setBrightness().
+     */
+    void begin();
+
+    /**
+     * @brief Beginnt einen Frame (Änderungen werden bis commit() gesammelt)
      */
-    DisplayManager(CRGB* ledArray);
+    void beginFrame();
+
+    /**
+     * @brief Beendet den Frame und überträgt den Puffer
+     * @return true wenn der Strip aktualisiert wurde, false wenn unverändert
+     */
+    bool commit();
 
     /**
      * @brief Zeigt Timer-Wert auf 7-Segment Anzeige
@@ -45,8 +109,73 @@ public:
      */
     void clearGroups();
 
+    /**
+     * @brief Setzt alle LEDs (Gruppen + 7-Segment) auf eine Farbe
+     * @param color Farbe (CRGB::Black = alles aus)
+     */
+    void fill(CRGB color);
+
+    /**
+     * @brief Setzt ein einzelnes Element (Gruppe oder Segment) auf eine Farbe
+     * @param element Element-Index (0 bis LEDStrip::NUM_ELEMENTS - 1, Strip-Reihenfolge)
+     * @param color Farbe
+     */
+    void setElement(uint8_t element, CRGB color);
+
+    /**
+     * @brief Anzahl Frames, die wegen einer zu langen ISR-Lücke wiederholt wurden
+     * @return Zähler seit Start (bleibt bei 65535 stehen), 0 ohne Interrupt-Fenster
+     */
+    uint16_t retriedFrames() const;
+
+    /**
+     * @brief Anzahl Frames, deren Helligkeit wegen des Leistungsbudgets reduziert wurde
+     * @return Zähler seit Start (bleibt bei 65535 stehen)
+     */
+    uint16_t limitedFrames() const { return limitedCount; }
+
 private:
-    CRGB* leds;  // Zeiger auf LED-Array
+    LedStripController strip;                   // WS2812-Controller (ohne CRGB-Puffer)
+    uint8_t elements[LEDStrip::NUM_ELEMENTS];   // Paletten-Index pro Element
+    CRGB palette[LEDStrip::PALETTE_SIZE];       // Farben, Index 0 ist immer Schwarz
+    bool frameOpen;   // Läuft gerade ein Frame? (beginFrame() aufgerufen)
+    uint8_t dirtyEnd; // Höchstes geändertes Element + 1 seit dem letzten Update (0 = unverändert)
+    uint16_t reportedRetries; // Zuletzt gemeldeter Stand von retriedFrames()
+    uint8_t sentBrightness;   // Helligkeit des zuletzt gesendeten Frames (nach Begrenzung)
+    uint16_t limitedCount;    // Frames mit begrenzter Helligkeit
+
+    /**
+     * @brief Sucht eine Farbe in der Palette oder belegt einen freien Eintrag
+     *
+     * Ein Eintrag ist frei, wenn ihn kein Element außerhalb von
+     * [first, first + count) verwendet - die Elemente im Bereich werden
+     * ohnehin überschrieben.
+     *
+     * @param color Gesuchte Farbe
+     * @param first Erstes Element, das die Farbe bekommt
+     * @param count Anzahl Elemente
+     * @return Paletten-Index
+     */
+    uint8_t paletteIndex(CRGB color, uint8_t first, uint8_t count);
+
+    /**
+     * @brief Setzt Elemente auf einen Paletten-Index und merkt sich Änderungen
+     * @param first Erstes Element
+     * @param count Anzahl Elemente
+     * @param index Paletten-Index
+     */
+    void setElements(uint8_t first, uint8_t count, uint8_t index);
+
+    /**
+     * @brief Markiert ein Element als geändert
+     * @param element Element-Index
+     */
+    void markDirty(uint8_t element);
+
+    /**
+     * @brief Überträgt sofort, wenn kein Frame offen ist
+     */
+    void commitIfIdle();
 
     /**
      * @brief Zeigt eine Zahl auf der 7-Segment Anzeige
@@ -58,11 +187,11 @@ private:
 
     /**
      * @brief Zeigt eine einzelne Ziffer auf 7-Segment Display
-     * @param digitStartIndex Start-Index der Ziffer im LED-Array
+     * @param firstElement Element-Index des ersten Segments der Ziffer
      * @param digit Ziffer (0-9)
      * @param color Farbe der Ziffer
      */
-    void displayDigit(uint8_t digitStartIndex, uint8_t digit, CRGB color);
+    void displayDigit(uint8_t firstElement, uint8_t digit, CRGB color);
 
     /**
      * @brief Setzt Gruppe A/B LEDs
@@ -11,10 +11,16 @@
 #include "Commands.h"
 #include "DisplayManager.h"
 #include "BuzzerManager.h"
+#include "AnimationManager.h"
+#include "Timebase.h"
+#include "PhaseManager.h"
+#include "ChannelScan.h"
 
 #include <SPI.h>
 #include <RF24.h>
+#include <RF24RxQueue.h>
 #include <FastLED.h>
+#include <avr/sleep.h>
 
 //=============================================================================
 // Globale Instanzen
@@ -22,18 +28,29 @@
 
 RF24 radio(Pins::NRF_CE, Pins::NRF_CSN);
 
+// Empfangswarteschlange: die IRQ-ISR holt die Pakete mit Zeitstempel aus dem RX-FIFO
+typedef RF24RxQueue<RF::RX_QUEUE_SLOTS, sizeof(RadioPacket)> RadioRxQueue;
+RadioRxQueue rxQueue(radio, Timebase::now);
+
+// Kanalbelegung (Scan beim Start, wird dem Sender in der ACK-Payload gemeldet)
+ChannelScan channelScan(radio, Pins::NRF_CE);
+uint8_t channelReportIndex = 0;   // Nächster gemeldeter Kandidat
+
 // WS2812B LED Strip
-CRGB leds[LEDStrip::TOTAL_LEDS];
 bool debugMode = false;  // Debug-Modus aktiv (5% Helligkeit)
 
-// Display Manager
-DisplayManager display(leds);
+// Display Manager (besitzt den LED-Controller und den Framebuffer)
+DisplayManager display;
 
 // Buzzer Manager
 BuzzerManager buzzer(Pins::BUZZER, Timing::BUZZER_FREQUENCY_HZ);
 
+// Animation Manager (Start-Animation, INIT-Blinken, Empfangs-Blinken)
+AnimationManager animation(display);
+
 // Forward-Deklarationen
-void showRainbowEffect();
+void showInitDisplay();
+void showIdleDisplay();
 void setTrafficLightColor(CRGB color);
 void updateAlarm();
 
@@ -43,23 +60,59 @@ uint8_t lastButtonReading = HIGH;  // Letzter gelesener Pin-Zustand
 uint8_t buttonState = HIGH;        // Stabiler Button-Zustand nach Debouncing
 uint32_t lastDebounceTime = 0;     // Zeitpunkt der letzten Button-Änderung
 
-// Timer-Variablen (Interrupt-basiert)
-volatile bool secondTickOccurred = false;  // Flag: Sekunden-Tick passiert (wird von ISR gesetzt)
-bool timerRunning = false;         // Läuft der Timer?
-uint32_t timerRemainingSeconds = 0;  // Verbleibende Sekunden (wird jede Sekunde dekrementiert)
-uint32_t timerDurationMs = 0;      // Timer-Dauer in Millisekunden (für Kompatibilität)
+// Funk-Interrupt (nRF24 IRQ an Pins::NRF_IRQ)
+volatile bool radioIrqOccurred = false;    // Flag: Paket empfangen (wird von ISR gesetzt)
+volatile uint32_t radioIrqMicros = 0;      // Zeitpunkt des IRQ (für Latenzmessung)
+
+// Empfangsstatistik (Zähler bleiben bei 65535 stehen)
+struct RxStats {
+    uint16_t packets;      // Gültige Pakete
+    uint16_t coalesced;    // Zusammengefasst (PING, überholte Gruppen-Kommandos)
+    uint16_t badChecksum;  // Verworfen wegen falscher Checksumme oder Länge
+    uint16_t fifoFull;     // RX-FIFO voll (Sender musste wiederholen) oder Warteschlange voll
+    uint16_t duplicates;   // Schon empfangene Sequenznummer (Multicast + Abfrage)
+};
+RxStats rxStats = {0, 0, 0, 0, 0};
+
+// Zuletzt empfangene Sequenznummer (Multicast und Einzelabfrage tragen dasselbe Paket)
+bool rxSeqValid = false;           // Schon ein Paket empfangen?
+uint8_t lastRxSeq = 0;             // Sequenznummer des letzten gültigen Pakets
+uint32_t lastRxSeqTicks = 0;       // Erster Empfang dieser Sequenznummer (Timebase)
+
+// Latenz Funk-IRQ → Beginn des Strip-Updates
+uint32_t latencyLastUs = 0;        // Letzte Messung
+uint32_t latencyMaxUs = 0;         // Maximum seit Start
+uint32_t alarmLatencyMaxUs = 0;    // Maximum für CMD_ALARM (Funk-IRQ → Strip rot)
+uint16_t loopMaxUs = 0;            // Längster loop()-Durchlauf ohne Schlafen (Telemetrie)
+
+// Funkprofil (Datenrate, Sendeleistung des ACKs) und Kanal - vom Sender ausgehandelt, siehe Commands.h
+uint8_t radioProfile = RADIO_PROFILE_BASE;     // Aktives Profil
+uint8_t previousProfile = RADIO_PROFILE_BASE;  // Profil vor dem letzten Wechsel
+uint8_t pendingProfile = RADIO_PROFILE_BASE;   // Angefordertes Profil (noch nicht aktiv)
+uint8_t radioChannel = RF::CHANNEL;            // Aktiver Kanal
+uint8_t previousChannel = RF::CHANNEL;         // Kanal vor dem letzten Wechsel
+uint8_t pendingChannel = RF::CHANNEL;          // Angeforderter Kanal (noch nicht aktiv)
+bool profileSwitchPending = false;             // Wartet ein Wechsel auf seinen Zeitpunkt?
+uint32_t profileSwitchTicks = 0;               // Umschaltzeitpunkt (geplant bzw. zuletzt erfolgt)
+bool profileConfirmed = true;                  // Paket im aktiven Profil empfangen?
+uint32_t lastRxMillis = 0;                     // Letztes gültiges Paket (Funkstille → Startprofil)
+
+// Ergebnis eines Empfangs-Bursts (receiveCommands())
+struct RxBurst {
+    uint8_t commands[RF::RX_BATCH_MAX];  // Kommandos nach dem Zusammenfassen
+    uint8_t count;                       // Anzahl Kommandos
+    bool received;                       // Mindestens ein gültiges Paket?
+    PassState state;                     // Zustand des Senders aus diesem Paket
+};
+
+// Ablauf der Passe (Vorbereitung → Grün → Orange → Rot, absolute Fristen)
+PhaseManager phases;
+uint32_t commandTicks = 0;         // Empfangszeitpunkt der aktuell verarbeiteten Kommandos (erstes Paket des Bursts)
+
 Groups::Type currentGroup = Groups::Type::GROUP_AB;      // Aktuelle Gruppe (AB oder CD)
 Groups::Position currentPosition = Groups::Position::POS_1;  // Aktuelle Position (1 oder 2)
 bool groupsEnabled = true;         // Sind Gruppen aktiv? (false = 1-2 Schützen Modus)
 
-// Vorbereitungsphase
-bool inPreparationPhase = false;   // Läuft die Vorbereitungsphase?
-uint32_t preparationRemainingSeconds = 0;  // Verbleibende Sekunden Vorbereitungsphase
-uint32_t preparationDurationMs = 0; // Dauer der Vorbereitungsphase (für Kompatibilität)
-
-// Tracking für automatischen Gruppenwechsel (bei ganzer Passe POS_1)
-bool firstGroupInPass = true;      // true = erste Gruppe, false = zweite Gruppe
-
 // Alarm State-Variablen (nicht-blockierend)
 bool alarmActive = false;          // Läuft gerade ein Alarm?
 uint8_t alarmBlinkCount = 0;       // Aktueller Blink-Zähler (0-7)
@@ -68,18 +121,25 @@ uint32_t alarmLastToggle = 0;      // Zeitpunkt der letzten LED-Umschaltung
 
 
 //=============================================================================
-// Timer1 Interrupt Service Routine (ISR)
+// Pin-Change Interrupt für nRF24 IRQ
 //=============================================================================
 
+static_assert(Pins::NRF_IRQ == 6, "PCINT2_vect/PIND6 passen nur zu D6 - setupRadioIrq() anpassen");
+
 /**
- * @brief Timer1 Compare Match A Interrupt - wird jede Sekunde ausgelöst
+ * @brief Pin-Change Interrupt (Port D) - nRF24 meldet RX_DR
  *
- * Diese ISR wird exakt jede Sekunde aufgerufen und setzt ein Flag,
- * das in der loop() verarbeitet wird. Dadurch ist die Zeitbasis
- * unabhängig von blocking delays (z.B. Buzzer).
+ * Die IRQ-Leitung ist aktiv LOW, nur die fallende Flanke zählt. Die ISR
+ * leert den RX-FIFO in die Warteschlange (Zeitstempel in Timebase-Ticks),
+ * loop() liest danach ohne SPI. radioIrqMicros dient der Latenzmessung bis
+ * zum Strip-Update.
  */
-ISR(TIMER1_COMPA_vect) {
-    secondTickOccurred = true;
+ISR(PCINT2_vect) {
+    if (!(PIND & _BV(PIND6))) {
+        radioIrqMicros = micros();
+        rxQueue.fetch();
+        radioIrqOccurred = true;
+    }
 }
 
 //=============================================================================
@@ -111,8 +171,9 @@ void setup() {
     // Pins initialisieren
     initializePins();
 
-    // Timer1 für exakte Sekunden-Ticks konfigurieren
-    setupTimer1();
+    // Timer1 als frei laufende Zeitbasis für die Phasen-Fristen starten
+    Timebase::begin();
+    Timebase::startIrqProbe();  // Interrupt-Sperrzeiten für die Telemetrie messen
 
     // Debug-Jumper lesen
     debugMode = (digitalRead(Pins::DEBUG_JUMPER) == LOW);
@@ -121,15 +182,15 @@ void setup() {
 
     // LED Strip initialisieren (WS2812E - neuere Variante)
     // WS2812E verwendet oft GRB statt RGB
-    FastLED.addLeds<WS2812, Pins::LED_STRIP, GRB>(leds, LEDStrip::TOTAL_LEDS);
+    display.begin();
     FastLED.setBrightness(debugMode ? LEDStrip::BRIGHTNESS_DEBUG : LEDStrip::BRIGHTNESS_NORMAL);
-    FastLED.clear();
-    FastLED.show();
+    display.commit();  // Alle LEDs aus
     delay(50);  // Kurze Pause nach Initialisierung
     DEBUG_PRINTLN(F("LED Strip initialisiert"));
 
-    // Regenbogen-Effekt beim Start zeigen
-    showRainbowEffect();
+    // Start-Animation: Regenbogen, danach Status-LEDs (läuft in loop() weiter)
+    DEBUG_PRINTLN(F("Start-Animation..."));
+    animation.play(Animation::STARTUP);
 
     // Radio initialisieren
     DEBUG_PRINTLN(F("Initialisiere NRF24L01..."));
@@ -146,8 +207,10 @@ void setup() {
         DEBUG_PRINTLN(F("NRF24L01 initialisiert"));
     }
 
-    // Start-Sequenz: Alle LEDs kurz blinken
-    startupSequence();
+    // IRQ-Leitung des Funkmoduls aktivieren
+    if (RF::USE_IRQ_PIN) {
+        setupRadioIrq();
+    }
 
     DEBUG_PRINTLN(F("Setup abgeschlossen\n"));
     DEBUG_PRINTLN(F("Warte auf Kommandos vom Sender..."));
@@ -158,49 +221,81 @@ void setup() {
 //=============================================================================
 
 void loop() {
-    // Prüfe ob Daten verfügbar
-    if (radio.available()) {
-        // Empfange RadioPacket
-        RadioPacket packet;
-        radio.read(&packet, sizeof(RadioPacket));
-
-        DEBUG_PRINT(F("RX:"));
-        DEBUG_PRINTLN(packet.command, HEX);
-
-        // Validiere Checksum
-        if (validateChecksum(&packet)) {
-            // Gelbe LED blinken lassen (Empfangsbestätigung)
+    uint32_t loopStart = micros();
+
+    // Alle LED-Änderungen dieser Iteration sammeln (ein Strip-Update am Ende)
+    display.beginFrame();
+
+    // Funk hat Vorrang: Warteschlange abarbeiten, wenn die ISR Pakete geholt hat
+    // (ohne IRQ-Leitung den FIFO bei jedem Aufwachen abfragen)
+    bool commandReceived = false;
+    bool alarmReceived = false;
+    uint32_t rxMicros = 0;
+    RxBurst burst;
+    burst.received = false;
+    if (takeRadioEvent(rxMicros)) {
+        // Ganzen Burst holen und zusammenfassen, dann einmal verarbeiten
+        receiveCommands(burst);
+
+        if (burst.count > 0) {
+            // Gelbe LED blinken lassen (Empfangsbestätigung, einmal pro Burst)
             blinkYellowLED();
 
-            // Kommando verarbeiten
-            handleCommand(static_cast<RadioCommand>(packet.command));
-        } else {
-            DEBUG_PRINTLN(F("BAD CRC"));
+            // Kommandos in Empfangsreihenfolge verarbeiten - alle landen im selben Frame
+            for (uint8_t i = 0; i < burst.count; i++) {
+                handleCommand(static_cast<RadioCommand>(burst.commands[i]), burst.state);
+                if (burst.commands[i] == CMD_ALARM) {
+                    alarmReceived = true;
+                }
+            }
+            commandReceived = true;
+        }
+
+        // Verlorene Kommandos anhand des mitgesendeten Zustands nachholen
+        if (burst.received) {
+            reconcileState(burst.state);
         }
     }
 
-    // Prüfe ob eine Sekunde vergangen ist (Interrupt-Flag)
-    if (secondTickOccurred) {
-        secondTickOccurred = false;  // Flag zurücksetzen
+    // Funkprofil/Kanal umschalten bzw. zurückfallen (nach der ACK-Frist)
+    updateRadioProfile();
 
-        // Prüfe Vorbereitungsphase
-        updatePreparation();
+    // Phasen- und Sekundengrenzen der Passe (zeichnet nur bei Änderung)
+    updatePhases();
 
-        // Prüfe Timer und aktualisiere LEDs
-        updateTimer();
+    // Zeitabgleich und Telemetrie erst nach der Verarbeitung bereitlegen
+    // (der Sender sieht so den Zustand NACH seinem Paket)
+    if (burst.received) {
+        loadAckPayload(lastRxSeq, lastRxSeqTicks);
     }
 
     // Aktualisiere Buzzer-Zustand (nicht-blockierend, muss jede Iteration laufen)
     buzzer.update();
 
+    // Animationen weiterschalten (nach dem Funkempfang: neue Kommandos haben Vorrang)
+    animation.update();
+
     // Aktualisiere Alarm-Zustand (nicht-blockierend)
     updateAlarm();
 
     // Prüfe Debug-Button (nicht zeitkritisch)
     checkButton();
 
-    // Kleine Pause um CPU zu entlasten
-    delay(10);
+    // LED-Strip übertragen (nur wenn sich etwas geändert hat)
+    uint32_t showMicros = micros();
+    display.commit();
+    if (commandReceived) {
+        reportLatency(showMicros - rxMicros, alarmReceived);
+    }
+
+    uint32_t loopUs = micros() - loopStart;
+    if (loopUs > loopMaxUs) {
+        loopMaxUs = (loopUs > 0xFFFF) ? 0xFFFF : loopUs;
+    }
+
+    // Schlafen bis zum nächsten Interrupt (Funk-IRQ, Timer0 jede ms für die
+    // Fristen von Passe, Buzzer, Animation und Alarm)
+    sleepUntilEvent();
 }
 
 //=============================================================================
@@ -238,40 +333,301 @@ void initializePins() {
 }
 
 /**
- * @brief Konfiguriert Timer1 für exakte 1-Sekunden-Interrupts
+ * @brief Aktiviert den Pin-Change Interrupt für die nRF24 IRQ-Leitung
+ *
+ * Das Modul meldet nur RX_DR (Paket empfangen), TX_DS und MAX_RT sind
+ * maskiert - der Empfänger sendet nur automatische ACKs. Ab hier sperrt
+ * jede SPI-Transaktion aus loop() die Interrupts (SPI.usingInterrupt), die
+ * ISR liest den FIFO also nie mitten in einen anderen Zugriff hinein.
+ */
+void setupRadioIrq() {
+    pinMode(Pins::NRF_IRQ, INPUT_PULLUP);  // Ohne Modul/Draht bleibt der Pin HIGH
+    rxQueue.begin(255);                    // Pin-Change Interrupt: keine Interrupt-Nummer
+
+    cli();
+    PCMSK2 |= (1 << PCINT22);  // Nur D6 im Port-D-Block
+    PCIFR = (1 << PCIF2);      // Alte Flanken verwerfen
+    PCICR |= (1 << PCIE2);
+    sei();
+
+    // Paket schon vor der Aktivierung angekommen? → jetzt abholen (keine Flanke mehr)
+    if (digitalRead(Pins::NRF_IRQ) == LOW) {
+        cli();
+        radioIrqMicros = micros();
+        rxQueue.fetch();
+        radioIrqOccurred = true;
+        sei();
+    }
+
+    DEBUG_PRINTLN(F("NRF IRQ an D6 aktiv"));
+}
+
+/**
+ * @brief Holt ein anstehendes Funk-Ereignis ab
+ * @param rxMicros Zeitpunkt des Ereignisses (micros())
+ * @return true wenn Pakete in der Warteschlange stehen können
  *
- * Timer1 ist ein 16-Bit-Timer auf dem ATmega328P.
- * Mit Prescaler 256 und einem Compare-Wert von 62499:
- * - F_CPU = 16 MHz
- * - Prescaler = 256
- * - Timer-Takt = 16 MHz / 256 = 62.5 kHz
- * - Für 1 Hz: 62.5 kHz / 62500 = 1 Hz (exakt 1 Sekunde)
+ * Ohne IRQ-Leitung wird der RX-FIFO hier abgefragt (bei jedem Aufwachen).
  */
-void setupTimer1() {
-    cli();  // Interrupts temporär deaktivieren
+bool takeRadioEvent(uint32_t& rxMicros) {
+    if (!RF::USE_IRQ_PIN) {
+        rxMicros = micros();
+        rxQueue.fetch();
+        return rxQueue.available();
+    }
+
+    bool pending;
+    cli();
+    pending = radioIrqOccurred;
+    radioIrqOccurred = false;
+    rxMicros = radioIrqMicros;
+    sei();
+    return pending;
+}
+
+/**
+ * @brief Liest alle anstehenden Pakete aus der Warteschlange und fasst sie zusammen
+ *
+ * - SYNC (Beacon) trägt nur Zustand und Zeitabgleich und wird nicht weitergegeben
+ * - PING ändert nichts an der Anzeige: entfällt, sobald ein anderes
+ *   Kommando im Burst ist (höchstens ein PING bleibt übrig)
+ * - Zwei Gruppen-Kommandos direkt hintereinander: das zweite ersetzt das
+ *   erste (alle CMD_GROUP_* führen applyGroups() mit demselben, neuesten
+ *   Zustand aus - das frühere hätte keine eigene Wirkung)
+ * - Alle anderen Kommandos bleiben in Empfangsreihenfolge erhalten
+ *
+ * Vom Zustand des Senders zählt nur das letzte gültige Paket (es ist das
+ * neueste). Die ACK-Payload legt loop() nach der Verarbeitung bereit.
+ *
+ * @param burst Kommandos, Sequenznummer und Zustand des Senders
+ */
+void receiveCommands(RxBurst& burst) {
+    uint8_t* commands = burst.commands;
+    uint8_t count = 0;
+    burst.received = false;
+    #if DEBUG_ENABLED
+    RxStats before = rxStats;
+    #endif
+
+    // Voller FIFO (weitere Pakete nicht bestätigt, Sender wiederholt) bzw.
+    // volle Warteschlange (Pakete warten im FIFO) - zählt die ISR
+    uint16_t overflows = rxQueue.overflows();
+    if (overflows != rxStats.fifoFull) {
+        rxStats.fifoFull = overflows;
+        DEBUG_PRINTLN(F("RX FIFO voll"));
+    }
+
+    RadioRxQueue::Packet rx;
+    for (uint8_t n = 0; n < RF::RX_BATCH_MAX && rxQueue.read(rx); n++) {
+        // Falsche Länge (z.B. altes Protokoll, 0 = vom Funkmodul verworfen)
+        if (rx.length != sizeof(RadioPacket)) {
+            countUp(rxStats.badChecksum);
+            DEBUG_PRINTLN(F("BAD SIZE"));
+            continue;
+        }
+
+        RadioPacket packet;
+        memcpy(&packet, rx.payload, sizeof(RadioPacket));
+
+        DEBUG_PRINT(F("RX:"));
+        DEBUG_PRINTLN(packet.command, HEX);
+
+        if (!validateChecksum(&packet)) {
+            countUp(rxStats.badChecksum);
+            DEBUG_PRINTLN(F("BAD CRC"));
+            continue;
+        }
+        countUp(rxStats.packets);
+        if (!burst.received) {
+            commandTicks = rx.timestamp;
+        }
+        burst.received = true;
+        lastRxMillis = millis();
+
+        // Erstes Paket im neuen Funkprofil: Wechsel bestätigt
+        if (!profileConfirmed && !profileSwitchPending && Timebase::reached(rx.timestamp, profileSwitchTicks)) {
+            profileConfirmed = true;
+            DEBUG_PRINTLN(F("Profil OK"));
+        }
+        burst.state = packet.state;
+
+        // Schon empfangen (Multicast-Kopie bzw. Einzelabfrage desselben Pakets):
+        // nur der Zustand zählt, das Kommando wurde bereits ausgeführt
+        if (rxSeqValid && packet.seq == lastRxSeq &&
+            rx.timestamp - lastRxSeqTicks < Timebase::fromMillis(RF::DUPLICATE_WINDOW_MS)) {
+            countUp(rxStats.duplicates);
+            continue;
+        }
+        rxSeqValid = true;
+        lastRxSeq = packet.seq;
+        lastRxSeqTicks = rx.timestamp;
+
+        uint8_t cmd = packet.command;
+        if (cmd == CMD_SYNC) {
+            // Beacon: nur Zustand und ACK-Payload, kein Ereignis
+            continue;
+        } else if (cmd == CMD_RADIO_PROFILE) {
+            // Funkprofil: wird nach dem ACK umgeschaltet, kein Ereignis
+            if (isValidRadioProfile(packet.state.param)) {
+                scheduleRadioSettings(packet.state.param, radioChannel);
+            }
+            continue;
+        } else if (cmd == CMD_CHANNEL) {
+            // Kanal: ebenso
+            if (isValidChannel(packet.state.param)) {
+                scheduleRadioSettings(radioProfile, packet.state.param);
+            }
+            continue;
+        } else if (count > 0 && commands[count - 1] == CMD_PING) {
+            // Vorheriger PING wird vom neuen Kommando ersetzt
+            count--;
+            countUp(rxStats.coalesced);
+        } else if (count > 0 && cmd == CMD_PING) {
+            // PING nach einem Kommando: nichts zu tun
+            countUp(rxStats.coalesced);
+            continue;
+        } else if (count > 0 && isGroupCommand(cmd) && isGroupCommand(commands[count - 1])) {
+            // Vorherige Gruppen-Auswahl wird von der neuen ersetzt
+            count--;
+            countUp(rxStats.coalesced);
+        }
+        commands[count++] = cmd;
+    }
 
-    // Timer1 zurücksetzen
-    TCCR1A = 0;
-    TCCR1B = 0;
-    TCNT1 = 0;
+    // Warteschlange war voll: die übrigen Pakete liegen noch im RX-FIFO und
+    // halten die IRQ-Leitung LOW (keine neue Flanke) → jetzt abholen
+    if (RF::USE_IRQ_PIN && rxQueue.stalled()) {
+        cli();
+        rxQueue.fetch();
+        sei();
+    }
 
-    // Compare-Wert setzen für 1 Hz (1 Sekunde)
-    // OCR1A = (F_CPU / (Prescaler * gewünschte Frequenz)) - 1
-    // OCR1A = (16000000 / (256 * 1)) - 1 = 62499
-    OCR1A = 62499;
+    // Restliche Pakete lösen keinen neuen IRQ aus → nächster Durchlauf
+    if (rxQueue.available()) {
+        radioIrqOccurred = true;
+    }
 
-    // CTC-Modus (Clear Timer on Compare Match)
-    TCCR1B |= (1 << WGM12);
+    #if DEBUG_ENABLED
+    if (rxStats.coalesced != before.coalesced || rxStats.fifoFull != before.fifoFull ||
+        rxStats.badChecksum != before.badChecksum || rxStats.duplicates != before.duplicates) {
+        DEBUG_PRINT(F("RX pkt/coal/dup/crc/full: "));
+        DEBUG_PRINT(rxStats.packets);
+        DEBUG_PRINT(F("/"));
+        DEBUG_PRINT(rxStats.coalesced);
+        DEBUG_PRINT(F("/"));
+        DEBUG_PRINT(rxStats.duplicates);
+        DEBUG_PRINT(F("/"));
+        DEBUG_PRINT(rxStats.badChecksum);
+        DEBUG_PRINT(F("/"));
+        DEBUG_PRINTLN(rxStats.fifoFull);
+    }
+    #endif
 
-    // Prescaler 256
-    TCCR1B |= (1 << CS12);
+    burst.count = count;
+}
 
-    // Timer1 Compare Match A Interrupt aktivieren
-    TIMSK1 |= (1 << OCIE1A);
+/**
+ * @brief Legt die ACK-Payload für das nächste Paket bereit
+ * @param seq Sequenznummer des zuletzt empfangenen Pakets
+ * @param rxTicks Erster Empfangszeitpunkt dieses Pakets (Timebase-Ticks, bei Multicast die Kopie)
+ *
+ * Enthält neben dem Zeitabgleich den aktuellen Zustand und die
+ * Diagnosezähler (ReceiverStatus). Ältere, noch nicht abgeholte Payloads
+ * werden verworfen (der Sender kann nur die Messung zum zuletzt
+ * bestätigten Paket verwerten).
+ */
+void loadAckPayload(uint8_t seq, uint32_t rxTicks) {
+    AckPayload ack;
+    ack.seq = seq;
+    ack.rxTicks = rxTicks;
+
+    ReceiverStatus& status = ack.status;
+    status.phase = currentPassPhase();
+    status.group = !groupsEnabled ? PASS_GROUP_NONE
+                 : (currentGroup == Groups::Type::GROUP_AB) ? PASS_GROUP_AB : PASS_GROUP_CD;
+    status.position = (currentPosition == Groups::Position::POS_2) ? 2 : 1;
+    status.remainingSeconds = phases.remainingSeconds();
+    status.rxPackets = rxStats.packets;
+    status.badCrc = rxStats.badChecksum;
+    status.fifoOverflows = rxStats.fifoFull;
+    status.maxLoopUs = loopMaxUs;
+
+    uint32_t irqOffUs = (uint32_t)Timebase::maxIrqDelay() * (1000000UL / Timebase::TICKS_PER_SECOND);
+    status.maxIrqOffUs = (irqOffUs > 0xFFFF) ? 0xFFFF : irqOffUs;
+
+    // Kanal-Messung: ein Kandidat pro ACK, reihum
+    status.channelReport = channelScan.report(channelReportIndex);
+    channelReportIndex = (channelReportIndex + 1) % ChannelScan::CANDIDATES;
+
+    radio.flush_tx();
+    radio.writeAckPayload(1, &ack, sizeof(AckPayload));
+}
 
-    sei();  // Interrupts wieder aktivieren
+/**
+ * @brief Eigene Phase in der Codierung des Protokolls (für die Telemetrie)
+ * @return PassPhase (Ende der Passe zählt als PHASE_IDLE)
+ */
+uint8_t currentPassPhase() {
+    if (alarmActive) return PHASE_ALARM;
+
+    switch (phases.phase()) {
+        case PhaseManager::Phase::PREPARATION:
+            return PHASE_PREPARATION;
+        case PhaseManager::Phase::SHOOTING:
+        case PhaseManager::Phase::WARNING:
+            return PHASE_SHOOTING;
+        default:
+            return PHASE_IDLE;
+    }
+}
 
-    DEBUG_PRINTLN(F("Timer1 konfiguriert (1s Ticks)"));
+/**
+ * @brief Erhöht einen Statistik-Zähler (bleibt bei 65535 stehen)
+ * @param counter Zähler
+ */
+void countUp(uint16_t& counter) {
+    if (counter < 0xFFFF) {
+        counter++;
+    }
+}
+
+/**
+ * @brief Legt die CPU schlafen (Idle), bis ein Interrupt auftritt
+ *
+ * Im Idle-Modus laufen Timer0/Timer1 und der Pin-Change Interrupt weiter.
+ * Steht schon ein Funk-Ereignis an, wird nicht geschlafen. sei() direkt vor
+ * sleep_cpu() garantiert, dass kein Interrupt dazwischen verloren geht.
+ */
+void sleepUntilEvent() {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    cli();
+    if (!radioIrqOccurred) {
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    sei();
+}
+
+/**
+ * @brief Erfasst die Latenz vom Funk-IRQ bis zum Beginn des Strip-Updates
+ * @param latencyUs Gemessene Latenz in µs
+ * @param alarm Burst enthielt CMD_ALARM (eigenes Maximum)
+ */
+void reportLatency(uint32_t latencyUs, bool alarm) {
+    latencyLastUs = latencyUs;
+    if (latencyUs > latencyMaxUs) {
+        latencyMaxUs = latencyUs;
+    }
+    if (alarm && latencyUs > alarmLatencyMaxUs) {
+        alarmLatencyMaxUs = latencyUs;
+    }
+
+    DEBUG_PRINT(alarm ? F("ALARM LAT us: ") : F("LAT us: "));
+    DEBUG_PRINT(latencyLastUs);
+    DEBUG_PRINT(F(" max "));
+    DEBUG_PRINTLN(alarm ? alarmLatencyMaxUs : latencyMaxUs);
 }
 
 /**
@@ -311,73 +667,166 @@ bool initializeRadio() {
         return false;  // Hardware nicht gefunden
     }
 
-    // Pipe-Adresse aus PROGMEM laden
+    // Pipe-Adresse aus PROGMEM laden, Byte 0 = eigene Anzeige-ID
     uint8_t pipeAddr[5];
     memcpy_P(pipeAddr, RF::PIPE_ADDRESS, 5);
+    pipeAddr[0] = displayAddressByte(RF::DISPLAY_ID);
 
-    // Radio konfigurieren
-    radio.setPALevel(RF::POWER_LEVEL);
-    radio.setDataRate(RF::DATA_RATE);
+    // Kanalbelegung messen (ca. 200ms, vor dem Öffnen der Pipes: kein Paket wird angenommen)
+    channelScan.scan(RF::SCAN_PASSES);
+
+    // Radio konfigurieren (Startprofil auf dem Treffpunkt, danach handelt der Sender aus)
+    radio.setPALevel(profilePaLevel(RADIO_PROFILE_BASE));
+    radio.setDataRate(dataRateOf(RADIO_PROFILE_BASE));
     radio.setChannel(RF::CHANNEL);
-    radio.setPayloadSize(sizeof(RadioPacket));
 
     // Auto-ACK AKTIVIERT (Empfänger sendet automatisch ACK an Sender)
     radio.setAutoAck(RF::AUTO_ACK_ENABLED);
     radio.setRetries(RF::RETRY_DELAY, RF::RETRY_COUNT);
 
-    // Pipe für Lesen öffnen (Pipe 1)
+    // Dynamische Payload-Länge auf ALLEN Pipes: enableAckPayload() schaltet sie
+    // nur für Pipe 0/1 ein, Pipe 2 (Multicast) bliebe sonst bei 32 Bytes fest
+    // und jede Multicast-Kopie fiele durch die Längenprüfung
+    radio.enableDynamicPayloads();
+
+    // ACK-Payloads für den Zeitabgleich (benötigt dynamische Payload-Länge)
+    radio.enableAckPayload();
+
+    // Multicast-Pakete des Senders tragen das NO_ACK-Flag
+    radio.enableDynamicAck();
+
+    // Pipe 1: eigene Adresse (mit ACK und ACK-Payload)
     radio.openReadingPipe(1, pipeAddr);
 
+    // Pipe 2: Multicast an alle Anzeigen (Bytes 1-4 teilt sie mit Pipe 1)
+    pipeAddr[0] = MULTICAST_ADDRESS_BYTE;
+    radio.openReadingPipe(2, pipeAddr);
+
     // RX-Modus aktivieren (Empfangsmodus)
     radio.startListening();
 
     #if DEBUG_ENABLED
     DEBUG_PRINT(F("NRF Ch"));
     DEBUG_PRINT(RF::CHANNEL);
-    DEBUG_PRINTLN(F(" RX"));
+    DEBUG_PRINT(F(" RX ID"));
+    DEBUG_PRINTLN(RF::DISPLAY_ID);
     #endif
 
     return true;
 }
 
 /**
- * @brief Start-Sequenz: Alle LEDs kurz aufblinken
+ * @brief Datenrate eines Funkprofils
+ * @param profile Funkprofil (siehe makeRadioProfile())
+ * @return RF24-Datenrate
  */
-void startupSequence() {
-    DEBUG_PRINTLN(F("Start-Sequenz..."));
+rf24_datarate_e dataRateOf(uint8_t profile) {
+    switch (profileRate(profile)) {
+        case RADIO_RATE_1M: return RF24_1MBPS;
+        case RADIO_RATE_2M: return RF24_2MBPS;
+        default:            return RF24_250KBPS;
+    }
+}
 
-    // Grün → Gelb → Rot
-    digitalWrite(Pins::LED_GREEN, HIGH);
-    delay(200);
-    digitalWrite(Pins::LED_GREEN, LOW);
+/**
+ * @brief Plant den Wechsel von Funkprofil oder Kanal (CMD_RADIO_PROFILE, CMD_CHANNEL)
+ * @param profile Angefordertes Profil
+ * @param channel Angeforderter Kanal
+ *
+ * Das ACK auf das Kommando geht noch mit den alten Einstellungen hinaus -
+ * umgeschaltet wird erst PROFILE_SWITCH_DELAY_MS nach dem Empfang.
+ */
+void scheduleRadioSettings(uint8_t profile, uint8_t channel) {
+    pendingProfile = profile;
+    pendingChannel = channel;
+    profileSwitchTicks = commandTicks + Timebase::fromMillis(PROFILE_SWITCH_DELAY_MS);
+    profileSwitchPending = true;
+}
 
-    digitalWrite(Pins::LED_YELLOW, HIGH);
-    delay(200);
-    digitalWrite(Pins::LED_YELLOW, LOW);
+/**
+ * @brief Schaltet geplante Einstellungen um und überwacht den Wechsel
+ *
+ * - Kommt innerhalb von PROFILE_CONFIRM_MS nach dem Wechsel kein Paket an,
+ *   gelten wieder die vorherigen Einstellungen (der Sender hat den PING nicht
+ *   durchbekommen).
+ * - Nach PROFILE_SILENCE_MS ohne gültiges Paket gilt RADIO_PROFILE_BASE auf
+ *   RF::CHANNEL (dort sucht auch der Sender nach einem Verbindungsabbruch).
+ */
+void updateRadioProfile() {
+    uint32_t now = Timebase::now();
+
+    if (profileSwitchPending) {
+        if (!Timebase::reached(now, profileSwitchTicks)) return;
+
+        profileSwitchPending = false;
+        if (pendingProfile != radioProfile || pendingChannel != radioChannel) {
+            previousProfile = radioProfile;
+            previousChannel = radioChannel;
+            applyRadioSettings(pendingProfile, pendingChannel);
+            profileSwitchTicks = now;
+            profileConfirmed = false;
+        }
+        return;
+    }
 
-    digitalWrite(Pins::LED_RED, HIGH);
-    delay(200);
-    digitalWrite(Pins::LED_RED, LOW);
+    if (!profileConfirmed &&
+        Timebase::reached(now, profileSwitchTicks + Timebase::fromMillis(PROFILE_CONFIRM_MS))) {
+        DEBUG_PRINTLN(F("Profil nicht bestaetigt"));
+        applyRadioSettings(previousProfile, previousChannel);
+        profileConfirmed = true;
+        return;
+    }
+
+    bool atBase = (radioProfile == RADIO_PROFILE_BASE && radioChannel == RF::CHANNEL);
+    if (!atBase && millis() - lastRxMillis >= PROFILE_SILENCE_MS) {
+        DEBUG_PRINTLN(F("Funkstille: Startprofil"));
+        applyRadioSettings(RADIO_PROFILE_BASE, RF::CHANNEL);
+        profileConfirmed = true;
+    }
+}
 
-    delay(200);
+/**
+ * @brief Stellt Kanal, Datenrate und Sendeleistung (ACK) des Funkmoduls um
+ * @param profile Funkprofil
+ * @param channel Kanal
+ */
+void applyRadioSettings(uint8_t profile, uint8_t channel) {
+    radio.stopListening();
+    radio.setChannel(channel);
+    radio.setDataRate(dataRateOf(profile));
+    radio.setPALevel(profilePaLevel(profile));
+    radio.startListening();
+    radioProfile = profile;
+    radioChannel = channel;
+
+    // startListening() löscht die Status-Flags - wartende Pakete trotzdem abholen
+    // (ohne fallende Flanke kommt keine ISR; fetch() außerhalb der ISR nur mit cli())
+    if (RF::USE_IRQ_PIN) {
+        cli();
+        rxQueue.fetch();
+        if (rxQueue.available()) {
+            radioIrqOccurred = true;
+        }
+        sei();
+    }
 
-    // Alle gleichzeitig
-    digitalWrite(Pins::LED_GREEN, HIGH);
-    digitalWrite(Pins::LED_YELLOW, HIGH);
-    digitalWrite(Pins::LED_RED, HIGH);
-    delay(300);
-    digitalWrite(Pins::LED_GREEN, LOW);
-    digitalWrite(Pins::LED_YELLOW, LOW);
-    digitalWrite(Pins::LED_RED, LOW);
+    #if DEBUG_ENABLED
+    DEBUG_PRINT(F("Ch"));
+    DEBUG_PRINT(channel);
+    DEBUG_PRINT(F(" Profil 0x"));
+    DEBUG_PRINTLN(profile, HEX);
+    #endif
 }
 
 /**
- * @brief Lässt gelbe LED kurz aufblinken (Empfangsbestätigung)
+ * @brief Lässt gelbe LED kurz aufblinken (Empfangsbestätigung, nicht-blockierend)
+ *
+ * Die gelbe LED wird deshalb überall über animation.writeLed() gesetzt:
+ * ein Zustandswechsel während des Blinkens gilt danach, statt vom
+ * Blink-Ende überschrieben zu werden.
  */
 void blinkYellowLED() {
-    digitalWrite(Pins::LED_YELLOW, HIGH);
-    delay(Timing::LED_BLINK_DURATION_MS);
-    digitalWrite(Pins::LED_YELLOW, LOW);
+    animation.pulseLed(Pins::LED_YELLOW, Timing::LED_BLINK_DURATION_MS);
 }
 
 /**
@@ -438,12 +887,11 @@ void updateAlarm() {
         if (alarmLedState) {
             // LEDs ausschalten
             digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, LOW);
+            animation.writeLed(Pins::LED_YELLOW, LOW);
             digitalWrite(Pins::LED_RED, LOW);
 
             // LED Strip ausschalten (7-Segment + Gruppen)
-            FastLED.clear();
-            FastLED.show();
+            display.fill(CRGB::Black);
 
             alarmLedState = false;
 
@@ -460,12 +908,11 @@ void updateAlarm() {
         } else {
             // LEDs einschalten
             digitalWrite(Pins::LED_GREEN, HIGH);
-            digitalWrite(Pins::LED_YELLOW, HIGH);
+            animation.writeLed(Pins::LED_YELLOW, HIGH);
             digitalWrite(Pins::LED_RED, HIGH);
 
             // LED Strip einschalten (alle ROT: 7-Segment + Gruppen)
-            fill_solid(leds, LEDStrip::TOTAL_LEDS, CRGB::Red);
-            FastLED.show();
+            display.fill(CRGB::Red);
 
             alarmLedState = true;
         }
@@ -473,162 +920,90 @@ void updateAlarm() {
 }
 
 /**
- * @brief Aktualisiert Timer und LED-Status mit 7-Segment-Anzeige (Interrupt-basiert)
+ * @brief Zeichnet die Anzeige bei Phasen- oder Sekundenwechsel der Passe
  *
- * Diese Funktion wird genau einmal pro Sekunde aufgerufen (durch Timer1-Interrupt).
- * Dadurch ist die Zeitbasis unabhängig von blocking delays (z.B. Buzzer).
+ * Die Fristen liegen absolut ab Empfang des START-Kommandos (PhaseManager),
+ * daher ist jede Grenze auf ca. 1ms genau - unabhängig davon, wie lange
+ * loop() oder ein Strip-Update gerade dauert.
  */
-void updateTimer() {
-    if (!timerRunning) return;
-
-    if (timerRemainingSeconds == 0) {
-        // Timer abgelaufen
-        timerRunning = false;
-
-        // Rote LED an (Stop)
-        digitalWrite(Pins::LED_GREEN, LOW);
-        digitalWrite(Pins::LED_YELLOW, LOW);
-        digitalWrite(Pins::LED_RED, HIGH);
-
-        // Zeige "000" in ROT auf 7-Segment-Anzeige
-        display.displayTimer(0, CRGB::Red, true);
-
-        // Behalte aktuelle Gruppe sichtbar in ROT (falls vorhanden)
-        if (!groupsEnabled) {
-            // Keine Gruppe (1-2 Schützen Modus) - beide aus
-            display.setGroup(0, CRGB::Black);
-            display.setGroup(1, CRGB::Black);
-        } else if (currentGroup == Groups::Type::GROUP_AB) {
-            display.setGroup(0, CRGB::Red);
-        } else {
-            display.setGroup(1, CRGB::Red);
-        }
+void updatePhases() {
+    if (!phases.update(Timebase::now())) return;
 
-        DEBUG_PRINTLN(F("Timer END"));
+    uint16_t seconds = phases.remainingSeconds();
+    if (seconds > LEDStrip::MAX_VALUE) {
+        seconds = LEDStrip::MAX_VALUE;  // 7-Segment-Display Maximum
+    }
 
-        // KEINE 3 Pieptöne hier! Diese werden nur bei CMD_STOP gesendet
-        // (wichtig für 3-4 Schützen: nur am Ende BEIDER Gruppen piepen)
-    } else {
-        // Begrenze auf 999 Sekunden (7-Segment-Display Maximum)
-        uint32_t displaySec = (timerRemainingSeconds > 999) ? 999 : timerRemainingSeconds;
-
-        // Farbe basierend auf verbleibender Zeit
-        CRGB displayColor;
-        static bool yellowPhaseActive = false;
-
-        #if DEBUG_SHORT_TIMES
-            // DEBUG: Gelbe Ampel in den letzten 5 Sekunden
-            uint32_t yellowThreshold = 5;
-        #else
-            // Normal: Gelbe Ampel in den letzten 30 Sekunden
-            uint32_t yellowThreshold = 30;
-        #endif
-
-        if (timerRemainingSeconds <= yellowThreshold) {
-            // Orange-Gelbe Phase
+    switch (phases.phase()) {
+        case PhaseManager::Phase::PREPARATION:
+            // Zeige verbleibende Vorbereitungszeit in ROT
             digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, HIGH);
-            digitalWrite(Pins::LED_RED, LOW);
-            displayColor = CRGB(255, 140, 0);  // Orange (statt reines Gelb)
+            animation.writeLed(Pins::LED_YELLOW, LOW);
+            digitalWrite(Pins::LED_RED, HIGH);
+            display.displayTimer(seconds, CRGB::Red);
+            showCurrentGroup(CRGB::Red);
+            break;
 
-            if (!yellowPhaseActive) {
-                yellowPhaseActive = true;
-                DEBUG_PRINTLN(F("Orange phase"));
+        case PhaseManager::Phase::SHOOTING:
+            if (phases.phaseChanged()) {
+                DEBUG_PRINTLN(F("Prep END"));
+
+                // Akustisches Signal: 1x Piepen (Ampel wird grün)
+                buzzer.beep(1);
             }
-        } else {
+
             // Grüne Phase
             digitalWrite(Pins::LED_GREEN, HIGH);
-            digitalWrite(Pins::LED_YELLOW, LOW);
+            animation.writeLed(Pins::LED_YELLOW, LOW);
             digitalWrite(Pins::LED_RED, LOW);
-            displayColor = CRGB::Green;
-            yellowPhaseActive = false;
-        }
+            display.displayTimer(seconds, CRGB::Green);
+            showCurrentGroup(CRGB::Green);
+            break;
 
-        // Zeige verbleibende Zeit auf 7-Segment-Anzeige
-        display.displayTimer(displaySec, displayColor);
+        case PhaseManager::Phase::WARNING:
+            if (phases.phaseChanged()) {
+                DEBUG_PRINTLN(F("Orange phase"));
+            }
 
-        // Behalte aktuelle Gruppe sichtbar in gleicher Farbe wie die Ziffern (nur bei aktivierten Gruppen)
-        if (!groupsEnabled) {
-            // Keine Gruppe (1-2 Schützen Modus) - beide aus
-            display.setGroup(0, CRGB::Black);
-            display.setGroup(1, CRGB::Black);
-        } else if (currentGroup == Groups::Type::GROUP_AB) {
-            display.setGroup(0, displayColor);
-        } else {
-            display.setGroup(1, displayColor);
-        }
+            // Orange-Gelbe Phase
+            digitalWrite(Pins::LED_GREEN, LOW);
+            animation.writeLed(Pins::LED_YELLOW, HIGH);
+            digitalWrite(Pins::LED_RED, LOW);
+            display.displayTimer(seconds, CRGB(255, 140, 0));  // Orange (statt reines Gelb)
+            showCurrentGroup(CRGB(255, 140, 0));
+            break;
 
-    }
-     
-    // Dekrementiere verbleibende Zeit
-    if (timerRemainingSeconds > 0) {
-        timerRemainingSeconds--;
+        case PhaseManager::Phase::FINISHED:
+            // Rote LED an (Stop), "000" in ROT, Gruppe bleibt in ROT sichtbar
+            digitalWrite(Pins::LED_GREEN, LOW);
+            animation.writeLed(Pins::LED_YELLOW, LOW);
+            digitalWrite(Pins::LED_RED, HIGH);
+            display.displayTimer(0, CRGB::Red, true);
+            showCurrentGroup(CRGB::Red);
+
+            DEBUG_PRINTLN(F("Timer END"));
+
+            // KEINE 3 Pieptöne hier! Diese werden nur bei CMD_STOP gesendet
+            // (wichtig für 3-4 Schützen: nur am Ende BEIDER Gruppen piepen)
+            break;
+
+        default:
+            break;
     }
 }
 
 /**
- * @brief Aktualisiert Vorbereitungsphase mit Countdown und wechselt automatisch in Schießphase (Interrupt-basiert)
- *
- * Diese Funktion wird genau einmal pro Sekunde aufgerufen (durch Timer1-Interrupt).
+ * @brief Zeigt die aktuelle Gruppe in einer Farbe (andere Gruppe aus)
+ * @param color Farbe der Gruppe (bei deaktivierten Gruppen: beide aus)
  */
-void updatePreparation() {
-    if (!inPreparationPhase) return;
-
-    if (preparationRemainingSeconds == 0) {
-        // Beende Vorbereitungsphase
-        inPreparationPhase = false;
-
-        DEBUG_PRINTLN(F("Prep END"));
-
-        // 1 Signalton: Schießphase beginnt
-        buzzer.beep(1);
-
-        // Starte Timer
-        timerRunning = true;
-        timerRemainingSeconds = timerDurationMs / 1000;  // Konvertiere zu Sekunden
-
-        // Grüne LED an, Rest aus
-        digitalWrite(Pins::LED_GREEN, HIGH);
-        digitalWrite(Pins::LED_YELLOW, LOW);
-        digitalWrite(Pins::LED_RED, LOW);
-
-        // Zeige Start-Zeit in GRÜN
-        uint32_t startTimeSec = (timerRemainingSeconds > 999) ? 999 : timerRemainingSeconds;
-        display.displayTimer(startTimeSec, CRGB::Green);
-
-        // Behalte aktuelle Gruppe sichtbar in GRÜN (nur bei aktivierten Gruppen)
-        if (!groupsEnabled) {
-            // Keine Gruppe (1-2 Schützen Modus) - beide aus
-            display.setGroup(0, CRGB::Black);
-            display.setGroup(1, CRGB::Black);
-        } else if (currentGroup == Groups::Type::GROUP_AB) {
-            display.setGroup(0, CRGB::Green);
-        } else {
-            display.setGroup(1, CRGB::Green);
-        }
-
-        // Akustisches Signal: 1x Piepen (Ampel wird grün)
-        buzzer.beep(1);
+void showCurrentGroup(CRGB color) {
+    if (!groupsEnabled) {
+        // Keine Gruppe (1-2 Schützen Modus) - beide aus
+        display.clearGroups();
+    } else if (currentGroup == Groups::Type::GROUP_AB) {
+        display.setGroup(0, color);
     } else {
-        // Zeige verbleibende Vorbereitungszeit in ROT
-        display.displayTimer(preparationRemainingSeconds, CRGB::Red);
-
-        // Behalte aktuelle Gruppe sichtbar in ROT (nur bei aktivierten Gruppen)
-        if (!groupsEnabled) {
-            // Keine Gruppe (1-2 Schützen Modus) - beide aus
-            display.setGroup(0, CRGB::Black);
-            display.setGroup(1, CRGB::Black);
-        } else if (currentGroup == Groups::Type::GROUP_AB) {
-            display.setGroup(0, CRGB::Red);
-        } else {
-            display.setGroup(1, CRGB::Red);
-        }
-
-    }
-
-    // Dekrementiere verbleibende Zeit
-    if (preparationRemainingSeconds > 0) {
-        preparationRemainingSeconds--;
+        display.setGroup(1, color);
     }
 }
 
@@ -637,82 +1012,106 @@ void updatePreparation() {
  * @param color Farbe (CRGB::Red, CRGB::Yellow, CRGB::Green)
  */
 void setTrafficLightColor(CRGB color) {
-    fill_solid(leds, LEDStrip::TOTAL_LEDS, color);
-    FastLED.show();
+    display.fill(color);
 }
 
 /**
- * @brief Zeigt einen Regenbogen-Effekt beim Systemstart
- *
- * Aktiviert jedes Segment nacheinander in Regenbogenfarben:
- * 1. Gruppe A/B (16 LEDs)
- * 2. Gruppe C/D (16 LEDs)
- * 3. Alle 21 Segmente der 7-Segment-Displays (3 Ziffern × 7 Segmente)
+ * @brief Zeigt den Grundzustand nach CMD_INIT ("000" und aktuelle Gruppe in Rot)
  *
- * Gesamt: 23 Segmente in Regenbogenfarben
- * Dauer: ca. 5 Sekunden
+ * Wird am Ende (oder beim Abbruch) der INIT-Blink-Animation aufgerufen.
  */
-void showRainbowEffect() {
-    DEBUG_PRINTLN(F("Regenbogen-Effekt..."));
-
-    // Alle LEDs ausschalten
-    FastLED.clear();
-    FastLED.show();
-
-    // Anzahl der "Segmente": 2 Gruppen + 21 7-Segment-Balken = 23
-    const uint8_t totalSegments = 2 + (LEDStrip::NUM_DIGITS * LEDStrip::SEGMENTS_PER_DIGIT);
-    uint8_t segmentIndex = 0;
-
-    // 1. Gruppe A/B (Segment 0)
-    uint8_t hue = (segmentIndex * 256) / totalSegments;
-    fill_solid(leds + LEDStrip::GROUP_AB_START, LEDStrip::GROUP_AB_LEDS, CHSV(hue, 255, 255));
-    FastLED.show();
-    delay(200);
-    segmentIndex++;
-
-    // 2. Gruppe C/D (Segment 1)
-    hue = (segmentIndex * 256) / totalSegments;
-    fill_solid(leds + LEDStrip::GROUP_CD_START, LEDStrip::GROUP_CD_LEDS, CHSV(hue, 255, 255));
-    FastLED.show();
-    delay(200);
-    segmentIndex++;
-
-    // 3. Alle 7-Segment-Display-Segmente (3 Ziffern × 7 Segmente = 21 Segmente)
-    // Reihenfolge: 1er-Stelle (B,A,F,G,C,D,E), 10er-Stelle (B,A,F,G,C,D,E), 100er-Stelle (B,A,F,G,C,D,E)
-    for (uint8_t digit = 0; digit < LEDStrip::NUM_DIGITS; digit++) {
-        // Start-Index für diese Ziffer
-        uint8_t digitStart = LEDStrip::DIGIT_START + (digit * LEDStrip::LEDS_PER_DIGIT);
-
-        // Gehe durch alle 7 Segmente dieser Ziffer
-        for (uint8_t seg = 0; seg < LEDStrip::SEGMENTS_PER_DIGIT; seg++) {
-            // Berechne Regenbogenfarbe für dieses Segment
-            hue = (segmentIndex * 256) / totalSegments;
-
-            // Setze alle 6 LEDs dieses Segments auf die Regenbogenfarbe
-            uint8_t segmentStart = digitStart + (seg * LEDStrip::LEDS_PER_SEGMENT);
-            fill_solid(leds + segmentStart, LEDStrip::LEDS_PER_SEGMENT, CHSV(hue, 255, 255));
-
-            // Zeige das Update an
-            FastLED.show();
-            delay(200);
-
-            segmentIndex++;
-        }
+void showInitDisplay() {
+    display.displayTimer(0, CRGB::Red, true);
+    showCurrentGroup(CRGB::Red);
+}
+
+/**
+ * @brief Zeigt den Ruhezustand zwischen den Passen (Rot, "000", aktuelle Gruppe in Rot)
+ */
+void showIdleDisplay() {
+    // Rote LED an (Stop)
+    digitalWrite(Pins::LED_GREEN, LOW);
+    animation.writeLed(Pins::LED_YELLOW, LOW);
+    digitalWrite(Pins::LED_RED, HIGH);
+
+    // Zeige "000" in ROT
+    display.displayTimer(0, CRGB::Red, true);
+    showCurrentGroup(CRGB::Red);
+}
+
+/**
+ * @brief Übernimmt Gruppe und Position aus dem Zustand des Senders
+ * @param state Zustand aus dem Paket
+ * @return true wenn sich die angezeigte Gruppe geändert hat
+ */
+bool applyGroups(const PassState& state) {
+    bool enabled = (state.group != PASS_GROUP_NONE);
+    Groups::Type group = (state.group == PASS_GROUP_CD) ? Groups::Type::GROUP_CD : Groups::Type::GROUP_AB;
+    Groups::Position position = (state.position == 2) ? Groups::Position::POS_2 : Groups::Position::POS_1;
+
+    if (enabled == groupsEnabled && (!enabled || (group == currentGroup && position == currentPosition))) {
+        return false;
+    }
+
+    groupsEnabled = enabled;
+    if (enabled) {
+        currentGroup = group;
+        currentPosition = position;
     }
+    return true;
+}
+
+/**
+ * @brief Startet den Ablauf einer Passe mit den Zeiten aus dem Zustand des Senders
+ * @param startTicks Startzeitpunkt (Timebase-Ticks)
+ * @param state Zustand aus dem Paket (Vorbereitungs- und Schießzeit)
+ */
+void startPasse(uint32_t startTicks, const PassState& state) {
+    #if DEBUG_SHORT_TIMES
+        // DEBUG: Orange in den letzten 5s
+        phases.start(startTicks, state.prepSeconds, state.shootSeconds, 5);
+    #else
+        // Normal: Orange in den letzten 30s
+        phases.start(startTicks, state.prepSeconds, state.shootSeconds, 30);
+    #endif
+}
+
+/**
+ * @brief Startet den nicht-blockierenden Alarm (8x blinken mit 250ms)
+ */
+void startAlarm() {
+    // Timer und Phasen sofort stoppen
+    phases.cancel();
 
-    // Kurze Pause am Ende mit allen Segmenten leuchtend
-    delay(800);
+    alarmActive = true;
+    alarmBlinkCount = 0;
+    alarmLedState = false;
+    alarmLastToggle = millis();
 
-    // Alle LEDs ausschalten
-    FastLED.clear();
-    FastLED.show();
+    // Erste LEDs sofort einschalten - auch den Strip, noch im selben loop()-Durchlauf
+    // (nicht erst mit dem zweiten Blink-Takt nach 500ms)
+    digitalWrite(Pins::LED_GREEN, HIGH);
+    animation.writeLed(Pins::LED_YELLOW, HIGH);
+    digitalWrite(Pins::LED_RED, HIGH);
+    display.fill(CRGB::Red);
+    alarmLedState = true;
+
+    // Akustisches Signal: 8x Piepen (Alarm)
+    buzzer.beep(8);
 }
 
 /**
  * @brief Verarbeitet empfangenes Kommando
  * @param cmd RadioCommand
+ * @param state Neuester Zustand des Senders (aus demselben Burst)
  */
-void handleCommand(RadioCommand cmd) {
+void handleCommand(RadioCommand cmd, const PassState& state) {
+    // Neues Kommando unterbricht eine laufende Animation (Endzustand wird gesetzt).
+    // PING ist nur ein Verbindungstest und zeigt nichts an.
+    if (cmd != CMD_PING) {
+        animation.stop();
+    }
+
     switch (cmd) {
         case CMD_PING:
             // Sender testet Verbindungsqualität
@@ -723,28 +1122,17 @@ void handleCommand(RadioCommand cmd) {
         case CMD_INIT:
             DEBUG_PRINTLN(F("INIT"));
 
-            // Alle Segmente 3x blau blinken lassen
-            for (int i = 0; i < 3; i++) {
-                // Alle LEDs rot
-                fill_solid(leds, LEDStrip::TOTAL_LEDS, CRGB::Blue);
-                FastLED.show();
-                delay(200);
-
-                // Alle LEDs aus
-                FastLED.clear();
-                FastLED.show();
-                delay(200);
-            }
+            // Gruppe laut Sender (nach Neustart der Konfiguration nicht zwingend A/B)
+            applyGroups(state);
+            phases.cancel();
 
-            // Zeige "000" und Gruppe A/B
-            display.displayTimer(0, CRGB::Red, true);
-            display.setGroup(0, CRGB::Red);                // Gruppe A/B in rot
-            currentGroup = Groups::Type::GROUP_AB;         // Setze aktuelle Gruppe auf A/B
-            currentPosition = Groups::Position::POS_1;     // Position 1 (ganze Passe)
+            // Alle Segmente 3x blau blinken lassen, danach "000" und Gruppe
+            // (nicht-blockierend, siehe showInitDisplay())
+            animation.play(Animation::INIT_BLINK, showInitDisplay);
 
             // Status-LEDs: Rote LED an (Stop/Pfeile Holen)
             digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, LOW);
+            animation.writeLed(Pins::LED_YELLOW, LOW);
             digitalWrite(Pins::LED_RED, HIGH);
             break;
 
@@ -752,56 +1140,16 @@ void handleCommand(RadioCommand cmd) {
         case CMD_START_240:
             DEBUG_PRINTLN(F("START"));
 
-            // Automatischer Gruppenwechsel bei ganzer Passe (POS_1)
-            if (groupsEnabled && currentPosition == Groups::Position::POS_1) {
-                if (!firstGroupInPass) {
-                    // Dies ist die zweite Gruppe in der Passe → wechsle zur anderen Gruppe
-                    if (currentGroup == Groups::Type::GROUP_AB) {
-                        currentGroup = Groups::Type::GROUP_CD;
-                        DEBUG_PRINTLN(F("Auto: AB -> CD"));
-                    } else {
-                        currentGroup = Groups::Type::GROUP_AB;
-                        DEBUG_PRINTLN(F("Auto: CD -> AB"));
-                    }
-                }
-                // Toggle für nächsten START
-                firstGroupInPass = !firstGroupInPass;
-            }
+            // Gruppe und Zeiten kommen vollständig vom Sender
+            // (auch die zweite Gruppe einer ganzen Passe)
+            applyGroups(state);
 
-            // Timer stoppen (falls noch von vorheriger Gruppe aktiv)
-            timerRunning = false;
-
-            // Starte Vorbereitungsphase (10s oder 5s im DEBUG)
-            inPreparationPhase = true;
-            #if DEBUG_SHORT_TIMES
-                preparationDurationMs = 5000UL;  // 5 Sekunden (DEBUG)
-                preparationRemainingSeconds = 5;  // 5 Sekunden
-            #else
-                preparationDurationMs = 10000UL; // 10 Sekunden
-                preparationRemainingSeconds = 10;  // 10 Sekunden
-            #endif
-
-            // Timer-Dauer setzen (wird nach Vorbereitungsphase gestartet)
-            #if DEBUG_SHORT_TIMES
-                timerDurationMs = 15000UL;  // 15 Sekunden für beide Modi
-            #else
-                timerDurationMs = (cmd == CMD_START_120) ? 120000UL : 240000UL;
-            #endif
-
-            // Rote LED bleibt an (Vorbereitungsphase)
-            digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, LOW);
-            digitalWrite(Pins::LED_RED, HIGH);
+            // Passe starten: alle Fristen ab Empfang des Kommandos
+            // (ersetzt einen noch laufenden Ablauf der vorherigen Gruppe)
+            startPasse(commandTicks, state);
 
             // Zeige initiale Vorbereitungszeit in ROT (z.B. "10" oder "5")
-            display.displayTimer(preparationRemainingSeconds, CRGB::Red);
-
-            // Behalte aktuelle Gruppe sichtbar
-            if (currentGroup == Groups::Type::GROUP_AB) {
-                display.setGroup(0, CRGB::Red);
-            } else {
-                display.setGroup(1, CRGB::Red);
-            }
+            updatePhases();
 
             // Akustisches Signal: 2x Piepen (Vorbereitungsphase startet)
             buzzer.beep(2);
@@ -810,8 +1158,9 @@ void handleCommand(RadioCommand cmd) {
         case CMD_STOP:
             DEBUG_PRINTLN(F("STOP"));
 
-            preparationRemainingSeconds = 0;
-            preparationDurationMs = 0;
+            // Laufende Passe sofort beenden (Rot, "000")
+            phases.finish();
+            updatePhases();
 
             // Akustisches Signal: 3x Piepen (Schießphase beendet)
             // (Alarm wird NICHT vorzeitig beendet - läuft bis zum Ende)
@@ -819,143 +1168,106 @@ void handleCommand(RadioCommand cmd) {
             break;
 
         case CMD_GROUP_AB:
-            DEBUG_PRINTLN(F("GRP_AB"));
-            currentGroup = Groups::Type::GROUP_AB;      // Gruppe A/B
-            currentPosition = Groups::Position::POS_1;  // Position 1 (ganze Passe)
-            groupsEnabled = true;
-            firstGroupInPass = true;  // Neue Passe beginnt mit erster Gruppe
-
-            // Timer und Vorbereitung stoppen
-            timerRunning = false;
-            inPreparationPhase = false;
-
-            // Rote LED an (Stop)
-            digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, LOW);
-            digitalWrite(Pins::LED_RED, HIGH);
-
-            // Zeige "000" in ROT
-            display.displayTimer(0, CRGB::Red, true);
-
-            // Gruppe A/B LEDs auf ROT setzen (C/D wird automatisch ausgeschaltet)
-            display.setGroup(0, CRGB::Red);
-            break;
-
         case CMD_GROUP_CD:
-            DEBUG_PRINTLN(F("GRP_CD"));
-            currentGroup = Groups::Type::GROUP_CD;      // Gruppe C/D
-            currentPosition = Groups::Position::POS_1;  // Position 1 (ganze Passe)
-            groupsEnabled = true;
-            firstGroupInPass = true;  // Neue Passe beginnt mit erster Gruppe
-
-            // Timer und Vorbereitung stoppen
-            timerRunning = false;
-            inPreparationPhase = false;
-
-            // Rote LED an (Stop)
-            digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, LOW);
-            digitalWrite(Pins::LED_RED, HIGH);
-
-            // Zeige "000" in ROT
-            display.displayTimer(0, CRGB::Red, true);
-
-            // Gruppe C/D LEDs auf ROT setzen (A/B wird automatisch ausgeschaltet)
-            display.setGroup(1, CRGB::Red);
-            break;
-
         case CMD_GROUP_NONE:
-            DEBUG_PRINTLN(F("GRP_NONE"));
-            groupsEnabled = false;  // Keine Gruppen (1-2 Schützen Modus)
-
-            // Timer und Vorbereitung stoppen
-            timerRunning = false;
-            inPreparationPhase = false;
-
-            // Rote LED an (Stop)
-            digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, LOW);
-            digitalWrite(Pins::LED_RED, HIGH);
-
-            // Zeige "000" in ROT
-            display.displayTimer(0, CRGB::Red, true);
-
-            // BEIDE Gruppen ausschalten (1-2 Schützen Modus)
-            display.setGroup(0, CRGB::Black);
-            display.setGroup(1, CRGB::Black);
-            break;
-
         case CMD_GROUP_FINISH_AB:
-            DEBUG_PRINTLN(F("GRP_FINISH_AB"));
-            currentGroup = Groups::Type::GROUP_AB;      // Gruppe A/B
-            currentPosition = Groups::Position::POS_2;  // Position 2 (zweite Hälfte der Passe)
-            groupsEnabled = true;
-
-            // Timer und Vorbereitung stoppen
-            timerRunning = false;
-            inPreparationPhase = false;
-
-            // Rote LED an (Stop)
-            digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, LOW);
-            digitalWrite(Pins::LED_RED, HIGH);
-
-            // Zeige "000" in ROT
-            display.displayTimer(0, CRGB::Red, true);
-
-            // Gruppe A/B LEDs auf ROT setzen
-            display.setGroup(0, CRGB::Red);
-            break;
-
         case CMD_GROUP_FINISH_CD:
-            DEBUG_PRINTLN(F("GRP_FINISH_CD"));
-            currentGroup = Groups::Type::GROUP_CD;      // Gruppe C/D
-            currentPosition = Groups::Position::POS_2;  // Position 2 (zweite Hälfte der Passe)
-            groupsEnabled = true;
-
-            // Timer und Vorbereitung stoppen
-            timerRunning = false;
-            inPreparationPhase = false;
-
-            // Rote LED an (Stop)
-            digitalWrite(Pins::LED_GREEN, LOW);
-            digitalWrite(Pins::LED_YELLOW, LOW);
-            digitalWrite(Pins::LED_RED, HIGH);
-
-            // Zeige "000" in ROT
-            display.displayTimer(0, CRGB::Red, true);
-
-            // Gruppe C/D LEDs auf ROT setzen (A/B wird automatisch ausgeschaltet)
-            display.setGroup(1, CRGB::Red);
+            // Gruppe und Position (ganze/halbe Passe) stehen im Zustand,
+            // das Kommando selbst sagt nur "Gruppenwechsel"
+            DEBUG_PRINTLN(commandToString(cmd));
+            applyGroups(state);
+
+            // Timer und Vorbereitung stoppen, Rot mit "000" und Gruppe
+            phases.cancel();
+            showIdleDisplay();
             break;
 
         case CMD_ALARM:
             DEBUG_PRINTLN(F("ALARM"));
+            startAlarm();
+            break;
 
-            // Timer und Phasen sofort stoppen
-            timerRunning = false;
-            timerRemainingSeconds = 0;
-            inPreparationPhase = false;
-            preparationRemainingSeconds = 0;
+        default:
+            DEBUG_PRINTLN(F("UNK"));
+            break;
+    }
+}
 
-            // Starte nicht-blockierenden Alarm (8x blinken mit 250ms)
-            alarmActive = true;
-            alarmBlinkCount = 0;
-            alarmLedState = false;
-            alarmLastToggle = millis();
+/**
+ * @brief Gleicht den eigenen Ablauf mit dem Zustand des Senders ab
+ * @param state Neuester Zustand des Senders
+ *
+ * Jedes Paket (auch die Beacons) trägt den Soll-Zustand. Ging ein Kommando
+ * verloren (STOP, START, Gruppenwechsel, ALARM) oder wurde der Empfänger
+ * neu gestartet, wird der Zustand hier übernommen - die Passe läuft dann
+ * mit dem Startzeitpunkt weiter, den der Sender meldet (Restzeit im Paket).
+ */
+void reconcileState(const PassState& state) {
+    // Konfiguration am Sender oder laufender Alarm: nichts abgleichen
+    if (state.phase == PHASE_SETUP || alarmActive) return;
+
+    bool groupChanged = applyGroups(state);
+
+    switch (state.phase) {
+        case PHASE_PREPARATION:
+        case PHASE_SHOOTING: {
+            // Startzeitpunkt laut Sender: Empfang minus bereits abgelaufene Zeit der Passe
+            uint32_t phaseMs = (uint32_t)state.prepSeconds * 1000;
+            if (state.phase == PHASE_SHOOTING) {
+                phaseMs += (uint32_t)state.shootSeconds * 1000;
+            }
+            uint32_t elapsedMs = (state.remainingMs < phaseMs) ? phaseMs - state.remainingMs : 0;
+            uint32_t startTicks = commandTicks - Timebase::fromMillis(elapsedMs);
+
+            if (!phases.matches(startTicks, state.prepSeconds, state.shootSeconds,
+                                Timebase::fromMillis(RF::STATE_TOLERANCE_MS))) {
+                DEBUG_PRINTLN(F("Sync: Passe"));
+                bool wasRunning = phases.isRunning();
+                animation.stop();
+                startPasse(startTicks, state);
+                updatePhases();
+
+                // START verpasst: Vorbereitung noch mit Signal ankündigen
+                if (!wasRunning && state.phase == PHASE_PREPARATION) {
+                    buzzer.beep(2);
+                }
+                return;
+            }
+            break;
+        }
 
-            // Erste LEDs sofort einschalten
-            digitalWrite(Pins::LED_GREEN, HIGH);
-            digitalWrite(Pins::LED_YELLOW, HIGH);
-            digitalWrite(Pins::LED_RED, HIGH);
-            alarmLedState = true;
+        case PHASE_IDLE:
+            if (phases.isRunning()) {
+                // STOP verpasst
+                DEBUG_PRINTLN(F("Sync: STOP"));
+                phases.finish();
+                updatePhases();
+                buzzer.beep(3);
+            }
+            break;
 
-            // Akustisches Signal: 8x Piepen (Alarm)
-            buzzer.beep(8);
+        case PHASE_ALARM:
+            if (phases.isRunning()) {
+                // ALARM verpasst (nach dem Alarm bleibt der Empfänger in Ruhe)
+                DEBUG_PRINTLN(F("Sync: ALARM"));
+                startAlarm();
+                return;
+            }
             break;
 
         default:
-            DEBUG_PRINTLN(F("UNK"));
             break;
     }
+
+    // Gruppenwechsel verpasst: Anzeige mit der neuen Gruppe neu zeichnen
+    if (groupChanged) {
+        DEBUG_PRINTLN(F("Sync: Gruppe"));
+        animation.stop();
+        if (phases.phase() == PhaseManager::Phase::IDLE) {
+            showIdleDisplay();
+        } else {
+            phases.refresh();
+            updatePhases();
+        }
+    }
 }
@@ -0,0 +1,245 @@
+/**
+ * @file LedLayout.h
+ * @brief Compile-Zeit-Beschreibung der LED-Strip-Geometrie
+ *
+ * Aus wenigen Parametern (Anzahl Ziffern, LEDs pro Segment, Segment-
+ * Reihenfolge, Gruppen-Blöcke, Anordnung der Ziffern) werden zur
+ * Compile-Zeit alle Konstanten und PROGMEM-Tabellen für den
+ * DisplayManager erzeugt und per static_assert geprüft.
+ *
+ * Strip-Aufbau: [Gruppe A/B] [Gruppe C/D] [Ziffer] [Ziffer] ...
+ * Jede Ziffer besteht aus 7 Segmenten in der angegebenen Reihenfolge.
+ *
+ * Usage:
+ * @code
+ * typedef LedLayout::StripLayout<3, 6, 16, 16, LedLayout::DigitOrder::ONES_FIRST,
+ *     LedLayout::SEG_B, LedLayout::SEG_A, LedLayout::SEG_F, LedLayout::SEG_G,
+ *     LedLayout::SEG_C, LedLayout::SEG_D, LedLayout::SEG_E> Layout;
+ *
+ * uint8_t mask = Layout::digitMask(7);       // Bit i = i-tes Segment im Strip
+ * uint8_t first = Layout::digitElement(0);   // Erstes Element der 1er-Stelle
+ * @endcode
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+namespace LedLayout {
+
+//=============================================================================
+// Segmente und Ziffernmuster
+//=============================================================================
+
+/**
+ * @brief Segmente einer 7-Segment-Ziffer (Standardbezeichnung)
+ *
+ * @code
+ *    AAA
+ *   F   B
+ *    GGG
+ *   E   C
+ *    DDD
+ * @endcode
+ */
+enum Segment : uint8_t {
+    SEG_A = 0,
+    SEG_B = 1,
+    SEG_C = 2,
+    SEG_D = 3,
+    SEG_E = 4,
+    SEG_F = 5,
+    SEG_G = 6
+};
+
+/**
+ * @brief Anordnung der Ziffern im Strip
+ */
+enum class DigitOrder : uint8_t {
+    ONES_FIRST,  // Erste Ziffer im Strip ist die 1er-Stelle
+    ONES_LAST    // Erste Ziffer im Strip ist die höchste Stelle
+};
+
+// Ziffern 0-9 in Standard-Bitreihenfolge (Bit n = Segment n, SEG_A = Bit 0)
+constexpr uint8_t GLYPHS[10] = {
+    0b0111111,  // 0: A, B, C, D, E, F
+    0b0000110,  // 1: B, C
+    0b1011011,  // 2: A, B, D, E, G
+    0b1001111,  // 3: A, B, C, D, G
+    0b1100110,  // 4: B, C, F, G
+    0b1101101,  // 5: A, C, D, F, G
+    0b1111101,  // 6: A, C, D, E, F, G
+    0b0000111,  // 7: A, B, C
+    0b1111111,  // 8: alle
+    0b1101111   // 9: A, B, C, D, F, G
+};
+
+//=============================================================================
+// Compile-Zeit-Hilfsfunktionen (C++11: nur ein return pro constexpr-Funktion)
+//=============================================================================
+
+// Ziffernmuster in Strip-Reihenfolge umsortieren: Bit i = Segment order[i]
+constexpr uint8_t mapGlyph(uint8_t) {
+    return 0;
+}
+template <typename... Rest>
+constexpr uint8_t mapGlyph(uint8_t glyph, uint8_t first, Rest... rest) {
+    return ((glyph >> first) & 0x01) | (mapGlyph(glyph, rest...) << 1);
+}
+
+// Menge der verwendeten Segmente (0x7F = jedes Segment genau einmal bei 7 Einträgen)
+constexpr uint8_t segmentSet() {
+    return 0;
+}
+template <typename... Rest>
+constexpr uint8_t segmentSet(uint8_t first, Rest... rest) {
+    return (first < 7 ? (1 << first) : 0x80) | segmentSet(rest...);
+}
+
+constexpr uint16_t pow10(uint8_t exponent) {
+    return exponent == 0 ? 1 : 10 * pow10(exponent - 1);
+}
+
+// Indexfolge 0..N-1 zum Erzeugen von Tabellen
+template <uint8_t... I> struct Indices {};
+template <uint8_t N, uint8_t... I> struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+template <uint8_t... I> struct MakeIndices<0, I...> { typedef Indices<I...> type; };
+
+//=============================================================================
+// PROGMEM-Tabellen (werden von StripLayout verwendet)
+//=============================================================================
+
+template <class L, class I = typename MakeIndices<10>::type> struct DigitMaskTable;
+template <class L, uint8_t... I> struct DigitMaskTable<L, Indices<I...>> {
+    static const uint8_t TABLE[sizeof...(I)];
+};
+template <class L, uint8_t... I>
+const uint8_t DigitMaskTable<L, Indices<I...>>::TABLE[sizeof...(I)] PROGMEM = { L::mask(I)... };
+
+template <class L, class I = typename MakeIndices<L::NUM_ELEMENTS>::type> struct ElementLengthTable;
+template <class L, uint8_t... I> struct ElementLengthTable<L, Indices<I...>> {
+    static const uint8_t TABLE[sizeof...(I)];
+};
+template <class L, uint8_t... I>
+const uint8_t ElementLengthTable<L, Indices<I...>>::TABLE[sizeof...(I)] PROGMEM = { L::elementLength(I)... };
+
+template <class L, class I = typename MakeIndices<L::NUM_DIGITS>::type> struct DigitElementTable;
+template <class L, uint8_t... I> struct DigitElementTable<L, Indices<I...>> {
+    static const uint8_t TABLE[sizeof...(I)];
+};
+template <class L, uint8_t... I>
+const uint8_t DigitElementTable<L, Indices<I...>>::TABLE[sizeof...(I)] PROGMEM = { L::firstElement(I)... };
+
+template <class L, class I = typename MakeIndices<L::NUM_DIGITS>::type> struct PlaceValueTable;
+template <class L, uint8_t... I> struct PlaceValueTable<L, Indices<I...>> {
+    static const uint16_t TABLE[sizeof...(I)];
+};
+template <class L, uint8_t... I>
+const uint16_t PlaceValueTable<L, Indices<I...>>::TABLE[sizeof...(I)] PROGMEM = { pow10(I)... };
+
+//=============================================================================
+// Geometrie
+//=============================================================================
+
+/**
+ * @brief Geometrie eines Strips aus Gruppen-Blöcken und 7-Segment-Ziffern
+ *
+ * Elemente (siehe DisplayManager) in Strip-Reihenfolge:
+ * 0 = Gruppe A/B, 1 = Gruppe C/D, danach die Segmente aller Ziffern.
+ *
+ * @tparam DIGITS Anzahl Ziffern (1-4)
+ * @tparam LEDS_PER_SEG LEDs pro Segment
+ * @tparam GROUP_AB LEDs im Block Gruppe A/B (Strip-Anfang)
+ * @tparam GROUP_CD LEDs im Block Gruppe C/D (direkt danach)
+ * @tparam PLACEMENT Anordnung der Ziffern (1er-Stelle zuerst oder zuletzt)
+ * @tparam SEGMENT_ORDER Die 7 Segmente in der Reihenfolge, in der sie im Strip liegen
+ */
+template <uint8_t DIGITS, uint8_t LEDS_PER_SEG, uint8_t GROUP_AB, uint8_t GROUP_CD,
+          DigitOrder PLACEMENT, uint8_t... SEGMENT_ORDER>
+struct StripLayout {
+    static constexpr uint8_t NUM_DIGITS = DIGITS;
+    static constexpr uint8_t LEDS_PER_SEGMENT = LEDS_PER_SEG;
+    static constexpr uint8_t SEGMENTS_PER_DIGIT = sizeof...(SEGMENT_ORDER);
+    static constexpr uint16_t LEDS_PER_DIGIT = LEDS_PER_SEG * SEGMENTS_PER_DIGIT;
+
+    static constexpr uint8_t GROUP_AB_LEDS = GROUP_AB;
+    static constexpr uint8_t GROUP_CD_LEDS = GROUP_CD;
+    static constexpr uint16_t GROUP_AB_START = 0;
+    static constexpr uint16_t GROUP_CD_START = GROUP_AB;
+    static constexpr uint16_t DIGIT_START = GROUP_AB + GROUP_CD;
+    static constexpr uint16_t TOTAL_LEDS = DIGIT_START + DIGITS * LEDS_PER_DIGIT;
+
+    static constexpr uint8_t GROUP_AB_ELEMENT = 0;
+    static constexpr uint8_t GROUP_CD_ELEMENT = 1;
+    static constexpr uint8_t NUM_ELEMENTS = 2 + DIGITS * SEGMENTS_PER_DIGIT;
+
+    static constexpr uint16_t MAX_VALUE = pow10(DIGITS) - 1;  // 999 bei 3 Ziffern
+
+    static_assert(DIGITS >= 1 && DIGITS <= 4, "1-4 Ziffern (Werte bis 9999 passen in uint16_t)");
+    static_assert(LEDS_PER_SEG >= 1, "Mindestens eine LED pro Segment");
+    static_assert(GROUP_AB >= 1 && GROUP_CD >= 1, "Gruppen-Blöcke dürfen nicht leer sein");
+    static_assert(SEGMENTS_PER_DIGIT == 7, "Segment-Reihenfolge muss 7 Einträge haben");
+    static_assert(segmentSet(SEGMENT_ORDER...) == 0x7F, "Segment-Reihenfolge muss jedes Segment A-G genau einmal enthalten");
+    static_assert(mapGlyph(GLYPHS[8], SEGMENT_ORDER...) == 0x7F, "Ziffer 8 muss alle Segmente belegen");
+
+    //-------------------------------------------------------------------------
+    // Compile-Zeit-Werte (Basis für die Tabellen)
+    //-------------------------------------------------------------------------
+
+    // Ziffernmuster in Strip-Reihenfolge (Bit i = i-tes Segment der Ziffer im Strip)
+    static constexpr uint8_t mask(uint8_t digit) {
+        return mapGlyph(GLYPHS[digit], SEGMENT_ORDER...);
+    }
+
+    // LEDs pro Element
+    static constexpr uint8_t elementLength(uint8_t element) {
+        return element == GROUP_AB_ELEMENT ? GROUP_AB
+             : element == GROUP_CD_ELEMENT ? GROUP_CD
+             : LEDS_PER_SEG;
+    }
+
+    // Erstes Element der Stelle place (0 = 1er-Stelle)
+    static constexpr uint8_t firstElement(uint8_t place) {
+        return 2 + SEGMENTS_PER_DIGIT * (PLACEMENT == DigitOrder::ONES_FIRST ? place : DIGITS - 1 - place);
+    }
+
+    //-------------------------------------------------------------------------
+    // Laufzeit-Zugriff auf die PROGMEM-Tabellen
+    //-------------------------------------------------------------------------
+
+    /**
+     * @brief Segment-Maske einer Ziffer in Strip-Reihenfolge
+     * @param digit Ziffer (0-9)
+     * @return Bit i = i-tes Segment der Ziffer im Strip leuchtet
+     */
+    static uint8_t digitMask(uint8_t digit) {
+        return pgm_read_byte(&DigitMaskTable<StripLayout>::TABLE[digit]);
+    }
+
+    /**
+     * @brief Erstes Element einer Stelle
+     * @param place Stelle (0 = 1er, 1 = 10er, ...)
+     */
+    static uint8_t digitElement(uint8_t place) {
+        return pgm_read_byte(&DigitElementTable<StripLayout>::TABLE[place]);
+    }
+
+    /**
+     * @brief Stellenwert (1, 10, 100, ...)
+     * @param place Stelle (0 = 1er, 1 = 10er, ...)
+     */
+    static uint16_t placeValue(uint8_t place) {
+        return pgm_read_word(&PlaceValueTable<StripLayout>::TABLE[place]);
+    }
+
+    /**
+     * @brief Kopiert die LED-Anzahl aller Elemente aus dem Flash
+     * @param lengths Ziel (NUM_ELEMENTS Bytes)
+     */
+    static void copyElementLengths(uint8_t* lengths) {
+        memcpy_P(lengths, ElementLengthTable<StripLayout>::TABLE, NUM_ELEMENTS);
+    }
+};
+
+} // namespace LedLayout
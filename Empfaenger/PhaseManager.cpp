@@ -0,0 +1,103 @@
+/**
+ * @file PhaseManager.cpp
+ * @brief Implementierung des Phasen-Ablaufs
+ */
+
+#include "PhaseManager.h"
+
+PhaseManager::PhaseManager()
+    : current(Phase::IDLE)
+    , changed(false)
+    , pending(false)
+    , stopRequested(false)
+    , shown(0)
+    , warning(0)
+    , prepEnd(0)
+    , shootEnd(0)
+    , nextBoundary(0) {
+}
+
+void PhaseManager::start(uint32_t startTicks, uint16_t prepSeconds, uint16_t shootSeconds, uint16_t warningSeconds) {
+    prepEnd = startTicks + Timebase::fromSeconds(prepSeconds);
+    shootEnd = prepEnd + Timebase::fromSeconds(shootSeconds);
+    warning = warningSeconds;
+
+    // Phase wird beim nächsten update() aus der aktuellen Zeit bestimmt
+    current = Phase::IDLE;
+    nextBoundary = startTicks;
+    pending = true;
+    stopRequested = false;
+}
+
+void PhaseManager::finish() {
+    if (!isRunning()) return;
+
+    stopRequested = true;
+    pending = true;
+}
+
+void PhaseManager::cancel() {
+    current = Phase::IDLE;
+    pending = false;
+    stopRequested = false;
+    shown = 0;
+}
+
+void PhaseManager::refresh() {
+    if (current != Phase::IDLE) {
+        pending = true;
+    }
+}
+
+bool PhaseManager::matches(uint32_t startTicks, uint16_t prepSeconds, uint16_t shootSeconds, uint32_t toleranceTicks) const {
+    if ((current == Phase::IDLE && !pending) || stopRequested) return false;
+
+    uint32_t expectedPrepEnd = startTicks + Timebase::fromSeconds(prepSeconds);
+    uint32_t expectedShootEnd = expectedPrepEnd + Timebase::fromSeconds(shootSeconds);
+    int32_t prepError = (int32_t)(expectedPrepEnd - prepEnd);
+    int32_t shootError = (int32_t)(expectedShootEnd - shootEnd);
+    uint32_t prepDiff = (prepError < 0) ? -prepError : prepError;
+    uint32_t shootDiff = (shootError < 0) ? -shootError : shootError;
+
+    return prepDiff <= toleranceTicks && shootDiff <= toleranceTicks;
+}
+
+bool PhaseManager::update(uint32_t now) {
+    if (!pending && !isRunning()) return false;
+    if (!pending && !Timebase::reached(now, nextBoundary)) return false;
+    pending = false;
+
+    // Phase und aufgerundete Restzeit aus dem aktuellen Zeitpunkt bestimmen
+    // (nach einer Verzögerung in loop() wird direkt der richtige Wert gezeigt)
+    Phase next;
+    uint32_t end;
+    if (stopRequested) {
+        next = Phase::FINISHED;
+        end = now;
+    } else if (!Timebase::reached(now, prepEnd)) {
+        next = Phase::PREPARATION;
+        end = prepEnd;
+    } else if (!Timebase::reached(now, shootEnd)) {
+        next = Phase::SHOOTING;
+        end = shootEnd;
+    } else {
+        next = Phase::FINISHED;
+        end = now;
+    }
+
+    uint32_t left = end - now;
+    shown = (left + Timebase::TICKS_PER_SECOND - 1) / Timebase::TICKS_PER_SECOND;
+
+    if (next == Phase::SHOOTING && shown <= warning) {
+        next = Phase::WARNING;
+    }
+
+    // Nächste Grenze: Anzeige springt auf shown - 1 (bzw. Phasenende bei shown == 1)
+    if (next != Phase::FINISHED) {
+        nextBoundary = end - Timebase::fromSeconds(shown - 1);
+    }
+
+    changed = (next != current);
+    current = next;
+    return true;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file PhaseManager.h
+ * @brief Ablauf einer Passe mit absoluten Fristen (Vorbereitung → Grün → Orange → Rot)
+ *
+ * Alle Phasengrenzen werden beim START als absolute Zeitpunkte der
+ * Timebase gespeichert, gerechnet ab dem Empfang des Kommandos. Die
+ * Anzeige wird nur neu gezeichnet, wenn sich Phase oder angezeigte
+ * Sekunde ändern - unabhängig davon, wann loop() gerade läuft.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "Timebase.h"
+
+/**
+ * @brief Zustandsautomat für Vorbereitungs- und Schießphase
+ *
+ * Angezeigt wird die aufgerundete Restzeit der laufenden Phase: bei 120s
+ * Schießzeit steht "120" ab dem Start bis 1s danach, "1" in der letzten
+ * Sekunde, und genau nach 120.000s wird auf Rot ("000") geschaltet.
+ *
+ * Usage:
+ * @code
+ * phases.start(rxTicks, 10, 120, 30);
+ * // in loop():
+ * if (phases.update(Timebase::now())) {
+ *     // phase(), remainingSeconds(), phaseChanged() anzeigen
+ * }
+ * @endcode
+ */
+class PhaseManager {
+public:
+    /**
+     * @brief Phasen einer Passe
+     */
+    enum class Phase : uint8_t {
+        IDLE,         // Kein Ablauf aktiv (Anzeige gehört dem Aufrufer)
+        PREPARATION,  // Vorbereitung (Rot, Countdown)
+        SHOOTING,     // Schießphase (Grün)
+        WARNING,      // Letzte Sekunden der Schießphase (Orange)
+        FINISHED      // Zeit abgelaufen oder STOP (Rot, "000")
+    };
+
+    /**
+     * @brief Konstruktor (Phase IDLE)
+     */
+    PhaseManager();
+
+    /**
+     * @brief Startet eine Passe
+     * @param startTicks Zeitpunkt des START-Kommandos (Timebase-Ticks)
+     * @param prepSeconds Dauer der Vorbereitung
+     * @param shootSeconds Dauer der Schießphase
+     * @param warningSeconds Restzeit, ab der die Schießphase orange ist
+     *
+     * Der erste update() danach meldet die Vorbereitungsphase.
+     */
+    void start(uint32_t startTicks, uint16_t prepSeconds, uint16_t shootSeconds, uint16_t warningSeconds);
+
+    /**
+     * @brief Beendet eine laufende Passe sofort (→ FINISHED beim nächsten update())
+     */
+    void finish();
+
+    /**
+     * @brief Bricht den Ablauf ohne Anzeige ab (→ IDLE)
+     */
+    void cancel();
+
+    /**
+     * @brief Erzwingt ein Neuzeichnen beim nächsten update() (ohne Phasenwechsel)
+     */
+    void refresh();
+
+    /**
+     * @brief Prüft, ob der laufende (oder regulär beendete) Ablauf diesen Fristen entspricht
+     * @param startTicks Startzeitpunkt (Timebase-Ticks)
+     * @param prepSeconds Dauer der Vorbereitung
+     * @param shootSeconds Dauer der Schießphase
+     * @param toleranceTicks Erlaubte Abweichung der Phasengrenzen
+     * @return false bei IDLE, nach finish() oder bei abweichenden Fristen
+     */
+    bool matches(uint32_t startTicks, uint16_t prepSeconds, uint16_t shootSeconds, uint32_t toleranceTicks) const;
+
+    /**
+     * @brief Prüft, ob eine Phasen- oder Sekundengrenze überschritten wurde
+     * @param now Aktueller Zeitpunkt (Timebase::now())
+     * @return true wenn die Anzeige neu gezeichnet werden muss
+     */
+    bool update(uint32_t now);
+
+    /**
+     * @brief Aktuelle Phase
+     */
+    Phase phase() const { return current; }
+
+    /**
+     * @brief Hat der letzte erfolgreiche update() die Phase gewechselt?
+     */
+    bool phaseChanged() const { return changed; }
+
+    /**
+     * @brief Angezeigte Restzeit der laufenden Phase (aufgerundet)
+     * @return Sekunden (0 in IDLE/FINISHED)
+     */
+    uint16_t remainingSeconds() const { return shown; }
+
+    /**
+     * @brief Läuft gerade Vorbereitung oder Schießphase?
+     */
+    bool isRunning() const {
+        return current == Phase::PREPARATION || current == Phase::SHOOTING || current == Phase::WARNING;
+    }
+
+private:
+    Phase current;          // Aktuelle Phase
+    bool changed;           // Phasenwechsel beim letzten update()
+    bool pending;           // Nächster update() muss auswerten (start()/finish())
+    bool stopRequested;     // finish() aufgerufen
+    uint16_t shown;         // Angezeigte Sekunden
+    uint16_t warning;       // Orange ab dieser Restzeit
+    uint32_t prepEnd;       // Ende der Vorbereitung (Ticks)
+    uint32_t shootEnd;      // Ende der Schießphase (Ticks)
+    uint32_t nextBoundary;  // Nächste Sekunden- oder Phasengrenze (Ticks)
+};
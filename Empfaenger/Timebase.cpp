@@ -0,0 +1,89 @@
+/**
+ * @file Timebase.cpp
+ * @brief Implementierung der Timer1-Zeitbasis
+ */
+
+#include "Timebase.h"
+
+namespace {
+    volatile uint16_t overflowCount = 0;  // Obere 16 Bit des Zählers
+    volatile uint16_t maxIrqLate = 0;     // Größte Verspätung des Compare-Interrupts (Ticks)
+
+    constexpr uint16_t IRQ_PROBE_TICKS = 250;  // Messintervall: 250 Ticks = 4ms
+}
+
+/**
+ * @brief Timer1 Überlauf - alle 65536 Ticks (ca. 1.05s)
+ */
+ISR(TIMER1_OVF_vect) {
+    overflowCount++;
+}
+
+/**
+ * @brief Timer1 Compare A - Messung der Interrupt-Sperrzeiten (startIrqProbe())
+ */
+ISR(TIMER1_COMPA_vect) {
+    uint16_t late = TCNT1 - OCR1A;
+    if (late > maxIrqLate) {
+        maxIrqLate = late;
+    }
+
+    // Ab jetzt neu planen (nach langer Sperre liegt OCR1A + Intervall evtl. schon zurück)
+    OCR1A = TCNT1 + IRQ_PROBE_TICKS;
+}
+
+namespace Timebase {
+
+    void begin() {
+        uint8_t oldSREG = SREG;
+        cli();
+
+        // Normal-Modus (kein CTC): zählt 0..65535 und läuft über
+        TCCR1A = 0;
+        TCCR1B = (1 << CS12);  // Prescaler 256 → 16µs pro Tick
+        TCNT1 = 0;
+        overflowCount = 0;
+
+        TIFR1 = (1 << TOV1);     // Altes Überlauf-Flag löschen
+        TIMSK1 = (1 << TOIE1);   // Nur Überlauf-Interrupt
+
+        SREG = oldSREG;
+    }
+
+    uint32_t now() {
+        uint8_t oldSREG = SREG;
+        cli();
+
+        uint16_t low = TCNT1;
+        uint16_t high = overflowCount;
+
+        // Überlauf schon passiert, ISR aber noch nicht gelaufen?
+        if ((TIFR1 & (1 << TOV1)) && low < 0x8000) {
+            high++;
+        }
+
+        SREG = oldSREG;
+        return ((uint32_t)high << 16) | low;
+    }
+
+    void startIrqProbe() {
+        uint8_t oldSREG = SREG;
+        cli();
+
+        maxIrqLate = 0;
+        OCR1A = TCNT1 + IRQ_PROBE_TICKS;
+        TIFR1 = (1 << OCF1A);      // Altes Compare-Flag löschen
+        TIMSK1 |= (1 << OCIE1A);   // Compare-Interrupt zusätzlich zum Überlauf
+
+        SREG = oldSREG;
+    }
+
+    uint16_t maxIrqDelay() {
+        uint8_t oldSREG = SREG;
+        cli();
+        uint16_t result = maxIrqLate;
+        SREG = oldSREG;
+        return result;
+    }
+
+} // namespace Timebase
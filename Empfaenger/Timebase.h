@@ -0,0 +1,99 @@
+/**
+ * @file Timebase.h
+ * @brief Frei laufende Zeitbasis auf Timer1 (16µs Auflösung)
+ *
+ * Timer1 zählt ohne Unterbrechung mit F_CPU/256 = 62.5 kHz. Der Überlauf-
+ * Interrupt (ca. 1x pro Sekunde) erweitert den Zähler auf 32 Bit. Da die
+ * Hardware auch bei gesperrten Interrupts weiterzählt, geht keine Zeit
+ * verloren (anders als bei millis() während eines Strip-Updates).
+ *
+ * Zeitpunkte sind Ticks (uint32_t, Überlauf nach ca. 19h); Vergleiche
+ * immer über die Differenz (Timebase::reached()).
+ *
+ * WICHTIG: Diese Datei MUSS identisch im Sender und Empfänger sein!
+ * (Der Sender rechnet Empfänger-Ticks mit derselben Einheit, siehe ClockSync.h)
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+namespace Timebase {
+
+    constexpr uint32_t TICKS_PER_SECOND = F_CPU / 256;  // 62500 Ticks = 1s bei 16 MHz
+    static_assert(F_CPU % 256 == 0, "Timebase braucht ganzzahlige Ticks pro Sekunde");
+
+    /**
+     * @brief Startet Timer1 als frei laufenden Zähler (Normal-Modus, Prescaler 256)
+     */
+    void begin();
+
+    /**
+     * @brief Aktueller Zeitpunkt
+     * @return Ticks seit begin() (auch aus ISRs aufrufbar)
+     */
+    uint32_t now();
+
+    /**
+     * @brief Startet die Messung der Interrupt-Sperrzeiten (Timer1 Compare A)
+     *
+     * Ein Compare-Interrupt alle 4ms prüft, wie viel später als geplant er
+     * läuft. Die größte Verspätung entspricht der längsten Zeit mit gesperrten
+     * Interrupts (cli(), Strip-Update, andere ISRs) - auf einen Tick genau.
+     */
+    void startIrqProbe();
+
+    /**
+     * @brief Längste gemessene Interrupt-Sperre seit startIrqProbe()
+     * @return Ticks (0 ohne Messung)
+     */
+    uint16_t maxIrqDelay();
+
+    /**
+     * @brief Rechnet Sekunden in Ticks um
+     * @param seconds Sekunden
+     * @return Ticks
+     */
+    constexpr uint32_t fromSeconds(uint32_t seconds) {
+        return seconds * TICKS_PER_SECOND;
+    }
+
+    /**
+     * @brief Rechnet Mikrosekunden in Ticks um (abgerundet)
+     * @param us Mikrosekunden
+     * @return Ticks
+     */
+    constexpr uint32_t fromMicros(uint32_t us) {
+        return us / (1000000UL / TICKS_PER_SECOND);
+    }
+    static_assert(1000000UL % TICKS_PER_SECOND == 0, "fromMicros braucht ganzzahlige Mikrosekunden pro Tick");
+
+    /**
+     * @brief Rechnet Millisekunden in Ticks um (ohne 64-Bit-Rechnung)
+     * @param ms Millisekunden
+     * @return Ticks
+     */
+    constexpr uint32_t fromMillis(uint32_t ms) {
+        return (ms / 1000) * TICKS_PER_SECOND + ((ms % 1000) * TICKS_PER_SECOND) / 1000;
+    }
+
+    /**
+     * @brief Rechnet Ticks in Millisekunden um (abgerundet, ohne 64-Bit-Rechnung)
+     * @param ticks Ticks
+     * @return Millisekunden
+     */
+    constexpr uint32_t toMillis(uint32_t ticks) {
+        return (ticks / TICKS_PER_SECOND) * 1000 + ((ticks % TICKS_PER_SECOND) * 1000) / TICKS_PER_SECOND;
+    }
+
+    /**
+     * @brief Prüft ob ein Zeitpunkt erreicht ist (überlauffest)
+     * @param now Aktueller Zeitpunkt
+     * @param deadline Zeitpunkt
+     * @return true wenn now >= deadline
+     */
+    inline bool reached(uint32_t now, uint32_t deadline) {
+        return (int32_t)(now - deadline) >= 0;
+    }
+
+} // namespace Timebase
@@ -4,10 +4,19 @@
  */
 
 #include "AlarmScreen.h"
+#include "TextMetrics.h"
 
-AlarmScreen::AlarmScreen(Adafruit_ST7789& tft, ButtonManager& btnMgr)
+namespace {
+    // Text-Bereiche (x, y, Breite, Höhe)
+    constexpr ScreenRect ALARM_AREA = { 60, 100, 120, 32 };   // "ALARM" in Größe 4: 5 Zeichen × 24px
+    constexpr ScreenRect LINE1_AREA = { 36, 180, 168, 16 };   // "Schiessbetrieb": 14 Zeichen × 12px
+    constexpr ScreenRect LINE2_AREA = { 54, 210, 132, 16 };   // "abgebrochen": 11 Zeichen × 12px
+}
+
+AlarmScreen::AlarmScreen(Adafruit_ST7789& tft, ButtonManager& btnMgr, RedrawManager& redrawMgr)
     : display(tft)
-    , buttons(btnMgr) {
+    , buttons(btnMgr)
+    , redraw(redrawMgr) {
 }
 
 void AlarmScreen::begin() {
@@ -19,39 +28,33 @@ void AlarmScreen::update() {
 }
 
 void AlarmScreen::draw() {
-    // Schwarzer Hintergrund
-    display.fillScreen(ST77XX_BLACK);
-
-    // Portrait: Mehr vertikaler Platz, zentriert
-    int16_t x1, y1;
-    uint16_t w, h;
+    // Schwarzer Hintergrund: nur die Bereiche des vorherigen Screens löschen
+    redraw.beginScreen();
+    redraw.clear();
 
+    // Portrait: Mehr vertikaler Platz, zentriert (Positionen stehen zur Compile-Zeit fest)
     // Großer "ALARM" Text in Rot (zentriert)
-    display.setTextSize(4);
-    display.setTextColor(ST77XX_RED);
-
-    const char* alarmText = "ALARM";
-    display.getTextBounds(alarmText, 0, 0, &x1, &y1, &w, &h);
-    uint16_t alarmX = (display.width() - w) / 2;
-    uint16_t alarmY = 100;  // Portrait: mehr Platz oben
+    if (redraw.needsPaint(ALARM_AREA)) {
+        display.setTextSize(4);
+        display.setTextColor(ST77XX_RED);
 
-    display.setCursor(alarmX, alarmY);
-    display.print(alarmText);
+        display.setCursor(TextMetrics::centerX("ALARM", 4), ALARM_AREA.y);
+        display.print(F("ALARM"));
+    }
 
     // Erklärungstext (zentriert)
     display.setTextSize(2);
     display.setTextColor(ST77XX_WHITE);
 
-    const char* line1 = "Schiessbetrieb";
-    const char* line2 = "abgebrochen";
+    if (redraw.needsPaint(LINE1_AREA)) {
+        display.setCursor(TextMetrics::centerX("Schiessbetrieb", 2), LINE1_AREA.y);
+        display.print(F("Schiessbetrieb"));
+    }
 
-    display.getTextBounds(line1, 0, 0, &x1, &y1, &w, &h);
-    uint16_t line1X = (display.width() - w) / 2;
-    display.setCursor(line1X, 180);  // Portrait: angepasst
-    display.println(line1);
+    if (redraw.needsPaint(LINE2_AREA)) {
+        display.setCursor(TextMetrics::centerX("abgebrochen", 2), LINE2_AREA.y);
+        display.print(F("abgebrochen"));
+    }
 
-    display.getTextBounds(line2, 0, 0, &x1, &y1, &w, &h);
-    uint16_t line2X = (display.width() - w) / 2;
-    display.setCursor(line2X, 210);  // Portrait: angepasst
-    display.println(line2);
+    redraw.endFrame();
 }
@@ -8,6 +8,7 @@
 #include <Adafruit_ST7789.h>
 #include "Config.h"
 #include "ButtonManager.h"
+#include "RedrawManager.h"
 
 /**
  * @brief Alarm-Screen für Notfall-Abbruch des Schießbetriebs
@@ -21,8 +22,9 @@ public:
      * @brief Konstruktor
      * @param tft Display-Referenz
      * @param btnMgr ButtonManager-Referenz
+     * @param redrawMgr Gemeinsame Invalidierung aller Screens
      */
-    AlarmScreen(Adafruit_ST7789& tft, ButtonManager& btnMgr);
+    AlarmScreen(Adafruit_ST7789& tft, ButtonManager& btnMgr, RedrawManager& redrawMgr);
 
     /**
      * @brief Initialisiert den Screen
@@ -36,10 +38,14 @@ public:
 
     /**
      * @brief Zeichnet den Alarm-Screen
+     *
+     * Löscht nur die Bereiche des vorherigen Screens statt fillScreen() -
+     * der Alarm wird erst nach draw() gesendet.
      */
     void draw();
 
 private:
     Adafruit_ST7789& display;
     ButtonManager& buttons;
+    RedrawManager& redraw;
 };
@@ -4,9 +4,10 @@
  */
 
 #include "ButtonManager.h"
+#include "Timebase.h"
 
 ButtonManager::ButtonManager()
-    : arrowPressStartTime(0), arrowPressActive(false), alarmTriggered(false) {
+    : arrowPressStartTime(0), arrowPressActive(false), alarmTriggered(false), alarmTicks(0) {
     // Alle Button-States initialisieren
     for (uint8_t i = 0; i < static_cast<uint8_t>(Button::COUNT); i++) {
         buttons[i].pressed = false;
@@ -88,6 +89,7 @@ void ButtonManager::update() {
         uint32_t duration = now - arrowPressStartTime;
         if (duration >= Timing::ALARM_THRESHOLD_MS && !alarmTriggered) {
             alarmTriggered = true;  // Alarm-Flag setzen (wird mit isAlarmTriggered() abgerufen)
+            alarmTicks = Timebase::now();
         }
     }
     else if (!arrowPressed && arrowPressActive) {
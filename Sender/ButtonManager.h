@@ -86,6 +86,12 @@ public:
      */
     bool isAlarmTriggered();
 
+    /**
+     * @brief Zeitpunkt der letzten Alarm-Erkennung (für die Latenzmessung)
+     * @return Timebase-Ticks
+     */
+    uint32_t getAlarmTicks() const { return alarmTicks; }
+
 private:
     /**
      * @brief Zustand eines einzelnen Buttons
@@ -105,6 +111,7 @@ private:
     uint32_t arrowPressStartTime;  // Zeitpunkt, wann Pfeiltaste gedrückt wurde
     bool arrowPressActive;         // Pfeiltaste aktuell gedrückt
     bool alarmTriggered;           // Alarm wurde ausgelöst (Flag)
+    uint32_t alarmTicks;           // Zeitpunkt der Alarm-Erkennung (Timebase-Ticks)
 
     /**
      * @brief Gibt den Pin für einen Button zurück
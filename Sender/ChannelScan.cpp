@@ -0,0 +1,65 @@
+/**
+ * @file ChannelScan.cpp
+ * @brief Implementierung des RPD-Scans
+ *
+ * WICHTIG: Diese Datei MUSS identisch im Sender und Empfänger sein!
+ */
+
+#include "ChannelScan.h"
+
+namespace {
+    constexpr uint16_t DWELL_US = 170;  // 130µs RX-Einschwingen + 40µs bis RPD gültig
+}
+
+ChannelScan::ChannelScan(RF24& radio, uint8_t cePin)
+    : radio(radio)
+    , cePin(cePin)
+    , passCount(0) {
+    memset(counts, 0, sizeof(counts));
+}
+
+void ChannelScan::scan(uint8_t passes) {
+    if (passes > MAX_PASSES) passes = MAX_PASSES;
+    memset(counts, 0, sizeof(counts));
+
+    // Empfangsmodus, CE wird pro Kanal direkt geschaltet (startListening() wäre zu langsam)
+    radio.startListening();
+
+    for (uint8_t pass = 0; pass < passes; pass++) {
+        for (uint8_t channel = 0; channel < CHANNELS; channel++) {
+            digitalWrite(cePin, LOW);
+            radio.setChannel(channel);
+            digitalWrite(cePin, HIGH);
+            delayMicroseconds(DWELL_US);
+
+            // RPD gilt nur im Empfangsmodus - vor CE low lesen
+            if (radio.testRPD()) {
+                counts[channel >> 1] += (channel & 1) ? 0x10 : 0x01;
+            }
+        }
+    }
+
+    digitalWrite(cePin, LOW);
+    passCount = passes;
+}
+
+uint8_t ChannelScan::hits(uint8_t channel) const {
+    if (channel >= CHANNELS) return 0;
+    uint8_t pair = counts[channel >> 1];
+    return (channel & 1) ? (pair >> 4) : (pair & 0x0F);
+}
+
+uint8_t ChannelScan::candidateLevel(uint8_t index) const {
+    if (passCount == 0 || index >= CANDIDATES) return LEVEL_MAX;
+
+    uint8_t channel = candidateChannel(index);
+    uint16_t weighted = hits(channel - 1) + 2 * hits(channel) + hits(channel + 1);
+    return (uint8_t)((weighted * LEVEL_MAX + 2 * passCount - 1) / (4 * passCount));
+}
+
+uint8_t ChannelScan::candidateOf(uint8_t channel) {
+    for (uint8_t i = 0; i < CANDIDATES; i++) {
+        if (candidateChannel(i) == channel) return i;
+    }
+    return NO_CANDIDATE;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file ClockSync.cpp
+ * @brief Implementierung des Uhrenabgleichs
+ */
+
+#include "ClockSync.h"
+
+namespace {
+    constexpr uint8_t DRIFT_SHIFT = 24;  // Q24 Festkomma für die Drift
+
+    constexpr int32_t OUTLIER_TICKS = (int32_t)(Sync::OUTLIER_MS * Timebase::TICKS_PER_SECOND / 1000);
+    constexpr int32_t RESYNC_TICKS = (int32_t)(Sync::RESYNC_MS * Timebase::TICKS_PER_SECOND / 1000);
+    constexpr int32_t MAX_DRIFT = (int32_t)(((uint64_t)Sync::MAX_DRIFT_PPM << DRIFT_SHIFT) / 1000000UL);
+
+    // Fehler wird für die Drift-Rechnung auf ±2^15 begrenzt (bleibt in 32 Bit, siehe receivedAck)
+    constexpr int32_t ERROR_LIMIT = 32767;
+}
+
+ClockSync::ClockSync()
+    : txPending(false)
+    , txSeq(0)
+    , txTicks(0)
+    , lastValid(false)
+    , lastSeq(0)
+    , lastRemote(0)
+    , synced(false)
+    , samples(0)
+    , outliers(0)
+    , refLocal(0)
+    , refRemote(0)
+    , drift(0)
+    , driftEstimated(false) {
+}
+
+void ClockSync::reset() {
+    txPending = false;
+    lastValid = false;
+    synced = false;
+    samples = 0;
+    outliers = 0;
+    drift = 0;
+    driftEstimated = false;
+}
+
+void ClockSync::sentPacket(uint8_t seq, uint32_t localTicks) {
+    txPending = true;
+    txSeq = seq;
+    txTicks = localTicks;
+}
+
+bool ClockSync::receivedAck(const AckPayload& ack) {
+    // Empfangszeitpunkt laut Empfänger gilt immer (auch für Multicast-Pakete ohne sentPacket())
+    lastValid = true;
+    lastSeq = ack.seq;
+    lastRemote = ack.rxTicks;
+
+    // Für den Abgleich sind nur Messungen zum zuletzt bestätigten Paket brauchbar (sonst fehlt der Sendezeitpunkt)
+    if (!txPending || ack.seq != txSeq) return false;
+    txPending = false;
+
+    if (!synced) {
+        restart(txTicks, ack.rxTicks);
+        return true;
+    }
+
+    uint32_t predicted = toRemote(txTicks);
+    int32_t error = (int32_t)(ack.rxTicks - predicted);
+    int32_t absError = (error < 0) ? -error : error;
+
+    // Sprung um mehr als RESYNC_MS: Empfänger wurde neu gestartet
+    if (absError > RESYNC_TICKS) {
+        DEBUG_PRINTLN(F("Sync: Neustart"));
+        restart(txTicks, ack.rxTicks);
+        return true;
+    }
+
+    // Ausreißer (z.B. Paket lag im FIFO): erst nach mehreren in Folge neu aufsetzen
+    if (samples >= Sync::SETTLE_SAMPLES && absError > OUTLIER_TICKS) {
+        if (++outliers < Sync::MAX_OUTLIERS) {
+            return true;
+        }
+        restart(txTicks, ack.rxTicks);
+        return true;
+    }
+    outliers = 0;
+
+    int32_t dt = (int32_t)(txTicks - refLocal);
+
+    // Offset: Anteil des Fehlers übernehmen (solange die Drift unbekannt ist: vollständig)
+    refRemote = predicted + (driftEstimated ? error / (1 << Sync::OFFSET_GAIN_SHIFT) : error);
+    refLocal = txTicks;
+
+    // Drift: Fehler pro Zeit, erst ab 1s Abstand aussagekräftig
+    // (error << 15) / (dt >> 9) = error / dt in Q24, ohne 64-Bit-Division
+    if (dt >= (int32_t)Timebase::TICKS_PER_SECOND) {
+        int32_t limited = (error > ERROR_LIMIT) ? ERROR_LIMIT : (error < -ERROR_LIMIT) ? -ERROR_LIMIT : error;
+        int32_t step = (limited * 32768L) / (dt >> 9);
+        drift += driftEstimated ? step / (1 << Sync::DRIFT_GAIN_SHIFT) : step;
+        driftEstimated = true;
+
+        if (drift > MAX_DRIFT) drift = MAX_DRIFT;
+        if (drift < -MAX_DRIFT) drift = -MAX_DRIFT;
+    }
+
+    if (samples < 255) {
+        samples++;
+    }
+
+    #if DEBUG_ENABLED
+    DEBUG_PRINT(F("Sync err/drift: "));
+    DEBUG_PRINT(error);
+    DEBUG_PRINT(F("/"));
+    DEBUG_PRINTLN(driftPpm());
+    #endif
+
+    return true;
+}
+
+uint32_t ClockSync::toRemote(uint32_t localTicks) const {
+    if (!synced) return localTicks;
+
+    int32_t dt = (int32_t)(localTicks - refLocal);
+    int32_t correction = (int32_t)(((int64_t)dt * drift) >> DRIFT_SHIFT);
+    return refRemote + dt + correction;
+}
+
+bool ClockSync::remoteTicksOf(uint8_t seq, uint32_t& remoteTicks) const {
+    if (!lastValid || lastSeq != seq) return false;
+
+    remoteTicks = lastRemote;
+    return true;
+}
+
+int16_t ClockSync::driftPpm() const {
+    // drift * 10^6 / 2^24 = (drift / 16) * 15625 / 2^14
+    return (int16_t)(((drift / 16) * 15625L) / 16384);
+}
+
+//=============================================================================
+// Private Hilfsfunktionen
+//=============================================================================
+
+void ClockSync::restart(uint32_t localTicks, uint32_t remoteTicks) {
+    // Erste Messung legt den Offset fest, Drift wird ab 1s Abstand geschätzt
+    synced = true;
+    samples = 1;
+    outliers = 0;
+    refLocal = localTicks;
+    refRemote = remoteTicks;
+    drift = 0;
+    driftEstimated = false;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ClockSync.h
+ * @brief Abgleich der Sender-Zeitbasis mit der Uhr des Empfängers
+ *
+ * Sender und Empfänger haben eigene Quarze/Resonatoren, die um bis zu
+ * einige 1000 ppm voneinander abweichen. Der Empfänger meldet im
+ * ACK-Payload, zu welchem Zeitpunkt (seine Timebase-Ticks) er das letzte
+ * Paket empfangen hat. Zusammen mit dem Sendezeitpunkt ergibt das eine
+ * Messung von Offset und - über mehrere Messungen - Drift.
+ */
+
+#pragma once
+
+#include "Config.h"
+#include "Commands.h"
+#include "Timebase.h"
+
+/**
+ * @brief Alpha-Beta-Filter für Offset und Drift der Empfänger-Uhr
+ *
+ * Modell: Empfänger-Ticks = Referenz + (lokal - Referenz lokal) * (1 + Drift).
+ * Jede Messung korrigiert den Offset um 1/2^Sync::OFFSET_GAIN_SHIFT und die
+ * Drift um 1/2^Sync::DRIFT_GAIN_SHIFT des Fehlers (Festkomma, kein float).
+ *
+ * Usage:
+ * @code
+ * // nach bestätigtem Paket (TxQueue, TX_SUCCESS):
+ * if (radio.available()) { radio.read(&ack, sizeof(ack)); clockSync.receivedAck(ack); }
+ * clockSync.sentPacket(report.seq, report.rxTicks);
+ *
+ * uint32_t remoteNow = clockSync.toRemote(Timebase::now());
+ * @endcode
+ */
+class ClockSync {
+public:
+    ClockSync();
+
+    /**
+     * @brief Verwirft alle Messungen (z.B. nach Neustart des Funkmoduls)
+     */
+    void reset();
+
+    /**
+     * @brief Merkt sich ein bestätigtes Paket (ACK empfangen)
+     * @param seq Sequenznummer des Pakets
+     * @param localTicks Geschätzter Empfangszeitpunkt beim Empfänger (lokale Ticks, TxReport::rxTicks)
+     */
+    void sentPacket(uint8_t seq, uint32_t localTicks);
+
+    /**
+     * @brief Wertet eine ACK-Payload des Empfängers aus
+     * @param ack Sequenznummer und Empfangszeitpunkt des vorherigen Pakets
+     * @return true wenn die Messung zum zuletzt bestätigten Paket passt
+     */
+    bool receivedAck(const AckPayload& ack);
+
+    /**
+     * @brief Rechnet einen lokalen Zeitpunkt in Empfänger-Ticks um
+     * @param localTicks Lokaler Zeitpunkt (Timebase::now())
+     * @return Geschätzter Zeitpunkt auf der Empfänger-Uhr (ohne Abgleich: unverändert)
+     */
+    uint32_t toRemote(uint32_t localTicks) const;
+
+    /**
+     * @brief Empfangszeitpunkt eines Pakets laut Empfänger (ungefiltert)
+     * @param seq Sequenznummer des Pakets
+     * @param remoteTicks Empfangszeitpunkt in Empfänger-Ticks
+     * @return true wenn für dieses Paket schon eine Messung vorliegt
+     */
+    bool remoteTicksOf(uint8_t seq, uint32_t& remoteTicks) const;
+
+    /**
+     * @brief Liegt mindestens eine Messung vor?
+     */
+    bool isSynced() const { return synced; }
+
+    /**
+     * @brief Geschätzte Drift der Empfänger-Uhr
+     * @return ppm (positiv = Empfänger läuft schneller)
+     */
+    int16_t driftPpm() const;
+
+private:
+    // Zuletzt bestätigtes Paket (wartet auf die Messung im nächsten ACK)
+    bool txPending;
+    uint8_t txSeq;
+    uint32_t txTicks;
+
+    // Letzte Messung (ungefiltert, für den Startzeitpunkt einer Passe)
+    bool lastValid;
+    uint8_t lastSeq;
+    uint32_t lastRemote;
+
+    // Filterzustand
+    bool synced;
+    uint8_t samples;        // Anzahl Messungen (bleibt bei 255 stehen)
+    uint8_t outliers;       // Aufeinanderfolgende verworfene Messungen
+    uint32_t refLocal;      // Lokaler Referenzzeitpunkt
+    uint32_t refRemote;     // Geschätzte Empfänger-Ticks zu refLocal
+    int32_t drift;          // Drift (Q24: 1 << 24 = 100%)
+    bool driftEstimated;    // Drift schon einmal gemessen?
+
+    void restart(uint32_t localTicks, uint32_t remoteTicks);
+};
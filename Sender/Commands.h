@@ -5,12 +5,46 @@
  * Definiert das Protokoll für die Funkübertragung zwischen Sender und Empfänger.
  * WICHTIG: Diese Datei MUSS identisch im Sender und Empfänger sein!
  *
- * Protokoll (2 Bytes):
- * - Byte 0: Kommando-Typ (RadioCommand)
- * - Byte 1: XOR-Checksumme (command ^ 0xFF)
+ * Protokoll v3 (13 Bytes):
+ * - Byte 0: Kommando-Typ (RadioCommand) - das auslösende Ereignis
+ * - Byte 1: Sequenznummer (fortlaufend pro Paket)
+ * - Byte 2-11: Vollständiger Zustand des Senders (PassState)
+ * - Byte 12: CRC-8 über Byte 0-11
+ *
+ * Jedes Paket enthält den kompletten Soll-Zustand (Phase, Gruppe, Position,
+ * Zeiten, Restzeit). Ein einziges empfangenes Paket genügt dem Empfänger,
+ * um die richtige Anzeige herzustellen - ein verlorenes Kommando wird mit
+ * dem nächsten Paket (spätestens dem nächsten Beacon, CMD_SYNC) korrigiert.
+ *
+ * ACK-Payload (Empfänger → Sender, 21 Bytes):
+ * - Sequenznummer und Empfangszeitpunkt (Timebase-Ticks) des zuletzt
+ *   empfangenen Pakets, dazu der Zustand des Empfängers NACH diesem Paket
+ *   und Diagnosezähler (ReceiverStatus). Der Empfänger legt die Payload
+ *   nach jedem Burst bereit, sie kommt also mit dem ACK des NÄCHSTEN
+ *   Pakets beim Sender an - ohne zusätzliche Sendezeit.
+ *
+ * Funkprofil (Datenrate, Sendeleistung des Empfängers):
+ * - Der Sender handelt es mit CMD_RADIO_PROFILE aus (Profil in PassState::param).
+ *   Der Empfänger schaltet erst nach seinem ACK um und kehrt zum vorherigen
+ *   Profil zurück, wenn im neuen nichts ankommt. Nach längerer Funkstille
+ *   gehen beide Seiten auf RADIO_PROFILE_BASE zurück.
+ *
+ * Kanal:
+ * - Beide Seiten starten auf RF::CHANNEL (Treffpunkt) und scannen dort die
+ *   Kanalbelegung (ChannelScan). Der Empfänger meldet seine Messung in der
+ *   ACK-Payload, der Sender wechselt mit CMD_CHANNEL (Kanal in PassState::param)
+ *   auf den freiesten Kanal - Handshake und Rückfall wie beim Funkprofil,
+ *   nach Funkstille zurück auf den Treffpunkt.
+ *
+ * Mehrere Anzeigen:
+ * - Jede Anzeige hat eine ID (RF::DISPLAY_ID) und damit eine eigene Adresse
+ *   (displayAddressByte()). Zeitkritische Kommandos gehen zuerst ohne ACK an
+ *   die Multicast-Adresse, danach fragt der Sender jede Anzeige einzeln mit
+ *   demselben Paket (gleiche Sequenznummer) ab. Der Empfänger führt ein
+ *   Paket mit bereits empfangener Sequenznummer nicht erneut aus.
  *
  * @date 2025-12-21
- * @version 2.1 - Halbe Passe (11 Kommandos)
+ * @version 3.4 - Zustands-Pakete mit CRC-8, Telemetrie in der ACK-Payload, Funkprofile, Kanalwahl, mehrere Anzeigen
  */
 
 #pragma once
@@ -18,7 +52,7 @@
 #include <Arduino.h>
 
 /**
- * @brief Radio-Kommando-Codes (11 Kommandos für Benutzerführung)
+ * @brief Radio-Kommando-Codes (14 Kommandos für Benutzerführung, Zeitabgleich und Funkparameter)
  */
 enum RadioCommand : uint8_t {
     CMD_STOP = 0x01,       // Timer stoppen, rote Ampel
@@ -27,33 +61,191 @@ enum RadioCommand : uint8_t {
     CMD_INIT = 0x04,       // Empfänger initialisieren (Turnier-Start)
     CMD_ALARM = 0x05,      // Not-Alarm auslösen
     CMD_PING = 0x06,       // Connection Quality Test (ACK-basiert)
+    CMD_SYNC = 0x07,       // Beacon: Zustands- und Zeitabgleich (kein Ereignis)
     CMD_GROUP_AB = 0x08,   // Gruppe A/B aktiv - Komplette Passe (+ Stop/Rot)
     CMD_GROUP_CD = 0x09,   // Gruppe C/D aktiv - Komplette Passe (+ Stop/Rot)
     CMD_GROUP_NONE = 0x0A, // Keine Gruppe aktiv (beide aus, 1-2 Schützen Modus)
     CMD_GROUP_FINISH_AB = 0x0B,  // Halbe Passe: Start bei zweiter Gruppe nach A/B
-    CMD_GROUP_FINISH_CD = 0x0C   // Halbe Passe: Start bei zweiter Gruppe nach C/D
+    CMD_GROUP_FINISH_CD = 0x0C,  // Halbe Passe: Start bei zweiter Gruppe nach C/D
+    CMD_RADIO_PROFILE = 0x0D,    // Funkprofil wechseln (Profil in PassState::param)
+    CMD_CHANNEL = 0x0E           // Kanal wechseln (Kanal in PassState::param)
 };
 
 /**
- * @brief Radio-Paket-Struktur (2 Bytes, für nRF24L01+ Übertragung)
+ * @brief Phase der Passe aus Sicht des Senders
  */
+enum PassPhase : uint8_t {
+    PHASE_SETUP = 0,        // Splash/Konfiguration: Empfänger gleicht nichts ab
+    PHASE_IDLE = 1,         // Pfeile holen / Passe beendet (Rot, "000")
+    PHASE_PREPARATION = 2,  // Vorbereitung läuft
+    PHASE_SHOOTING = 3,     // Schießphase läuft
+    PHASE_ALARM = 4         // Alarm ausgelöst
+};
+
+// Gruppen-Code in PassState::group (wie DisplayManager::setGroup)
+constexpr uint8_t PASS_GROUP_AB = 0;      // Gruppe A/B
+constexpr uint8_t PASS_GROUP_CD = 1;      // Gruppe C/D
+constexpr uint8_t PASS_GROUP_NONE = 0xFF; // Keine Gruppen (1-2 Schützen)
+
 #pragma pack(push, 1)
+/**
+ * @brief Vollständiger Soll-Zustand der Anzeige (10 Bytes)
+ */
+struct PassState {
+    uint8_t phase;          // PassPhase
+    uint8_t group;          // PASS_GROUP_AB, PASS_GROUP_CD oder PASS_GROUP_NONE
+    uint8_t position;       // 1 = erste Hälfte der Passe, 2 = zweite Hälfte
+    uint8_t prepSeconds;    // Dauer der Vorbereitung
+    uint8_t shootSeconds;   // Dauer der Schießphase
+    uint8_t param;          // Parameter des Kommandos (CMD_RADIO_PROFILE: Funkprofil, CMD_CHANNEL: Kanal), sonst 0
+    uint32_t remainingMs;   // Restzeit der laufenden Phase (nur PREPARATION/SHOOTING)
+};
+
+/**
+ * @brief Radio-Paket-Struktur (13 Bytes, für nRF24L01+ Übertragung)
+ */
 struct RadioPacket {
     uint8_t command;    // Kommando-Code (RadioCommand)
-    uint8_t checksum;   // XOR-Checksumme (command ^ 0xFF)
+    uint8_t seq;        // Sequenznummer (vom Sender hochgezählt)
+    PassState state;    // Zustand des Senders NACH diesem Kommando
+    uint8_t crc;        // CRC-8 über alle vorherigen Bytes
+};
+
+/**
+ * @brief Zustand und Diagnose des Empfängers (16 Bytes, Teil der ACK-Payload)
+ *
+ * Zähler bleiben bei 65535 stehen, Maxima gelten seit dem Start.
+ */
+struct ReceiverStatus {
+    uint8_t phase;              // PassPhase (FINISHED zählt als PHASE_IDLE)
+    uint8_t group;              // PASS_GROUP_AB, PASS_GROUP_CD oder PASS_GROUP_NONE
+    uint8_t position;           // 1 oder 2
+    uint16_t remainingSeconds;  // Angezeigte Restzeit
+    uint16_t rxPackets;         // Gültige Pakete
+    uint16_t badCrc;            // Verworfen (CRC oder Länge)
+    uint16_t fifoOverflows;     // RX-FIFO beim Auslesen voll
+    uint16_t maxLoopUs;         // Längster loop()-Durchlauf (ohne Schlafen)
+    uint16_t maxIrqOffUs;       // Längste Interrupt-Sperre (16µs Auflösung)
+    uint8_t channelReport;      // Belegung eines Kanal-Kandidaten (ChannelScan::report(), reihum)
+};
+
+/**
+ * @brief ACK-Payload für Zeitabgleich und Telemetrie (21 Bytes, Empfänger → Sender)
+ */
+struct AckPayload {
+    uint8_t seq;        // Sequenznummer des zuletzt empfangenen Pakets
+    uint32_t rxTicks;   // Empfangszeitpunkt dieses Pakets (Timebase-Ticks des Empfängers)
+    ReceiverStatus status;  // Zustand nach der Verarbeitung dieses Pakets
 };
 #pragma pack(pop)
 
-// Compile-Zeit-Prüfung: RadioPacket muss exakt 2 Bytes sein
-static_assert(sizeof(RadioPacket) == 2, "RadioPacket must be exactly 2 bytes");
+// Compile-Zeit-Prüfung: Paketgrößen sind Teil des Protokolls
+static_assert(sizeof(PassState) == 10, "PassState must be exactly 10 bytes");
+static_assert(sizeof(RadioPacket) == 13, "RadioPacket must be exactly 13 bytes");
+static_assert(sizeof(ReceiverStatus) == 16, "ReceiverStatus must be exactly 16 bytes");
+static_assert(sizeof(AckPayload) == 21, "AckPayload must be exactly 21 bytes");
+
+//=============================================================================
+// Funkprofil (CMD_RADIO_PROFILE)
+//=============================================================================
 
 /**
- * @brief Berechnet XOR-Checksumme für Kommando
- * @param command Kommando-Code
- * @return Checksumme (command XOR 0xFF)
+ * @brief Datenrate im Funkprofil
+ */
+enum RadioRate : uint8_t {
+    RADIO_RATE_250K = 0,  // 250 kbps (robust, Startwert)
+    RADIO_RATE_1M = 1,    // 1 Mbps
+    RADIO_RATE_2M = 2     // 2 Mbps (kürzeste Sendezeit)
+};
+
+/**
+ * @brief Setzt ein Funkprofil zusammen
+ * @param rate RadioRate
+ * @param paLevel Sendeleistung des Empfängers (0 = MIN ... 3 = MAX, wie rf24_pa_dbm_e)
+ * @return Profil-Byte (Bit 0-1: Datenrate, Bit 2-3: PA-Level)
+ */
+constexpr uint8_t makeRadioProfile(uint8_t rate, uint8_t paLevel) {
+    return (uint8_t)((rate & 0x03) | ((paLevel & 0x03) << 2));
+}
+
+constexpr uint8_t profileRate(uint8_t profile) { return profile & 0x03; }
+constexpr uint8_t profilePaLevel(uint8_t profile) { return (profile >> 2) & 0x03; }
+
+/**
+ * @brief Prüft ein empfangenes Funkprofil
+ */
+inline bool isValidRadioProfile(uint8_t profile) {
+    return profile < 0x10 && profileRate(profile) <= RADIO_RATE_2M;
+}
+
+// Startprofil beider Seiten (und Rückfall nach Funkstille): 250 kbps, Empfänger PA_HIGH
+constexpr uint8_t RADIO_PROFILE_BASE = makeRadioProfile(RADIO_RATE_250K, 2);
+
+// Handshake (beide Seiten müssen dieselben Zeiten verwenden, gilt auch für CMD_CHANNEL)
+constexpr uint8_t PROFILE_SWITCH_DELAY_MS = 2;    // Empfänger schaltet erst nach seinem ACK um
+constexpr uint16_t PROFILE_CONFIRM_MS = 500;      // Kein Paket im neuen Profil: zurück zum vorherigen
+constexpr uint16_t PROFILE_SILENCE_MS = 3000;     // Nichts empfangen: zurück zu RADIO_PROFILE_BASE
+
+//=============================================================================
+// Kanal (CMD_CHANNEL)
+//=============================================================================
+
+// Höchster erlaubter Kanal: 2483 MHz (das ISM-Band endet bei 2483.5 MHz)
+constexpr uint8_t CHANNEL_MAX_ALLOWED = 83;
+
+/**
+ * @brief Prüft einen empfangenen Kanal
+ */
+inline bool isValidChannel(uint8_t channel) {
+    return channel <= CHANNEL_MAX_ALLOWED;
+}
+
+//=============================================================================
+// Mehrere Anzeigen
+//=============================================================================
+
+// Höchstens so viele Empfänger pro Sender (jeder mit eigener Pipe-Adresse)
+constexpr uint8_t MAX_DISPLAYS = 4;
+
+// Byte 0 (LSB) der Multicast-Adresse - alle Anzeigen hören sie auf Pipe 2, ohne ACK
+constexpr uint8_t MULTICAST_ADDRESS_BYTE = 'B';
+
+/**
+ * @brief Byte 0 (LSB) der Unicast-Adresse einer Anzeige (Pipe 1, mit ACK)
+ * @param display Anzeige-ID 0 bis MAX_DISPLAYS-1
+ *
+ * Die übrigen 4 Bytes kommen aus RF::PIPE_ADDRESS. Anzeige 0 ist die
+ * Hauptanzeige: nur ihre ACK-Payload dient dem Zeitabgleich und der
+ * Zustands-Rückmeldung am Sender.
  */
-inline uint8_t calculateChecksum(uint8_t command) {
-    return command ^ 0xFF;
+constexpr uint8_t displayAddressByte(uint8_t display) {
+    return (uint8_t)('0' + display);
+}
+
+/**
+ * @brief Berechnet CRC-8 (Polynom 0x07, Startwert 0xFF)
+ * @param data Daten
+ * @param length Anzahl Bytes
+ * @return CRC-8
+ */
+inline uint8_t calculateCrc8(const uint8_t* data, uint8_t length) {
+    uint8_t crc = 0xFF;
+    while (length--) {
+        crc ^= *data++;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Berechnet die Prüfsumme eines Pakets (alle Bytes außer crc)
+ * @param packet Zeiger auf RadioPacket
+ * @return CRC-8
+ */
+inline uint8_t calculateChecksum(const RadioPacket* packet) {
+    return calculateCrc8(reinterpret_cast<const uint8_t*>(packet), sizeof(RadioPacket) - 1);
 }
 
 /**
@@ -62,7 +254,21 @@ inline uint8_t calculateChecksum(uint8_t command) {
  * @return true wenn Checksumme korrekt, false sonst
  */
 inline bool validateChecksum(const RadioPacket* packet) {
-    return (packet->checksum == (packet->command ^ 0xFF));
+    return (packet->crc == calculateChecksum(packet));
+}
+
+/**
+ * @brief Prüft ob ein Kommando nur die Gruppen-Auswahl setzt
+ *
+ * Zwei Gruppen-Kommandos direkt hintereinander: das zweite ersetzt das erste
+ * (Sender-Warteschlange und Empfänger-Burst). Alle setzen die Gruppe aus dem
+ * mitgesendeten Zustand, das frühere hat daneben keine eigene Wirkung.
+ * @param command Kommando-Code
+ * @return true bei CMD_GROUP_*
+ */
+inline bool isGroupCommand(uint8_t command) {
+    return command == CMD_GROUP_AB || command == CMD_GROUP_CD || command == CMD_GROUP_NONE ||
+           command == CMD_GROUP_FINISH_AB || command == CMD_GROUP_FINISH_CD;
 }
 
 /**
@@ -78,20 +284,24 @@ inline const __FlashStringHelper* commandToString(RadioCommand cmd) {
         case CMD_INIT:       return F("INIT");
         case CMD_ALARM:      return F("ALARM");
         case CMD_PING:       return F("PING");
+        case CMD_SYNC:       return F("SYNC");
         case CMD_GROUP_AB:   return F("GROUP_AB");
         case CMD_GROUP_CD:   return F("GROUP_CD");
         case CMD_GROUP_NONE: return F("GROUP_NONE");
         case CMD_GROUP_FINISH_AB: return F("GROUP_FINISH_AB");
         case CMD_GROUP_FINISH_CD: return F("GROUP_FINISH_CD");
+        case CMD_RADIO_PROFILE: return F("RADIO_PROFILE");
+        case CMD_CHANNEL:    return F("CHANNEL");
         default:             return F("UNKNOWN");
     }
 }
 
 /**
- * @brief Transmission Result (für sendCommand-Rückgabewert)
+ * @brief Transmission Result (Ergebnis einer Übertragung des Senders)
  */
 enum TransmissionResult {
     TX_SUCCESS,   // ACK empfangen, Kommando zugestellt
     TX_TIMEOUT,   // Kein ACK nach Retries (Empfänger nicht erreichbar)
-    TX_ERROR      // Radio-Hardware-Fehler
+    TX_ERROR,     // Radio-Hardware-Fehler
+    TX_SUPERSEDED // Nicht gesendet: durch ein neueres Paket überholt (Zustand geht mit diesem raus)
 };
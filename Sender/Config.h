@@ -26,7 +26,10 @@
 //=============================================================================
 
 // Debugging aktivieren/deaktivieren
+// (per Compiler-Flag überschreibbar, z.B. -DDEBUG_ENABLED=0 für tools/size.sh)
+#ifndef DEBUG_ENABLED
 #define DEBUG_ENABLED 1  // 1 = Debug-Ausgaben an, 0 = aus
+#endif
 
 // Verkürzte Zeiten für Tests (nur wenn DEBUG_ENABLED = 1)
 #define DEBUG_SHORT_TIMES 0  // 1 = Verkürzte Zeiten, 0 = Normale Zeiten
@@ -122,39 +125,145 @@ namespace RF {
     constexpr uint32_t SPI_FREQUENCY = 10000000UL;  // 10 MHz
 
     // RF-Kanal (0-125, 2.4 GHz + Kanal MHz)
+    // Treffpunkt beim Start und nach Funkstille - danach wechselt der
+    // LinkAdapter auf den freiesten Kanal (ChannelScan, CMD_CHANNEL)
     constexpr uint8_t CHANNEL = 76;  // 2.476 GHz
 
-    // RF-Datenrate (verwende RF24-Library Enums direkt)
+    // Durchläufe des Kanal-Scans beim Start (je ca. 25ms, max. 15)
+    constexpr uint8_t SCAN_PASSES = 8;
+
+    // RF-Datenrate beim Start (verwende RF24-Library Enums direkt)
     // RF24_250KBPS = robuster bei schlechten Verbindungen/langen Kabeln!
+    // Danach passt der LinkAdapter sie an (Handshake mit dem Empfänger, RADIO_PROFILE_BASE)
     constexpr rf24_datarate_e DATA_RATE = RF24_250KBPS;
 
-    // RF-Power Level (verwende RF24-Library Enums direkt)
+    // RF-Power Level beim Start (verwende RF24-Library Enums direkt, danach LinkAdapter)
     // RF24_PA_MAX = 0dBm (höchste Leistung, ~50m Reichweite)
     // WICHTIG: Benötigt externe 3.3V Versorgung (AMS1117) + 100µF Kondensator!
     constexpr rf24_pa_dbm_e POWER_LEVEL = RF24_PA_MAX;
     //RF24_PA_MIN;
 
     // Pipe-Adressen (5 Bytes)
-    // Sender schreibt an Pipe 0, Empfänger liest von Pipe 0
+    // Byte 0 wird pro Anzeige ersetzt (displayAddressByte(), Multicast: 'B' = "B4MPL")
     const uint8_t PIPE_ADDRESS[5] PROGMEM = {'B', '4', 'M', 'P', 'L'};  // "BAMPL" = Bogenampel
 
+    // Mehrere Anzeigen (Empfänger mit RF::DISPLAY_ID 0 bis DISPLAY_COUNT-1)
+    // Zeitkritische Kommandos: erst Multicast ohne ACK an alle, dann jede Anzeige
+    // einzeln abfragen (gleiches Paket) - nur wer noch nicht bestätigt hat, bekommt es erneut.
+    constexpr uint8_t DISPLAY_COUNT = 1;          // 1 = ohne Multicast, wie bisher
+    constexpr uint8_t MULTICAST_COPIES = 2;       // Multicast-Kopien (kein ACK, ein Burst im TX-FIFO)
+    constexpr uint8_t POLL_ROUNDS = 2;            // Abfragerunden für zeitkritische Kommandos
+    constexpr uint8_t DISPLAY_OFFLINE_FAILS = 3;  // Fehlschläge in Folge: Anzeige gilt als offline
+
+    // CMD_ALARM: laufende Übertragung abbrechen, TX-FIFO mit Kopien ohne ACK füllen
+    // (nur bei DISPLAY_COUNT > 1), dann jede Anzeige abfragen - Runde für Runde,
+    // bis ihre ACK-Payload den Alarm bestätigt
+    constexpr uint8_t ALARM_BURST_COPIES = 3;     // Kopien pro Runde (TX-FIFO: 3 Plätze)
+
     // Auto-ACK Einstellungen
     constexpr bool AUTO_ACK_ENABLED = true;  // ACK aktivieren für Verbindungskontrolle
 
-    // Retry-Einstellungen (für ACK-Retransmission)
+    // Retry-Einstellungen beim Start (für ACK-Retransmission, danach LinkAdapter)
+    // Bei 250kbps braucht das ACK mit 21 Byte Payload mindestens 1.25ms
     constexpr uint8_t RETRY_DELAY = 5;    // Delay: (delay + 1) * 250µs = 1.5ms
     constexpr uint8_t RETRY_COUNT = 15;   // Max 15 Retries
 
     // Payload-Größe
-    constexpr uint8_t PAYLOAD_SIZE = 2;   // 2 Bytes (Command + Checksum)
+    constexpr uint8_t PAYLOAD_SIZE = 13;  // 13 Bytes (Command + Sequenz + Zustand + CRC-8)
+
+    // Zustands-Beacon (CMD_SYNC) nach so langer Funkstille, ab Turnierstart.
+    // Jedes Paket trägt den vollständigen Zustand: verlorene Kommandos sind
+    // spätestens nach diesem Intervall beim Empfänger korrigiert.
+    constexpr uint16_t BEACON_INTERVAL_MS = 1000;
 
-    // Connection Quality Test
-    constexpr uint8_t QUALITY_TEST_PINGS = 10;        // Anzahl Pings für Qualitätstest
-    constexpr uint16_t QUALITY_TEST_DURATION_MS = 5000;  // 5 Sekunden für Test
-    constexpr uint16_t QUALITY_TEST_INTERVAL_MS = 500;   // 500ms zwischen Pings (10 in 5s)
+    // Sendewarteschlange (TxQueue, nicht-blockierend)
+    constexpr uint8_t TX_QUEUE_SIZE = 6;  // Wartende Pakete (gesendet wird immer nur eins)
+
+    // Dauer eines Sendeversuchs bis zum Empfang beim Empfänger (Startprofil 250kbps):
+    // 130µs Einschwingen + (1+5+13+2) Bytes + 9 Bit bei 250kbps ≈ 0.85ms
+    // (Schätzung des Empfangszeitpunkts aus Sendestart und Retries, siehe TxReport)
+    constexpr uint16_t TX_AIRTIME_US = 850;
+
+    // Verbindungsqualität (LinkQuality): aus jeder Übertragung geschätzt,
+    // PINGs nur bei Funkstille (in Splash/Konfiguration statt des Beacons)
+    constexpr uint8_t LINK_EWMA_SHIFT = 3;           // Glättung: neue Messung zählt 1/8
+    constexpr uint8_t LINK_SETTLE_SAMPLES = 8;       // Bis dahin schnelle PINGs
+    constexpr uint16_t LINK_FAST_PROBE_MS = 100;     // PING-Abstand bis LINK_SETTLE_SAMPLES
+    constexpr uint8_t LINK_HISTOGRAM_WINDOW = 32;    // Histogramm wird ab so vielen Einträgen halbiert
+    constexpr uint16_t LINK_DISPLAY_MS = 1000;       // Anzeige der Qualität aktualisieren
 
 } // namespace RF
 
+//=============================================================================
+// ZEITABGLEICH MIT DEM EMPFÄNGER (ClockSync)
+//=============================================================================
+
+namespace Sync {
+
+    // Messungen kommen mit jedem Paket (Beacons: RF::BEACON_INTERVAL_MS)
+
+    // Filter-Verstärkung: Offset 1/4, Drift 1/8 des Messfehlers pro Messung
+    constexpr uint8_t OFFSET_GAIN_SHIFT = 2;
+    constexpr uint8_t DRIFT_GAIN_SHIFT = 3;
+
+    // Ausreißer: Messungen mit mehr Fehler werden nach dem Einschwingen verworfen
+    constexpr uint16_t OUTLIER_MS = 20;
+    constexpr uint8_t SETTLE_SAMPLES = 8;   // Messungen bis zum Einschwingen
+    constexpr uint8_t MAX_OUTLIERS = 3;     // Danach Neustart des Filters
+
+    // Sprung größer als das: Empfänger wurde neu gestartet (sofort neu aufsetzen)
+    constexpr uint16_t RESYNC_MS = 1000;
+
+    // Maximale Drift (Keramik-Resonatoren der Nanos: bis ±0.5% je Seite)
+    constexpr uint16_t MAX_DRIFT_PPM = 10000;
+
+} // namespace Sync
+
+//=============================================================================
+// ADAPTIVE FUNKPARAMETER (LinkAdapter)
+//=============================================================================
+
+namespace Adapt {
+
+    // Entscheidung nach so vielen Übertragungen (Beacons: ~1 pro Sekunde)
+    constexpr uint8_t WINDOW = 16;
+
+    // Effizienter werden (höhere Datenrate, weniger Leistung): kein Fehlschlag
+    // und höchstens so viele Retries im ganzen Fenster
+    constexpr uint8_t GOOD_RETRIES = 1;
+
+    // Robuster werden (mehr Leistung, niedrigere Datenrate): ein Fehlschlag
+    // oder mindestens so viele Retries im Fenster (im Mittel 1 pro Paket)
+    constexpr uint8_t BAD_RETRIES = WINDOW;
+
+    // Nach einem Rückschritt keine Effizienz-Schritte für 1, 2, 4, ... Fenster
+    constexpr uint8_t MAX_HOLD_WINDOWS = 64;
+
+    // Fehlschläge in Folge: sofort zurück zum Startprofil (Empfänger folgt
+    // nach PROFILE_SILENCE_MS)
+    constexpr uint8_t FALLBACK_FAILS = 3;
+
+    // Sendepause nach dem Umschalten (Empfänger schaltet PROFILE_SWITCH_DELAY_MS
+    // nach dem Empfang um)
+    constexpr uint16_t SWITCH_GUARD_MS = 5;
+
+    // Kleinste Anzahl Retries (ARC), auch bei sehr guter Verbindung
+    constexpr uint8_t MIN_RETRY_COUNT = 5;
+
+    // Kanal wechseln statt Leistung erhöhen: so viele Retries im Fenster
+    // (im Mittel 2 pro Paket) oder so viele Fehlschläge
+    constexpr uint8_t MIGRATE_RETRIES = 2 * WINDOW;
+    constexpr uint8_t MIGRATE_FAILURES = 2;
+
+    // Nach einem Kanalwechsel frühestens nach so vielen Fenstern wieder wechseln
+    constexpr uint8_t MIGRATE_HOLD_WINDOWS = 16;
+
+    // Abstand der PINGs, bis die Kanal-Messung des Empfängers vollständig ist
+    // (eine Meldung pro ACK-Payload, ChannelScan::CANDIDATES Stück)
+    constexpr uint16_t REPORT_PING_MS = 100;
+
+} // namespace Adapt
+
 //=============================================================================
 // BATTERIE-ÜBERWACHUNG
 //=============================================================================
@@ -205,6 +314,13 @@ namespace Timing {
         constexpr uint16_t PREPARATION_TIME_MS = 10000;  // 10 Sekunden Vorbereitungsphase
     #endif
 
+    // Countdown orange ab dieser Restzeit (wie der Empfänger, siehe startPasse() dort)
+    #if DEBUG_SHORT_TIMES
+        constexpr uint8_t WARNING_TIME_S = 5;    // Letzte 5 Sekunden (DEBUG)
+    #else
+        constexpr uint8_t WARNING_TIME_S = 30;   // Letzte 30 Sekunden
+    #endif
+
     // Alarm Detection
     constexpr uint16_t ALARM_THRESHOLD_MS = 2000;  // 2 Sekunden OK-Button halten für Alarm
 
@@ -217,8 +333,7 @@ namespace Timing {
 
     // RF-Timeout
     constexpr uint16_t RF_TRANSMIT_TIMEOUT_MS = 500;  // Max 500ms für Übertragung (inkl. Retries)
-    constexpr uint16_t ALARM_RETRY_DELAY_MS = 200;   // 200ms zwischen Alarm-Retries
-    constexpr uint8_t ALARM_MAX_RETRIES = 3;         // 3 Versuche für Alarm-Kommando
+    constexpr uint16_t ALARM_CONFIRM_MS = 1000;      // Alarm-Runden höchstens so lange ohne Bestätigung
 
 } // namespace Timing
 
@@ -372,4 +487,8 @@ namespace ConfigValidation {
     // Prüfe RF-Payload-Größe
     static_assert(RF::PAYLOAD_SIZE <= 32, "NRF24L01 max payload is 32 bytes");
 
+    // Prüfe Burst-Größen (TX-FIFO des NRF24L01 hat 3 Plätze)
+    static_assert(RF::MULTICAST_COPIES >= 1 && RF::MULTICAST_COPIES <= 3, "Multicast burst must fit the 3-deep TX FIFO");
+    static_assert(RF::ALARM_BURST_COPIES >= 1 && RF::ALARM_BURST_COPIES <= 3, "Alarm burst must fit the 3-deep TX FIFO");
+
 } // namespace ConfigValidation
@@ -4,10 +4,30 @@
  */
 
 #include "ConfigMenu.h"
+#include "TextMetrics.h"
+
+namespace {
+    // Widget-Bereiche (x, y, Breite, Höhe) - umfassen alles, was das Widget zeichnet
+    constexpr ScreenRect TITLE_AREA   = { 42, 15, 156, 16 };   // "Konfiguration": 13 Zeichen × 12px
+    constexpr ScreenRect RULE_AREA    = { 10, 50, 220, 1 };
+    constexpr ScreenRect TIME_AREA    = { 10, 65, 218, 33 };   // Label, Optionen, "pro Passe"
+    constexpr ScreenRect TIME_MARK    = { 120, 83, 109, 1 };   // Unterstrich unter 120s/240s
+    constexpr ScreenRect SHOOTER_AREA = { 10, 115, 166, 47 };  // Label, "pro Scheibe", Optionen
+    constexpr ScreenRect SHOOTER_MARK = { 60, 163, 117, 1 };   // Unterstrich unter 1-2/3-4
+    constexpr ScreenRect BUTTON_AREA[2] = {
+        { 20, 180, 200, 35 },   // "Aendern"
+        { 20, 225, 200, 35 }    // "Start"
+    };
+    constexpr ScreenRect HELP_AREA    = { 10, 290, 144, 23 };  // 2 Zeilen, max. 24 Zeichen × 6px
+
+    constexpr uint16_t TIME_OPTION_X[2] = { 120, 180 };      // "120s", "240s"
+    constexpr uint16_t SHOOTER_OPTION_X[2] = { 60, 140 };    // "1-2", "3-4"
+}
 
-ConfigMenu::ConfigMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr)
+ConfigMenu::ConfigMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr, RedrawManager& redrawMgr)
     : display(tft)
     , buttons(btnMgr)
+    , redraw(redrawMgr)
     , shootingTime(EEPROM_Config::DEFAULT_TIME)
     , shooterCount(EEPROM_Config::DEFAULT_COUNT)
     , cursorLine(0)
@@ -99,49 +119,59 @@ void ConfigMenu::update() {
 }
 
 void ConfigMenu::draw() {
-    // Beim ersten Aufruf: Komplettes Display zeichnen
     if (firstDraw) {
-        display.fillScreen(ST77XX_BLACK);
-        drawHeader();
-        drawTimeOption();
-        drawShooterOption();
-        drawButtonOption();
-        drawHelp();
-
-        // Werte speichern
-        lastShootingTime = shootingTime;
-        lastShooterCount = shooterCount;
-        lastCursorLine = cursorLine;
-        lastSelectedButton = selectedButton;
+        // Neuer Screen: nur löschen, was der vorherige Screen gezeichnet hat
+        redraw.beginScreen();
         firstDraw = false;
-
     }
     else {
-        // Selective Redraw: Nur geänderte Bereiche neu zeichnen
+        // Selective Redraw: Nur geänderte Widgets invalidieren
 
-        // Zeit-Zeile neu zeichnen wenn Zeit oder Cursor geändert
-        if (shootingTime != lastShootingTime ||
-            (cursorLine == 0) != (lastCursorLine == 0)) {
-            drawTimeOption();
-            lastShootingTime = shootingTime;
+        // Zeit-Zeile: Cursor ändert die Farbe der ganzen Zeile, die Zeit nur den Unterstrich
+        if ((cursorLine == 0) != (lastCursorLine == 0)) {
+            redraw.invalidate(TIME_AREA);
+        }
+        else if (shootingTime != lastShootingTime) {
+            redraw.invalidate(TIME_MARK);
         }
 
-        // Schützen-Zeile neu zeichnen wenn Schützenanzahl oder Cursor geändert
-        if (shooterCount != lastShooterCount ||
-            (cursorLine == 1) != (lastCursorLine == 1)) {
-            drawShooterOption();
-            lastShooterCount = shooterCount;
+        // Schützen-Zeile (Unterstrich liegt unter der Zeile)
+        if ((cursorLine == 1) != (lastCursorLine == 1)) {
+            redraw.invalidate(SHOOTER_AREA);
+            redraw.invalidate(SHOOTER_MARK);
+        }
+        else if (shooterCount != lastShooterCount) {
+            redraw.invalidate(SHOOTER_MARK);
         }
 
-        // Button-Zeile neu zeichnen wenn Auswahl oder Cursor geändert
+        // Buttons: Auswahl oder Cursor geändert
         if (selectedButton != lastSelectedButton ||
             (cursorLine == 2) != (lastCursorLine == 2)) {
-            drawButtonOption();
-            lastSelectedButton = selectedButton;
+            redraw.invalidate(BUTTON_AREA[0]);
+            redraw.invalidate(BUTTON_AREA[1]);
         }
+    }
 
-        lastCursorLine = cursorLine;
+    redraw.clear();
+    if (redraw.needsPaint(TITLE_AREA)) drawHeader();
+    if (redraw.needsPaint(RULE_AREA)) {
+        display.drawFastHLine(RULE_AREA.x, RULE_AREA.y, RULE_AREA.w, Display::COLOR_GRAY);
+    }
+    if (redraw.needsPaint(TIME_AREA)) drawTimeOption();
+    if (redraw.needsPaint(TIME_MARK)) drawTimeMark();
+    if (redraw.needsPaint(SHOOTER_AREA)) drawShooterOption();
+    if (redraw.needsPaint(SHOOTER_MARK)) drawShooterMark();
+    for (uint8_t i = 0; i < 2; i++) {
+        if (redraw.needsPaint(BUTTON_AREA[i])) drawButton(i);
     }
+    if (redraw.needsPaint(HELP_AREA)) drawHelp();
+    redraw.endFrame();
+
+    // Werte speichern
+    lastShootingTime = shootingTime;
+    lastShooterCount = shooterCount;
+    lastCursorLine = cursorLine;
+    lastSelectedButton = selectedButton;
 
     needsUpdate = false;
 }
@@ -156,53 +186,25 @@ void ConfigMenu::drawHeader() {
     display.setTextColor(ST77XX_CYAN);
 
     // Zentrieren
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.getTextBounds(F("Konfiguration"), 0, 0, &x1, &y1, &w, &h);
-    display.setCursor((display.width() - w) / 2, 15);
+    display.setCursor(TextMetrics::centerX("Konfiguration", 2), TITLE_AREA.y);
     display.print(F("Konfiguration"));
-
-    // Trennlinie
-    display.drawFastHLine(10, 50, display.width() - 20, Display::COLOR_GRAY);
 }
 
 void ConfigMenu::drawTimeOption() {
-    // Optionen-Positionen (Portrait: 240 Breite)
-    const uint16_t option1_x = 120;
-    const uint16_t option2_x = 180;
-    const uint16_t y = 65;
-
-    // Bereich löschen (Zeit-Zeile + Beschriftung)
-    display.fillRect(0, y, display.width(), 40, ST77XX_BLACK);
+    const uint16_t y = TIME_AREA.y;
+    uint16_t color = cursorLine == 0 ? ST77XX_YELLOW : ST77XX_WHITE;
 
     // Label "Zeit:"
     display.setTextSize(2);
+    display.setTextColor(color);
     display.setCursor(10, y);
-    display.setTextColor(cursorLine == 0 ? ST77XX_YELLOW : ST77XX_WHITE);
     display.print(F("Zeit:"));
 
-    int16_t x1, y1;
-    uint16_t w, h;
-
-    // Option 120s
-    display.setCursor(option1_x, y);
-    display.setTextColor(cursorLine == 0 ? ST77XX_YELLOW : ST77XX_WHITE);
+    // Optionen (Unterstrich: drawTimeMark())
+    display.setCursor(TIME_OPTION_X[0], y);
     display.print(F("120s"));
-    if (shootingTime == 120) {
-        display.getTextBounds(F("120s"), option1_x, y, &x1, &y1, &w, &h);
-        display.drawLine(option1_x, y + h + 2, option1_x + w, y + h + 2,
-                        cursorLine == 0 ? ST77XX_YELLOW : ST77XX_WHITE);
-    }
-
-    // Option 240s
-    display.setCursor(option2_x, y);
-    display.setTextColor(cursorLine == 0 ? ST77XX_YELLOW : ST77XX_WHITE);
+    display.setCursor(TIME_OPTION_X[1], y);
     display.print(F("240s"));
-    if (shootingTime == 240) {
-        display.getTextBounds(F("240s"), option2_x, y, &x1, &y1, &w, &h);
-        display.drawLine(option2_x, y + h + 2, option2_x + w, y + h + 2,
-                        cursorLine == 0 ? ST77XX_YELLOW : ST77XX_WHITE);
-    }
 
     // Beschriftung "pro Passe"
     display.setTextSize(1);
@@ -211,17 +213,20 @@ void ConfigMenu::drawTimeOption() {
     display.print(F("pro Passe"));
 }
 
-void ConfigMenu::drawShooterOption() {
-    // Optionen-Positionen (Portrait: 240 Breite)
-    const uint16_t y = 115;
+void ConfigMenu::drawTimeMark() {
+    // Unterstrich unter der gewählten Zeit ("120s"/"240s": 4 Zeichen × 12px)
+    uint16_t x = TIME_OPTION_X[shootingTime == 120 ? 0 : 1];
+    display.drawFastHLine(x, TIME_MARK.y, 4 * 12 + 1, cursorLine == 0 ? ST77XX_YELLOW : ST77XX_WHITE);
+}
 
-    // Bereich löschen (Schützen-Zeile + Beschriftung)
-    display.fillRect(0, y, display.width(), 50, ST77XX_BLACK);
+void ConfigMenu::drawShooterOption() {
+    const uint16_t y = SHOOTER_AREA.y;
+    uint16_t color = cursorLine == 1 ? ST77XX_YELLOW : ST77XX_WHITE;
 
     // Label "Schuetzen:"
     display.setTextSize(2);
     display.setCursor(10, y);
-    display.setTextColor(cursorLine == 1 ? ST77XX_YELLOW : ST77XX_WHITE);
+    display.setTextColor(color);
     display.print(F("Schuetzen:"));
 
     // Beschriftung "pro Scheibe" (direkt unter "Schuetzen:")
@@ -230,92 +235,48 @@ void ConfigMenu::drawShooterOption() {
     display.setCursor(10, y + 18);
     display.print(F("pro Scheibe"));
 
-    // Optionen auf zweiter Zeile
+    // Optionen auf zweiter Zeile (Unterstrich: drawShooterMark())
     const uint16_t optionY = y + 30;
-    const uint16_t option1_x = 60;
-    const uint16_t option2_x = 140;
-
     display.setTextSize(2);
-    display.setTextColor(cursorLine == 1 ? ST77XX_YELLOW : ST77XX_WHITE);
-
-    int16_t x1, y1;
-    uint16_t w, h;
-
-    // Option 1-2
-    display.setCursor(option1_x, optionY);
+    display.setTextColor(color);
+    display.setCursor(SHOOTER_OPTION_X[0], optionY);
     display.print(F("1-2"));
-    if (shooterCount == 2) {
-        display.getTextBounds(F("1-2"), option1_x, optionY, &x1, &y1, &w, &h);
-        display.drawLine(option1_x, optionY + h + 2, option1_x + w, optionY + h + 2,
-                        cursorLine == 1 ? ST77XX_YELLOW : ST77XX_WHITE);
-    }
-
-    // Option 3-4
-    display.setCursor(option2_x, optionY);
+    display.setCursor(SHOOTER_OPTION_X[1], optionY);
     display.print(F("3-4"));
-    if (shooterCount == 4) {
-        display.getTextBounds(F("3-4"), option2_x, optionY, &x1, &y1, &w, &h);
-        display.drawLine(option2_x, optionY + h + 2, option2_x + w, optionY + h + 2,
-                        cursorLine == 1 ? ST77XX_YELLOW : ST77XX_WHITE);
-    }
 }
 
-void ConfigMenu::drawButtonOption() {
-    // Portrait: Buttons übereinander
-    const uint16_t y = 180;
-    const uint16_t buttonHeight = 35;
-    const uint16_t buttonSpacing = 10;
-    const uint16_t margin = 20;
-    const uint16_t buttonWidth = display.width() - 2 * margin;
+void ConfigMenu::drawShooterMark() {
+    // Unterstrich unter der gewählten Anzahl ("1-2"/"3-4": 3 Zeichen × 12px)
+    uint16_t x = SHOOTER_OPTION_X[shooterCount == 2 ? 0 : 1];
+    display.drawFastHLine(x, SHOOTER_MARK.y, 3 * 12 + 1, cursorLine == 1 ? ST77XX_YELLOW : ST77XX_WHITE);
+}
 
-    // Bereich löschen (beide Buttons inkl. Schatten)
-    display.fillRect(0, y, display.width(), 2 * buttonHeight + buttonSpacing + 5, ST77XX_BLACK);
+void ConfigMenu::drawButton(uint8_t index) {
+    // Portrait: Buttons übereinander (0 = "Aendern" oben, 1 = "Start" unten)
+    const ScreenRect& area = BUTTON_AREA[index];
+    const __FlashStringHelper* label = index == 0 ? F("Aendern") : F("Start");
 
     // Farben für aktive Zeile
     uint16_t activeColor = cursorLine == 2 ? ST77XX_YELLOW : ST77XX_WHITE;
-    uint16_t fillColor = Display::COLOR_DARKGRAY;
+    bool selected = selectedButton == index;
 
-    int16_t x1, y1;
-    uint16_t w, h;
-
-    // --- Button 1: "Aendern" (oben) ---
-    uint16_t btn1_y = y;
-
-    if (selectedButton == 0) {
-        display.fillRect(margin, btn1_y, buttonWidth, buttonHeight, fillColor);
+    if (selected) {
+        display.fillRect(area.x, area.y, area.w, area.h, Display::COLOR_DARKGRAY);
     }
-    display.drawRect(margin, btn1_y, buttonWidth, buttonHeight, activeColor);
+    display.drawRect(area.x, area.y, area.w, area.h, activeColor);
 
+    int16_t x1, y1;
+    uint16_t w, h;
     display.setTextSize(2);
-    display.getTextBounds(F("Aendern"), 0, 0, &x1, &y1, &w, &h);
-    uint16_t text_x = margin + (buttonWidth - w) / 2;
-    uint16_t text_y = btn1_y + (buttonHeight - h) / 2;
-
-    display.setCursor(text_x, text_y);
-    display.setTextColor(activeColor);
-    display.print(F("Aendern"));
-
-    if (selectedButton == 0) {
-        display.drawLine(text_x, text_y + h + 1, text_x + w, text_y + h + 1, activeColor);
-    }
-
-    // --- Button 2: "Start" (unten) ---
-    uint16_t btn2_y = y + buttonHeight + buttonSpacing;
-
-    if (selectedButton == 1) {
-        display.fillRect(margin, btn2_y, buttonWidth, buttonHeight, fillColor);
-    }
-    display.drawRect(margin, btn2_y, buttonWidth, buttonHeight, activeColor);
-
-    display.getTextBounds(F("Start"), 0, 0, &x1, &y1, &w, &h);
-    text_x = margin + (buttonWidth - w) / 2;
-    text_y = btn2_y + (buttonHeight - h) / 2;
+    display.getTextBounds(label, 0, 0, &x1, &y1, &w, &h);
+    uint16_t text_x = area.x + (area.w - w) / 2;
+    uint16_t text_y = area.y + (area.h - h) / 2;
 
     display.setCursor(text_x, text_y);
     display.setTextColor(activeColor);
-    display.print(F("Start"));
+    display.print(label);
 
-    if (selectedButton == 1) {
+    if (selected) {
         display.drawLine(text_x, text_y + h + 1, text_x + w, text_y + h + 1, activeColor);
     }
 }
@@ -324,10 +285,10 @@ void ConfigMenu::drawHelp() {
     // Hilfetext unten (Portrait: mehr Platz)
     display.setTextSize(1);
     display.setTextColor(Display::COLOR_GRAY);
-    display.setCursor(10, display.height() - 30);
+    display.setCursor(10, HELP_AREA.y);
     display.print(F("L/R: Aendern, OK: Weiter"));
 
     // Alarm-Hinweis (zweite Zeile)
-    display.setCursor(10, display.height() - 15);
+    display.setCursor(10, HELP_AREA.y + 15);
     display.print(F("Pfeiltaste >2s: Alarm"));
 }
@@ -16,6 +16,7 @@
 #include <Adafruit_ST7789.h>
 #include "Config.h"
 #include "ButtonManager.h"
+#include "RedrawManager.h"
 
 /**
  * @brief Konfigurationsmenü für Turniereinstellungen
@@ -47,8 +48,9 @@ public:
      * @brief Konstruktor
      * @param tft Display-Referenz
      * @param btnMgr ButtonManager-Referenz
+     * @param redrawMgr Gemeinsame Invalidierung aller Screens
      */
-    ConfigMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr);
+    ConfigMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr, RedrawManager& redrawMgr);
 
     /**
      * @brief Initialisiert das Menü
@@ -66,7 +68,7 @@ public:
     void update();
 
     /**
-     * @brief Zeichnet das komplette Menü
+     * @brief Zeichnet das Menü (beim ersten Aufruf komplett, danach nur geänderte Widgets)
      *
      * Sollte aufgerufen werden wenn needsRedraw() == true.
      * Setzt needsUpdate-Flag zurück.
@@ -113,6 +115,7 @@ public:
 private:
     Adafruit_ST7789& display;
     ButtonManager& buttons;
+    RedrawManager& redraw;
 
     // Konfigurationswerte
     uint8_t shootingTime;   // 120 oder 240 Sekunden
@@ -137,7 +140,9 @@ private:
     // Hilfsfunktionen für selective drawing
     void drawHeader();
     void drawTimeOption();
+    void drawTimeMark();
     void drawShooterOption();
-    void drawButtonOption();
+    void drawShooterMark();
+    void drawButton(uint8_t index);
     void drawHelp();
 };
@@ -0,0 +1,64 @@
+/**
+ * @file Images.h
+ * @brief RLE/Paletten-Bilder für Adafruit_SPITFT::drawRLEImage()
+ *
+ * Generiert mit tools/rleimage.py - nicht von Hand bearbeiten:
+ *     python3 rleimage.py -o ../Images.h images/logo.xpm images/battery.xpm images/link.xpm
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+namespace Images {
+
+    // 40x40 Pixel, 5 Farben: 268 Bytes (RGB565: 3200 Bytes)
+    constexpr uint8_t LOGO_WIDTH = 40;
+    constexpr uint8_t LOGO_HEIGHT = 40;
+    constexpr uint8_t LOGO_COLORS = 5;
+    const uint8_t LOGO[268] PROGMEM = {
+        0x28, 0x28, 0x05, 0x00, 0x00, 0xFF, 0xFF, 0x1F, 0x04, 0x00, 0xF8, 0x00, 0xFF, 0xF0, 0x26, 0xB1,
+        0xF0, 0x09, 0xF1, 0x02, 0xF0, 0x05, 0xF1, 0x04, 0xF0, 0x02, 0x91, 0x30, 0x91, 0xE0, 0x61, 0xB0,
+        0x61, 0xC0, 0x51, 0xF0, 0x00, 0x51, 0xA0, 0x51, 0xF0, 0x02, 0x51, 0x80, 0x41, 0x80, 0x32, 0x80,
+        0x41, 0x70, 0x31, 0x60, 0x92, 0x60, 0x31, 0x60, 0x41, 0x40, 0xD2, 0x40, 0x41, 0x40, 0x41, 0x40,
+        0xF2, 0x00, 0x40, 0x41, 0x30, 0x31, 0x40, 0x62, 0x33, 0x62, 0x40, 0x31, 0x30, 0x31, 0x30, 0x52,
+        0x73, 0x52, 0x30, 0x31, 0x20, 0x31, 0x40, 0x32, 0xB3, 0x32, 0x40, 0x31, 0x10, 0x31, 0x30, 0x42,
+        0xB3, 0x42, 0x30, 0x31, 0x10, 0x31, 0x30, 0x32, 0x43, 0x34, 0x43, 0x32, 0x30, 0x31, 0x10, 0x31,
+        0x30, 0x32, 0x33, 0x54, 0x33, 0x32, 0x30, 0x31, 0x10, 0x21, 0x30, 0x32, 0x33, 0x74, 0x33, 0x32,
+        0x30, 0x21, 0x10, 0x21, 0x30, 0x32, 0x33, 0x74, 0x33, 0x32, 0x30, 0x21, 0x10, 0x21, 0x30, 0x32,
+        0x33, 0x74, 0x33, 0x32, 0x30, 0x21, 0x10, 0x21, 0x30, 0x32, 0x33, 0x74, 0x33, 0x32, 0x30, 0x21,
+        0x10, 0x31, 0x30, 0x32, 0x33, 0x54, 0x33, 0x32, 0x30, 0x31, 0x10, 0x31, 0x30, 0x32, 0x43, 0x34,
+        0x43, 0x32, 0x30, 0x31, 0x10, 0x31, 0x30, 0x42, 0xB3, 0x42, 0x30, 0x31, 0x10, 0x31, 0x40, 0x32,
+        0xB3, 0x32, 0x40, 0x31, 0x20, 0x31, 0x30, 0x52, 0x73, 0x52, 0x30, 0x31, 0x30, 0x31, 0x40, 0x62,
+        0x33, 0x62, 0x40, 0x31, 0x30, 0x41, 0x40, 0xF2, 0x00, 0x40, 0x41, 0x40, 0x41, 0x40, 0xD2, 0x40,
+        0x41, 0x60, 0x31, 0x60, 0x92, 0x60, 0x31, 0x70, 0x41, 0x80, 0x32, 0x80, 0x41, 0x80, 0x51, 0xF0,
+        0x02, 0x51, 0xA0, 0x51, 0xF0, 0x00, 0x51, 0xC0, 0x61, 0xB0, 0x61, 0xE0, 0x91, 0x30, 0x91, 0xF0,
+        0x02, 0xF1, 0x04, 0xF0, 0x05, 0xF1, 0x02, 0xF0, 0x09, 0xB1, 0xF0, 0x26
+    };
+
+    // 18x8 Pixel, 14 Farben: 105 Bytes (RGB565: 288 Bytes)
+    constexpr uint8_t BATTERY_WIDTH = 18;
+    constexpr uint8_t BATTERY_HEIGHT = 8;
+    constexpr uint8_t BATTERY_COLORS = 14;
+    const uint8_t BATTERY[105] PROGMEM = {
+        0x12, 0x08, 0x0E, 0x00, 0x00, 0xFF, 0xFF, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0,
+        0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xF1,
+        0x00, 0x10, 0x01, 0xD0, 0x01, 0x10, 0x01, 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+        0x0A, 0x0B, 0x0C, 0x0D, 0x00, 0x31, 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+        0x0B, 0x0C, 0x0D, 0x00, 0x31, 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
+        0x0C, 0x0D, 0x00, 0x31, 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C,
+        0x0D, 0x00, 0x31, 0xD0, 0x01, 0x10, 0xF1, 0x00, 0x10
+    };
+
+    // 11x8 Pixel, 5 Farben: 51 Bytes (RGB565: 176 Bytes)
+    constexpr uint8_t LINK_WIDTH = 11;
+    constexpr uint8_t LINK_HEIGHT = 8;
+    constexpr uint8_t LINK_COLORS = 5;
+    const uint8_t LINK[51] PROGMEM = {
+        0x0B, 0x08, 0x05, 0x00, 0x00, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x80, 0x14, 0x80,
+        0x14, 0x50, 0x13, 0x00, 0x14, 0x50, 0x13, 0x00, 0x14, 0x20, 0x12, 0x00, 0x13, 0x00, 0x14, 0x20,
+        0x12, 0x00, 0x13, 0x00, 0x14, 0x11, 0x00, 0x12, 0x00, 0x13, 0x00, 0x14, 0x11, 0x00, 0x12, 0x00,
+        0x13, 0x00, 0x14
+    };
+
+} // namespace Images
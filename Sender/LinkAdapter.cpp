@@ -0,0 +1,463 @@
+/**
+ * @file LinkAdapter.cpp
+ * @brief Implementierung der adaptiven Funkparameter
+ */
+
+#include "LinkAdapter.h"
+
+namespace {
+    /**
+     * @brief Eigenschaften einer Datenrate (Index: RadioRate)
+     */
+    struct RateInfo {
+        rf24_datarate_e dataRate;
+        uint16_t airtimeUs;     // 130µs Einschwingen + Paket (13 Byte Payload)
+        uint8_t minRetryDelay;  // Kleinster ARD, bei dem das ACK mit 21 Byte Payload noch passt
+    };
+
+    const RateInfo RATES[] = {
+        { RF24_250KBPS, RF::TX_AIRTIME_US, RF::RETRY_DELAY },  // 1.5ms
+        { RF24_1MBPS,   310,               1 },                // 500µs
+        { RF24_2MBPS,   225,               1 }                 // 500µs
+    };
+
+    static_assert(RF::DATA_RATE == RF24_250KBPS && profileRate(RADIO_PROFILE_BASE) == RADIO_RATE_250K,
+                  "Startwerte in Config.h müssen zu RADIO_PROFILE_BASE passen");
+
+    constexpr uint8_t PA_LEVEL_MAX = RF24_PA_MAX;
+    constexpr uint8_t RETRY_COUNT_MAX = 15;
+    constexpr uint8_t RETRY_DELAY_MAX = 15;
+    constexpr uint16_t ALL_CANDIDATES = (1UL << ChannelScan::CANDIDATES) - 1;
+
+    #if DEBUG_ENABLED
+    // Stromaufnahme beim Senden je PA-Level in 0.1mA (Datenblatt nRF24L01+)
+    const uint8_t TX_CURRENT_DMA[] = { 70, 75, 90, 113 };
+
+    void printProfile(uint8_t channel, uint8_t profile, uint8_t paLevel, uint8_t retryDelay, uint8_t retryCount) {
+        static const char* const RATE_NAMES[] = { "250K", "1M", "2M" };
+        static const char* const PA_NAMES[] = { "MIN", "LOW", "HIGH", "MAX" };
+        DEBUG_PRINT(F("Ch"));
+        DEBUG_PRINT(channel);
+        DEBUG_PRINT(F(" "));
+        DEBUG_PRINT(RATE_NAMES[profileRate(profile)]);
+        DEBUG_PRINT(F(" PA "));
+        DEBUG_PRINT(PA_NAMES[paLevel]);
+        DEBUG_PRINT(F("/"));
+        DEBUG_PRINT(PA_NAMES[profilePaLevel(profile)]);
+        DEBUG_PRINT(F(" ARD "));
+        DEBUG_PRINT(retryDelay);
+        DEBUG_PRINT(F(" ARC "));
+        DEBUG_PRINT(retryCount);
+    }
+    #endif
+}
+
+LinkAdapter::LinkAdapter(RF24& radio, TxQueue& queue, const ChannelScan& scan)
+    : radio(radio)
+    , queue(queue)
+    , scan(scan)
+    , current(RADIO_PROFILE_BASE)
+    , previous(RADIO_PROFILE_BASE)
+    , requested(RADIO_PROFILE_BASE)
+    , currentChannel(RF::CHANNEL)
+    , previousChannel(RF::CHANNEL)
+    , requestedChannel(RF::CHANNEL)
+    , requestCommand(CMD_RADIO_PROFILE)
+    , paLevel(RF::POWER_LEVEL)
+    , retryDelay(RF::RETRY_DELAY)
+    , retryCount(RF::RETRY_COUNT)
+    , phase(Phase::STABLE)
+    , probePending(false)
+    , consecutiveFails(0)
+    , holdWindows(0)
+    , holdLeft(0)
+    , lastStepEfficient(false)
+    , logNextWindow(false)
+    , remoteMask(0)
+    , avoidMask(0)
+    , channelChosen(false)
+    , migrateHoldLeft(0)
+    , lastReportPing(0) {
+    memset(remoteLevels, 0xFF, sizeof(remoteLevels));
+    resetWindow();
+}
+
+void LinkAdapter::begin() {
+    current = RADIO_PROFILE_BASE;
+    currentChannel = RF::CHANNEL;
+    paLevel = RF::POWER_LEVEL;
+    retryDelay = RF::RETRY_DELAY;
+    retryCount = RF::RETRY_COUNT;
+    phase = Phase::STABLE;
+    consecutiveFails = 0;
+    applyLocal();
+    resetWindow();
+}
+
+void LinkAdapter::addReport(const TxReport& report) {
+    if (report.result == TX_SUPERSEDED) return;
+
+    if (packets < 255) {
+        packets++;
+    }
+
+    if (report.result != TX_SUCCESS) {
+        failures++;
+        if (consecutiveFails < 255) {
+            consecutiveFails++;
+        }
+
+        // Verbindung weg: beide Seiten treffen sich im Startprofil auf dem Treffpunkt
+        if (consecutiveFails >= Adapt::FALLBACK_FAILS &&
+            (current != RADIO_PROFILE_BASE || currentChannel != RF::CHANNEL || phase != Phase::STABLE)) {
+            fallbackToBase();
+        }
+        return;
+    }
+
+    consecutiveFails = 0;
+    retries += report.retries;
+    if (report.retries > maxRetries) {
+        maxRetries = report.retries;
+    }
+    rttSum += report.rttTicks;
+}
+
+void LinkAdapter::addChannelReport(uint8_t report) {
+    uint8_t index = ChannelScan::reportIndex(report);
+    uint8_t level = ChannelScan::reportLevel(report);
+
+    // Mehrere Anzeigen: der Kanal muss für alle taugen, es zählt die höchste Belegung
+    if ((remoteMask & (1U << index)) && remoteLevel(index) > level) return;
+
+    uint8_t& pair = remoteLevels[index >> 1];
+    pair = (index & 1) ? (uint8_t)((pair & 0x0F) | (level << 4))
+                       : (uint8_t)((pair & 0xF0) | level);
+    remoteMask |= (1U << index);
+}
+
+void LinkAdapter::update() {
+    if (phase == Phase::PROBING && probePending) {
+        probePending = !queue.enqueue(CMD_PING, onProbeResult, this);
+        return;
+    }
+
+    if (phase != Phase::STABLE || !queue.isIdle()) return;
+
+    // Kanal-Messung des Empfängers abholen (eine Meldung pro ACK), solange er antwortet
+    if (remoteMask != ALL_CANDIDATES) {
+        if (consecutiveFails == 0 && millis() - lastReportPing >= Adapt::REPORT_PING_MS) {
+            lastReportPing = millis();
+            queue.enqueue(CMD_PING, nullptr, nullptr);
+        }
+        return;
+    }
+
+    // Nach Start und Rückfall: freiesten Kanal wählen, sobald der Empfänger antwortet
+    if (!channelChosen && consecutiveFails == 0 && scan.passes() > 0) {
+        channelChosen = true;
+        uint8_t best = bestCandidate(ChannelScan::NO_CANDIDATE);
+        if (best != ChannelScan::NO_CANDIDATE && ChannelScan::candidateChannel(best) != currentChannel) {
+            requestChannel(ChannelScan::candidateChannel(best));
+        }
+        return;
+    }
+
+    // Lokale Einstellungen nur ändern, während nichts gesendet wird
+    if (packets >= Adapt::WINDOW) {
+        evaluateWindow();
+    }
+}
+
+//=============================================================================
+// Private Hilfsfunktionen
+//=============================================================================
+
+void LinkAdapter::evaluateWindow() {
+    bool bad = failures > 0 || retries >= Adapt::BAD_RETRIES;
+    bool good = failures == 0 && retries <= Adapt::GOOD_RETRIES;
+
+    if (logNextWindow) {
+        logWindow(true);
+        logNextWindow = false;
+    }
+
+    // Ein Rückschritt direkt nach einem Effizienz-Schritt sperrt weitere länger
+    bool blame = lastStepEfficient;
+    lastStepEfficient = false;
+
+    uint8_t rate = profileRate(current);
+    uint8_t remotePa = profilePaLevel(current);
+    uint8_t target = current;
+    uint8_t targetChannel = currentChannel;
+    uint8_t newPa = paLevel;
+
+    // Retries nach Messung: genug Reserve über dem gemessenen Maximum, bei
+    // Fehlschlägen alle 15 mit längerem Abstand (überbrückt Störungs-Bursts)
+    uint8_t minDelay = RATES[rate].minRetryDelay;
+    uint8_t newDelay = minDelay;
+    uint8_t newCount = RETRY_COUNT_MAX;
+    if (failures > 0) {
+        newDelay = (minDelay * 2 + 1 > RETRY_DELAY_MAX) ? RETRY_DELAY_MAX : minDelay * 2 + 1;
+    } else if (maxRetries * 2 + 2 < RETRY_COUNT_MAX) {
+        newCount = (maxRetries * 2 + 2 < Adapt::MIN_RETRY_COUNT) ? Adapt::MIN_RETRY_COUNT : maxRetries * 2 + 2;
+    }
+
+    // Viele Retries: eher ein gestörter Kanal - wechseln statt lauter senden
+    if (migrateHoldLeft > 0) {
+        migrateHoldLeft--;
+    } else if ((retries >= Adapt::MIGRATE_RETRIES || failures >= Adapt::MIGRATE_FAILURES) && scan.passes() > 0) {
+        uint8_t here = ChannelScan::candidateOf(currentChannel);
+        if (here != ChannelScan::NO_CANDIDATE) {
+            avoidMask |= (1U << here);
+        }
+        uint8_t best = bestCandidate(here);
+        if (best != ChannelScan::NO_CANDIDATE) {
+            targetChannel = ChannelScan::candidateChannel(best);
+            migrateHoldLeft = Adapt::MIGRATE_HOLD_WINDOWS;
+        }
+    }
+
+    if (bad) {
+        if (blame) {
+            backOff();
+        }
+
+        // Robuster: erst eigene Leistung, dann die des Empfängers, dann langsamer
+        if (targetChannel != currentChannel) {
+            // Erst den neuen Kanal ausprobieren
+        } else if (paLevel < PA_LEVEL_MAX) {
+            newPa = paLevel + 1;
+        } else if (remotePa < PA_LEVEL_MAX) {
+            target = makeRadioProfile(rate, remotePa + 1);
+        } else if (rate > RADIO_RATE_250K) {
+            target = makeRadioProfile(rate - 1, remotePa);
+        }
+    } else if (good && holdLeft == 0) {
+        // Effizienter: erst schneller (kürzere Sendezeit), dann weniger Leistung
+        lastStepEfficient = true;
+        if (rate < RADIO_RATE_2M) {
+            target = makeRadioProfile(rate + 1, remotePa);
+        } else if (paLevel > RF24_PA_MIN) {
+            newPa = paLevel - 1;
+        } else if (remotePa > RF24_PA_MIN) {
+            target = makeRadioProfile(rate, remotePa - 1);
+        } else {
+            lastStepEfficient = false;
+        }
+    } else if (holdLeft > 0) {
+        holdLeft--;
+    }
+
+    bool localChange = (newPa != paLevel || newDelay != retryDelay || newCount != retryCount);
+    if (localChange || target != current || targetChannel != currentChannel) {
+        logWindow(false);
+    }
+
+    if (localChange) {
+        paLevel = newPa;
+        retryDelay = newDelay;
+        retryCount = newCount;
+        applyLocal();
+        logNextWindow = true;
+    }
+
+    resetWindow();
+
+    if (targetChannel != currentChannel) {
+        requestChannel(targetChannel);
+    } else if (target != current) {
+        requestProfile(target);
+    }
+}
+
+void LinkAdapter::requestProfile(uint8_t profile) {
+    requested = profile;
+    requestedChannel = currentChannel;
+    startRequest(CMD_RADIO_PROFILE);
+}
+
+void LinkAdapter::requestChannel(uint8_t channel) {
+    DEBUG_PRINT(F("Link: Kanal "));
+    DEBUG_PRINTLN(channel);
+
+    requested = current;
+    requestedChannel = channel;
+    startRequest(CMD_CHANNEL);
+}
+
+void LinkAdapter::startRequest(RadioCommand command) {
+    previous = current;
+    previousChannel = currentChannel;
+    requestCommand = command;
+    phase = Phase::REQUESTING;
+
+    if (!queue.enqueue(command, onRequestResult, this)) {
+        phase = Phase::STABLE;
+    }
+}
+
+void LinkAdapter::switchTo(uint8_t profile, uint8_t channel) {
+    // Neue Datenrate: kleinster passender Retry-Abstand
+    if (profileRate(profile) != profileRate(current)) {
+        retryDelay = RATES[profileRate(profile)].minRetryDelay;
+    }
+    current = profile;
+    currentChannel = channel;
+    applyLocal();
+
+    // Empfänger schaltet erst nach seinem ACK um
+    queue.pause(Adapt::SWITCH_GUARD_MS);
+    resetWindow();
+    logNextWindow = true;
+}
+
+void LinkAdapter::fallbackToBase() {
+    DEBUG_PRINTLN(F("Link: Rueckfall auf Startprofil"));
+
+    current = RADIO_PROFILE_BASE;
+    currentChannel = RF::CHANNEL;
+    paLevel = RF::POWER_LEVEL;
+    retryDelay = RF::RETRY_DELAY;
+    retryCount = RF::RETRY_COUNT;
+    phase = Phase::STABLE;
+    lastStepEfficient = false;
+    channelChosen = false;  // Wieder wechseln, sobald der Empfänger antwortet
+    backOff();
+    applyLocal();
+    resetWindow();
+}
+
+void LinkAdapter::backOff() {
+    holdWindows = (holdWindows == 0) ? 1
+                : (holdWindows >= Adapt::MAX_HOLD_WINDOWS / 2) ? Adapt::MAX_HOLD_WINDOWS
+                : holdWindows * 2;
+    holdLeft = holdWindows;
+}
+
+void LinkAdapter::applyLocal() {
+    const RateInfo& info = RATES[profileRate(current)];
+    radio.setChannel(currentChannel);
+    radio.setDataRate(info.dataRate);
+    radio.setPALevel(paLevel);
+    radio.setRetries(retryDelay, retryCount);
+    queue.setTiming(info.airtimeUs, (retryDelay + 1) * 250U);
+}
+
+/**
+ * @brief Freiester Kanal-Kandidat (eigene Messung + Meldung des Empfängers)
+ * @param exclude Nicht in Frage kommender Kandidat (oder NO_CANDIDATE)
+ * @return Index oder NO_CANDIDATE
+ *
+ * Gestörte Kandidaten (avoidMask) bleiben außen vor, bis keiner mehr übrig ist.
+ */
+uint8_t LinkAdapter::bestCandidate(uint8_t exclude) {
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        uint8_t best = ChannelScan::NO_CANDIDATE;
+        uint8_t bestLevel = 0xFF;
+        for (uint8_t i = 0; i < ChannelScan::CANDIDATES; i++) {
+            if (i == exclude || (avoidMask & (1U << i))) continue;
+
+            uint8_t level = scan.candidateLevel(i) + remoteLevel(i);
+            if (level < bestLevel) {
+                best = i;
+                bestLevel = level;
+            }
+        }
+        if (best != ChannelScan::NO_CANDIDATE) return best;
+
+        avoidMask = 0;
+    }
+    return ChannelScan::NO_CANDIDATE;
+}
+
+uint8_t LinkAdapter::remoteLevel(uint8_t index) const {
+    uint8_t pair = remoteLevels[index >> 1];
+    return (index & 1) ? (pair >> 4) : (pair & 0x0F);
+}
+
+void LinkAdapter::resetWindow() {
+    packets = 0;
+    failures = 0;
+    retries = 0;
+    maxRetries = 0;
+    rttSum = 0;
+}
+
+/**
+ * @brief Protokolliert Einstellungen, Sendeenergie und Latenz des Fensters
+ * @param afterChange true: erstes Fenster nach einem Wechsel
+ *
+ * Energie pro Kommando = Versuche pro Kommando × Sendezeit × Strom × 3.3V.
+ */
+void LinkAdapter::logWindow(bool afterChange) const {
+    #if DEBUG_ENABLED
+    uint8_t successes = packets - failures;
+    uint32_t attempts = successes + retries + (uint32_t)failures * (retryCount + 1);
+    uint32_t attemptNj = 33UL * TX_CURRENT_DMA[paLevel] * RATES[profileRate(current)].airtimeUs / 100;
+    uint32_t energyNj = packets ? attemptNj * attempts / packets : 0;
+    uint32_t latencyUs = successes ? rttSum / successes * (1000000UL / Timebase::TICKS_PER_SECOND) : 0;
+
+    DEBUG_PRINT(afterChange ? F("Link nach: ") : F("Link vor:  "));
+    printProfile(currentChannel, current, paLevel, retryDelay, retryCount);
+    DEBUG_PRINT(F(" | "));
+    DEBUG_PRINT(energyNj / 1000);
+    DEBUG_PRINT(F("uJ/Kmd "));
+    DEBUG_PRINT(latencyUs);
+    DEBUG_PRINT(F("us ARC "));
+    DEBUG_PRINT(retries);
+    DEBUG_PRINT(F(" Fail "));
+    DEBUG_PRINTLN(failures);
+    #else
+    (void)afterChange;
+    #endif
+}
+
+void LinkAdapter::onRequestResult(void* context, const TxReport& report) {
+    LinkAdapter* self = static_cast<LinkAdapter*>(context);
+    if (self->phase != Phase::REQUESTING) return;
+
+    if (report.result != TX_SUCCESS) {
+        // Empfänger hat nichts bestätigt: bleibt beim alten Wert (oder kehrt nach PROFILE_CONFIRM_MS zurück)
+        DEBUG_PRINTLN(F("Link: Profil nicht bestaetigt"));
+        self->phase = Phase::STABLE;
+        if (report.result != TX_SUPERSEDED) {
+            self->queue.pause(PROFILE_CONFIRM_MS + Adapt::SWITCH_GUARD_MS);
+        }
+        return;
+    }
+
+    self->switchTo(self->requested, self->requestedChannel);
+    self->phase = Phase::PROBING;
+    self->probePending = true;
+}
+
+void LinkAdapter::onProbeResult(void* context, const TxReport& report) {
+    LinkAdapter* self = static_cast<LinkAdapter*>(context);
+    if (self->phase != Phase::PROBING) return;
+
+    if (report.result == TX_SUPERSEDED) {
+        self->probePending = true;  // Erneut versuchen
+        return;
+    }
+
+    if (report.result == TX_SUCCESS) {
+        DEBUG_PRINTLN(F("Link: Profil uebernommen"));
+        self->phase = Phase::STABLE;
+        return;
+    }
+
+    // Im neuen Profil keine Verbindung: zurück, und warten bis der Empfänger auch zurück ist
+    DEBUG_PRINTLN(F("Link: Profil verworfen"));
+    if (self->requestCommand == CMD_CHANNEL) {
+        uint8_t index = ChannelScan::candidateOf(self->requestedChannel);
+        if (index != ChannelScan::NO_CANDIDATE) {
+            self->avoidMask |= (1U << index);
+        }
+    }
+    self->switchTo(self->previous, self->previousChannel);
+    self->queue.pause(PROFILE_CONFIRM_MS + Adapt::SWITCH_GUARD_MS);
+    self->phase = Phase::STABLE;
+    self->lastStepEfficient = false;
+    self->backOff();
+}
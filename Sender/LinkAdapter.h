@@ -0,0 +1,153 @@
+/**
+ * @file LinkAdapter.h
+ * @brief Anpassung von Kanal, Datenrate, Sendeleistung und Retries an die Verbindung
+ *
+ * Bei guter Verbindung verschwenden 250kbps und PA_MAX Sendezeit und
+ * Batterie, bei schlechter helfen mehr Leistung, längere Retry-Abstände
+ * und eine niedrigere Datenrate. Der LinkAdapter wertet jede Übertragung
+ * aus (Retries, Fehlschläge) und entscheidet nach Adapt::WINDOW
+ * Übertragungen über den nächsten Schritt.
+ */
+
+#pragma once
+
+#include <RF24.h>
+#include "Config.h"
+#include "Commands.h"
+#include "TxQueue.h"
+#include "ChannelScan.h"
+
+/**
+ * @brief Regelkreis für das Funkprofil (mit Handshake) und die lokalen Sendeparameter
+ *
+ * Nur lokal (sofort): Sendeleistung des Senders, ARD und ARC.
+ * Mit Handshake (CMD_RADIO_PROFILE): Datenrate und Sendeleistung des Empfängers.
+ * Mit Handshake (CMD_CHANNEL): Kanal - sobald die Kanal-Messung des Empfängers
+ * vollständig ist, und wieder bei vielen Retries (statt mehr Sendeleistung).
+ *
+ * Handshake:
+ * 1. CMD_RADIO_PROFILE/CMD_CHANNEL mit dem neuen Wert im alten Profil senden
+ * 2. ACK erhalten: selbst umschalten, Adapt::SWITCH_GUARD_MS nichts senden
+ *    (der Empfänger schaltet PROFILE_SWITCH_DELAY_MS nach dem Empfang um)
+ * 3. PING im neuen Profil: bestätigt → übernommen, sonst zurück zum alten Profil
+ *    und PROFILE_CONFIRM_MS Pause (so lange wartet der Empfänger auf ein Paket,
+ *    bevor er selbst zurückschaltet)
+ *
+ * Gehen Adapt::FALLBACK_FAILS Übertragungen in Folge verloren, schaltet der
+ * Sender sofort auf RADIO_PROFILE_BASE und RF::CHANNEL, der Empfänger nach
+ * PROFILE_SILENCE_MS ohne Paket ebenfalls - beide Seiten treffen sich immer
+ * im Startprofil auf dem Treffpunkt-Kanal.
+ *
+ * Usage:
+ * @code
+ * linkAdapter.begin();                 // nach radio.begin()
+ * linkAdapter.addReport(report);       // TxQueue Complete-Hook
+ * linkAdapter.addChannelReport(ack.status.channelReport);  // ACK-Payload
+ * linkAdapter.update();                // in loop()
+ * @endcode
+ */
+class LinkAdapter {
+public:
+    LinkAdapter(RF24& radio, TxQueue& queue, const ChannelScan& scan);
+
+    /**
+     * @brief Setzt das Startprofil (Radio muss bereits initialisiert sein)
+     */
+    void begin();
+
+    /**
+     * @brief Wertet eine Übertragung aus (TxQueue Complete-Hook)
+     * @param report Ergebnis der Übertragung
+     */
+    void addReport(const TxReport& report);
+
+    /**
+     * @brief Übernimmt eine Kanal-Meldung einer Anzeige (ReceiverStatus::channelReport, pro Kandidat gilt die höchste Belegung)
+     * @param report Kandidat und Belegung (ChannelScan::report())
+     */
+    void addChannelReport(uint8_t report);
+
+    /**
+     * @brief Update-Funktion (in loop() aufrufen): Entscheidung nach jedem Fenster, Handshake
+     */
+    void update();
+
+    /**
+     * @brief Parameter für CMD_RADIO_PROFILE (Funkprofil) bzw. CMD_CHANNEL (Kanal)
+     */
+    uint8_t requestParam() const { return requestCommand == CMD_CHANNEL ? requestedChannel : requested; }
+
+    /**
+     * @brief Aktuelles Funkprofil (Datenrate, Sendeleistung des Empfängers)
+     */
+    uint8_t profile() const { return current; }
+
+    /**
+     * @brief Aktueller Kanal
+     */
+    uint8_t channel() const { return currentChannel; }
+
+private:
+    enum class Phase : uint8_t {
+        STABLE,      // Profil gilt, Statistik läuft
+        REQUESTING,  // CMD_RADIO_PROFILE wartet auf ACK
+        PROBING      // Umgeschaltet, PING im neuen Profil steht aus
+    };
+
+    RF24& radio;
+    TxQueue& queue;
+    const ChannelScan& scan;
+
+    // Einstellungen
+    uint8_t current;        // Funkprofil (mit dem Empfänger abgestimmt)
+    uint8_t previous;       // Profil vor dem Wechsel (Rückfall, wenn der PING scheitert)
+    uint8_t requested;      // Profil im laufenden Handshake
+    uint8_t currentChannel; // Kanal (mit dem Empfänger abgestimmt)
+    uint8_t previousChannel;
+    uint8_t requestedChannel;
+    RadioCommand requestCommand;  // CMD_RADIO_PROFILE oder CMD_CHANNEL
+    uint8_t paLevel;        // Sendeleistung des Senders (rf24_pa_dbm_e)
+    uint8_t retryDelay;     // ARD: (retryDelay + 1) * 250µs
+    uint8_t retryCount;     // ARC: maximale Retries
+
+    Phase phase;
+    bool probePending;      // PING im neuen Profil noch einzureihen?
+
+    // Statistik des laufenden Fensters
+    uint8_t packets;        // Übertragungen
+    uint8_t failures;       // Davon ohne ACK
+    uint16_t retries;       // Summe der Retries (bestätigte Übertragungen)
+    uint8_t maxRetries;     // Meiste Retries einer bestätigten Übertragung
+    uint32_t rttSum;        // Summe der Dauer bis zur Rückmeldung (Ticks, bestätigte)
+    uint8_t consecutiveFails;
+
+    // Sperre für Effizienz-Schritte nach einem Rückschritt
+    uint8_t holdWindows;    // Aktuelle Sperrdauer (verdoppelt sich bei jedem Rückschritt)
+    uint8_t holdLeft;       // Verbleibende gesperrte Fenster
+    bool lastStepEfficient; // War der letzte Schritt ein Effizienz-Schritt?
+    bool logNextWindow;     // Nächstes Fenster protokollieren ("nach dem Wechsel")
+
+    // Kanalwahl
+    uint8_t remoteLevels[ChannelScan::CANDIDATES / 2];  // Belegung beim Empfänger (2 Kandidaten pro Byte)
+    uint16_t remoteMask;    // Kandidaten mit Meldung vom Empfänger
+    uint16_t avoidMask;     // Kandidaten, die gestört waren oder nicht bestätigt wurden
+    bool channelChosen;     // Kanal nach Start/Rückfall schon gewählt?
+    uint8_t migrateHoldLeft;  // Fenster bis zum nächsten möglichen Kanalwechsel
+    uint32_t lastReportPing;  // Letzter PING für die Kanal-Messung (millis)
+
+    void evaluateWindow();
+    void requestProfile(uint8_t profile);
+    void requestChannel(uint8_t channel);
+    void startRequest(RadioCommand command);
+    void switchTo(uint8_t profile, uint8_t channel);
+    uint8_t bestCandidate(uint8_t exclude);
+    uint8_t remoteLevel(uint8_t index) const;
+    void fallbackToBase();
+    void backOff();
+    void applyLocal();
+    void resetWindow();
+    void logWindow(bool afterChange) const;
+
+    static void onRequestResult(void* context, const TxReport& report);
+    static void onProbeResult(void* context, const TxReport& report);
+};
@@ -0,0 +1,104 @@
+/**
+ * @file LinkQuality.cpp
+ * @brief Implementierung der Verbindungsqualitäts-Schätzung
+ */
+
+#include "LinkQuality.h"
+
+LinkQuality::LinkQuality() {
+    reset();
+}
+
+void LinkQuality::reset() {
+    samples = 0;
+    scoreQ8 = 0;
+    rttTicks = 0;
+    total = 0;
+    for (uint8_t i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = 0;
+    }
+}
+
+void LinkQuality::addReport(const TxReport& report) {
+    if (report.result == TX_SUPERSEDED) return;
+
+    // Erfolgsquote pro Versuch: 1 von (Retries + 1) Versuchen kam an
+    bool success = (report.result == TX_SUCCESS);
+    uint16_t sampleQ8 = success ? (uint16_t)((100U << 8) / (report.retries + 1)) : 0;
+
+    if (samples == 0) {
+        scoreQ8 = sampleQ8;
+    } else {
+        int32_t delta = (int32_t)sampleQ8 - (int32_t)scoreQ8;
+        scoreQ8 = (uint16_t)((int32_t)scoreQ8 + delta / (1 << RF::LINK_EWMA_SHIFT));
+    }
+
+    if (success) {
+        if (rttTicks == 0) {
+            rttTicks = report.rttTicks;
+        } else {
+            int32_t delta = (int32_t)report.rttTicks - (int32_t)rttTicks;
+            rttTicks = (uint16_t)((int32_t)rttTicks + delta / (1 << RF::LINK_EWMA_SHIFT));
+        }
+    }
+
+    // Histogramm: ältere Einträge verlieren durch Halbieren an Gewicht
+    if (total >= RF::LINK_HISTOGRAM_WINDOW) {
+        total = 0;
+        for (uint8_t i = 0; i < BUCKET_COUNT; i++) {
+            counts[i] /= 2;
+            total += counts[i];
+        }
+    }
+    counts[bucketOf(report)]++;
+    total++;
+
+    if (samples < 255) {
+        samples++;
+    }
+
+    #if DEBUG_ENABLED
+    if (samples % RF::LINK_HISTOGRAM_WINDOW == 0) {
+        DEBUG_PRINT(F("Link "));
+        DEBUG_PRINT(score());
+        DEBUG_PRINT(F("% RTT "));
+        DEBUG_PRINT(rttUs());
+        DEBUG_PRINT(F("us ARC"));
+        for (uint8_t i = 0; i < BUCKET_COUNT; i++) {
+            DEBUG_PRINT(F(" "));
+            DEBUG_PRINT(counts[i]);
+        }
+        DEBUG_PRINTLN();
+    }
+    #endif
+}
+
+uint8_t LinkQuality::score() const {
+    return (uint8_t)((scoreQ8 + 128) >> 8);
+}
+
+uint8_t LinkQuality::bars() const {
+    uint8_t percent = score();
+    if (percent >= 80) return 4;
+    if (percent >= 60) return 3;
+    if (percent >= 35) return 2;
+    if (percent >= 10) return 1;
+    return 0;
+}
+
+uint32_t LinkQuality::rttUs() const {
+    return (uint32_t)rttTicks * (1000000UL / Timebase::TICKS_PER_SECOND);
+}
+
+//=============================================================================
+// Private Hilfsfunktionen
+//=============================================================================
+
+LinkQuality::Bucket LinkQuality::bucketOf(const TxReport& report) {
+    if (report.result != TX_SUCCESS) return BUCKET_FAILED;
+    if (report.retries == 0) return BUCKET_ARC_0;
+    if (report.retries == 1) return BUCKET_ARC_1;
+    if (report.retries <= 3) return BUCKET_ARC_2_3;
+    if (report.retries <= 7) return BUCKET_ARC_4_7;
+    return BUCKET_ARC_8_15;
+}
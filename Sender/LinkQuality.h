@@ -0,0 +1,100 @@
+/**
+ * @file LinkQuality.h
+ * @brief Laufende Schätzung der Verbindungsqualität zum Empfänger
+ *
+ * Statt eines eigenen Tests mit 10 PINGs wird jede echte Übertragung
+ * ausgewertet (Kommandos, Beacons, PINGs bei Funkstille): ACK ja/nein,
+ * benötigte Retries (ARC) und Dauer bis zur Rückmeldung.
+ */
+
+#pragma once
+
+#include "Config.h"
+#include "TxQueue.h"
+
+/**
+ * @brief Gleitender Mittelwert (EWMA) der Erfolgsquote pro Sendeversuch
+ *
+ * Eine Übertragung mit n Retries entspricht einer Erfolgsquote von 1/(n+1)
+ * pro Versuch, eine fehlgeschlagene zählt 0. Jede Messung geht mit
+ * 1/2^RF::LINK_EWMA_SHIFT in die Qualität ein (Festkomma, kein float).
+ *
+ * Usage:
+ * @code
+ * // nach jeder Übertragung (TxQueue Complete-Hook):
+ * linkQuality.addReport(report);
+ *
+ * if (linkQuality.hasSamples()) showQuality(linkQuality.score());
+ * @endcode
+ */
+class LinkQuality {
+public:
+    /**
+     * @brief Histogramm-Klassen (Retries pro Übertragung)
+     */
+    enum Bucket : uint8_t {
+        BUCKET_ARC_0 = 0,   // Ohne Retry
+        BUCKET_ARC_1,       // 1 Retry
+        BUCKET_ARC_2_3,     // 2-3 Retries
+        BUCKET_ARC_4_7,     // 4-7 Retries
+        BUCKET_ARC_8_15,    // 8-15 Retries
+        BUCKET_FAILED,      // Kein ACK
+        BUCKET_COUNT
+    };
+
+    LinkQuality();
+
+    /**
+     * @brief Verwirft alle Messungen
+     */
+    void reset();
+
+    /**
+     * @brief Wertet eine Übertragung aus (TX_SUPERSEDED wird ignoriert)
+     * @param report Ergebnis aus der TxQueue
+     */
+    void addReport(const TxReport& report);
+
+    /**
+     * @brief Liegt mindestens eine Messung vor?
+     */
+    bool hasSamples() const { return samples > 0; }
+
+    /**
+     * @brief Anzahl Messungen (bleibt bei 255 stehen)
+     */
+    uint8_t sampleCount() const { return samples; }
+
+    /**
+     * @brief Verbindungsqualität
+     * @return Erfolgsquote pro Sendeversuch in Prozent (0-100)
+     */
+    uint8_t score() const;
+
+    /**
+     * @brief Qualität als Balken für das Empfangs-Icon
+     * @return 0 (keine Verbindung) bis 4
+     */
+    uint8_t bars() const;
+
+    /**
+     * @brief Geglättete Dauer vom Sendestart bis zur erkannten Rückmeldung
+     * @return Mikrosekunden (nur erfolgreiche Übertragungen)
+     */
+    uint32_t rttUs() const;
+
+    /**
+     * @brief Anzahl Übertragungen einer Histogramm-Klasse (jüngste haben mehr Gewicht)
+     * @param bucket Klasse
+     */
+    uint8_t histogram(Bucket bucket) const { return counts[bucket]; }
+
+private:
+    uint8_t samples;                // Anzahl Messungen
+    uint16_t scoreQ8;               // Qualität in Prozent, Q8 (100 << 8 = 100%)
+    uint16_t rttTicks;              // Geglättete Dauer bis zur Rückmeldung (Ticks)
+    uint8_t counts[BUCKET_COUNT];   // Histogramm der Retries
+    uint8_t total;                  // Summe aller Klassen
+
+    static Bucket bucketOf(const TxReport& report);
+};
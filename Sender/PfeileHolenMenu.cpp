@@ -4,10 +4,51 @@
  */
 
 #include "PfeileHolenMenu.h"
+#include "Images.h"
+
+namespace {
+    // Widget-Bereiche (x, y, Breite, Höhe) - umfassen alles, was das Widget zeichnet
+    constexpr ScreenRect TITLE_AREA   = { 10, 15, 144, 16 };   // "Pfeile holen": 12 Zeichen × 12px
+    constexpr ScreenRect RULE_AREA    = { 10, 45, 220, 1 };
+    constexpr ScreenRect STATUS_AREA  = { 0, 49, 240, 8 };     // Telemetrie-Zeile
+    constexpr ScreenRect BATTERY_AREA = { 173, 8, 34, 26 };    // Icon + "USB"/"7.2V"
+    constexpr ScreenRect LINK_AREA    = { 213, 8, 27, 24 };    // Icon + "100%"
+    constexpr ScreenRect BUTTON_AREA[3] = {
+        { 20, 60, 200, 40 },
+        { 20, 110, 200, 40 },
+        { 20, 160, 200, 40 }
+    };
+    constexpr ScreenRect GROUP_AREA   = { 10, 220, 156, 60 };  // 3 Zeilen, max. 13 Zeichen × 12px
+    constexpr ScreenRect HELP_AREA    = { 10, 300, 90, 20 };   // 2 Zeilen, 15 Zeichen × 6px
+
+    /**
+     * @brief Füllstand in Prozent aus der Batteriespannung
+     */
+    uint8_t batteryPercent(uint16_t voltageMillivolts) {
+        if (voltageMillivolts >= Battery::VOLTAGE_MAX_MV) return 100;
+        if (voltageMillivolts <= Battery::VOLTAGE_MIN_MV) return 0;
+        return ((uint32_t)(voltageMillivolts - Battery::VOLTAGE_MIN_MV) * 100) /
+               (Battery::VOLTAGE_MAX_MV - Battery::VOLTAGE_MIN_MV);
+    }
+
+    /**
+     * @brief Farbe des Füllbalkens
+     */
+    uint16_t batteryColor(uint8_t percent) {
+        if (percent > 50) return ST77XX_GREEN;
+        if (percent > 20) return ST77XX_YELLOW;
+        return ST77XX_RED;
+    }
 
-PfeileHolenMenu::PfeileHolenMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr)
+    constexpr uint8_t BATTERY_FILL_MAX = 12;  // Füllbalken bei 100% (Körper 16px - 2 × 2px Rand)
+    static_assert(Images::BATTERY_COLORS == BATTERY_FILL_MAX + 2, "Images::BATTERY: eine Palettenfarbe pro Füllspalte");
+    static_assert(Images::LINK_COLORS == 5, "Images::LINK: Hintergrund + 4 Balken");
+}
+
+PfeileHolenMenu::PfeileHolenMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr, RedrawManager& redrawMgr)
     : display(tft)
     , buttons(btnMgr)
+    , redraw(redrawMgr)
     , cursorPosition(0)
     , selectedAction(PfeileHolenAction::NONE)
     , needsUpdate(true)
@@ -15,19 +56,20 @@ PfeileHolenMenu::PfeileHolenMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr)
     , lastCursorPosition(0xFF)
     , connectionOk(false)
     , lastConnectionOk(false)
-    , pingHistoryIndex(0)
-    , pingHistoryUpdated(false)
+    , linkScore(0)
+    , linkBars(0)
+    , linkUpdated(false)
     , batteryVoltage(0)
     , isUsbPowered(true)
     , batteryUpdated(false)
+    , receiverStatus()
+    , receiverMismatch(false)
+    , receiverStatusValid(false)
+    , receiverStatusUpdated(false)
     , shooterCount(2)  // Default: 1-2 Schützen
     , currentGroup(Groups::Type::GROUP_AB)
     , currentPosition(Groups::Position::POS_1)
     , groupConfigChanged(false) {
-    // Ping-Historie mit false initialisieren (keine ACKs)
-    for (uint8_t i = 0; i < 4; i++) {
-        pingHistory[i] = false;
-    }
 }
 
 void PfeileHolenMenu::begin() {
@@ -39,18 +81,20 @@ void PfeileHolenMenu::begin() {
     connectionOk = false;
     lastConnectionOk = false;
 
-    // Ping-Historie zurücksetzen
-    pingHistoryIndex = 0;
-    pingHistoryUpdated = false;
-    for (uint8_t i = 0; i < 4; i++) {
-        pingHistory[i] = false;
-    }
+    // Verbindungsqualität zurücksetzen (kommt mit dem nächsten updateLinkQuality)
+    linkScore = 0;
+    linkBars = 0;
+    linkUpdated = false;
 
     // Batteriestatus zurücksetzen
     batteryVoltage = 0;
     isUsbPowered = true;
     batteryUpdated = false;
 
+    // Telemetrie zurücksetzen (Zeile bleibt leer bis zur ersten Meldung)
+    receiverStatusValid = false;
+    receiverStatusUpdated = false;
+
     // Gruppen-Konfiguration zurücksetzen
     groupConfigChanged = false;
 }
@@ -89,47 +133,48 @@ void PfeileHolenMenu::update() {
 }
 
 void PfeileHolenMenu::draw() {
-    // Beim ersten Aufruf: Komplettes Display zeichnen
     if (firstDraw) {
-        display.fillScreen(ST77XX_BLACK);
-        drawHeader();
-        drawOptions();
-        drawShooterGroupInfo();  // Schützengruppen-Info (nur bei 3-4 Schützen)
-        drawHelp();
-        drawBatteryIcon();       // Batteriestatus
-        drawConnectionIcon();    // Verbindungsstatus
-
+        // Neuer Screen: nur löschen, was der vorherige Screen gezeichnet hat
+        redraw.beginScreen();
         lastCursorPosition = cursorPosition;
-        lastConnectionOk = connectionOk;
         firstDraw = false;
     }
     else {
-        // Selective Redraw: Nur Optionen neu zeichnen wenn Cursor sich bewegt
+        // Selective Redraw: Nur geänderte Widgets invalidieren
+
+        // Cursor bewegt: alter und neuer Button
         if (cursorPosition != lastCursorPosition) {
-            drawOptions();
-            drawShooterGroupInfo();  // Schützengruppen-Info aktualisieren
+            redraw.invalidate(BUTTON_AREA[lastCursorPosition]);
+            redraw.invalidate(BUTTON_AREA[cursorPosition]);
             lastCursorPosition = cursorPosition;
         }
 
-        // Verbindungsstatus-Icon neu zeichnen wenn Ping-Historie aktualisiert wurde
-        if (pingHistoryUpdated) {
-            drawConnectionIcon();
-            pingHistoryUpdated = false;
-        }
-
-        // Batterie-Icon neu zeichnen wenn Status aktualisiert wurde
-        if (batteryUpdated) {
-            drawBatteryIcon();
-            batteryUpdated = false;
-        }
+        if (linkUpdated) redraw.invalidate(LINK_AREA);
+        if (batteryUpdated) redraw.invalidate(BATTERY_AREA);
+        if (groupConfigChanged) redraw.invalidate(GROUP_AREA);
+    }
 
-        // Schützengruppen-Info neu zeichnen wenn Konfiguration geändert wurde
-        if (groupConfigChanged) {
-            drawShooterGroupInfo();
-            groupConfigChanged = false;
-        }
+    redraw.clear();
+    if (redraw.needsPaint(TITLE_AREA)) drawHeader();
+    if (redraw.needsPaint(RULE_AREA)) {
+        display.drawFastHLine(RULE_AREA.x, RULE_AREA.y, RULE_AREA.w, Display::COLOR_GRAY);
+    }
+    if (redraw.needsPaint(BATTERY_AREA)) drawBatteryIcon();
+    if (redraw.needsPaint(LINK_AREA)) drawConnectionIcon();
+    // Telemetrie-Zeile deckend (überschreibt sich ohne Löschen)
+    if (receiverStatusValid && redraw.needsPaint(STATUS_AREA, receiverStatusUpdated)) drawReceiverStatus();
+    for (uint8_t i = 0; i < buttonCount(); i++) {
+        if (redraw.needsPaint(BUTTON_AREA[i])) drawButton(i);
     }
+    // Schützengruppen-Info nur bei 3-4 Schützen
+    if (shooterCount == 4 && redraw.needsPaint(GROUP_AREA)) drawShooterGroupInfo();
+    if (redraw.needsPaint(HELP_AREA)) drawHelp();
+    redraw.endFrame();
 
+    linkUpdated = false;
+    batteryUpdated = false;
+    receiverStatusUpdated = false;
+    groupConfigChanged = false;
     needsUpdate = false;
 }
 
@@ -141,138 +186,44 @@ void PfeileHolenMenu::drawHeader() {
     // Überschrift: "Pfeile holen" (linksbündig, damit Batterie-Icon nicht überdeckt)
     display.setTextSize(2);
     display.setTextColor(ST77XX_GREEN);
-    display.setCursor(10, 15);
+    display.setCursor(TITLE_AREA.x, TITLE_AREA.y);
     display.print(F("Pfeile holen"));
-
-    // Trennlinie
-    display.drawFastHLine(10, 45, display.width() - 20, Display::COLOR_GRAY);
 }
 
-void PfeileHolenMenu::drawOptions() {
+void PfeileHolenMenu::drawButton(uint8_t index) {
     // Portrait: Alle Buttons übereinander (volle Breite)
-    const uint16_t buttonY = 60;
-    const uint16_t buttonHeight = 40;
-    const uint16_t buttonSpacing = 10;
-    const uint16_t margin = 20;
-    const uint16_t buttonWidth = display.width() - 2 * margin;
+    // Bei 1-2 Schützen: Nächste Passe, Neustart
+    // Bei 3-4 Schützen: Nächste Passe, Abfolge, Neustart
+    const ScreenRect& area = BUTTON_AREA[index];
+    const __FlashStringHelper* label;
+    if (index == 0) {
+        label = F("Naechste Passe");
+    } else if (index == 1 && shooterCount == 4) {
+        label = F("Abfolge");
+    } else {
+        label = F("Neustart");
+    }
 
-    // Anzahl Buttons bestimmen
-    uint8_t numButtons = (shooterCount == 4) ? 3 : 2;
+    bool isSelected = (cursorPosition == index);
+    if (isSelected) {
+        display.fillRect(area.x, area.y, area.w, area.h, Display::COLOR_DARKGRAY);
+    }
 
-    // Bereich löschen
-    display.fillRect(0, buttonY, display.width(), numButtons * (buttonHeight + buttonSpacing) + 10, ST77XX_BLACK);
+    uint16_t frameColor = isSelected ? ST77XX_YELLOW : ST77XX_WHITE;
+    display.drawRect(area.x, area.y, area.w, area.h, frameColor);
 
     int16_t x1, y1;
     uint16_t w, h;
-
-    // =========================================================================
-    // Button 0: "Nächste Passe"
-    // =========================================================================
-    {
-        uint16_t btnY = buttonY;
-        bool isSelected = (cursorPosition == 0);
-
-        if (isSelected) {
-            display.fillRect(margin, btnY, buttonWidth, buttonHeight, Display::COLOR_DARKGRAY);
-        }
-
-        uint16_t frameColor = isSelected ? ST77XX_YELLOW : ST77XX_WHITE;
-        display.drawRect(margin, btnY, buttonWidth, buttonHeight, frameColor);
-
-        display.setTextSize(2);
-        display.getTextBounds("Naechste Passe", 0, 0, &x1, &y1, &w, &h);
-        uint16_t text_x = margin + (buttonWidth - w) / 2;
-        uint16_t text_y = btnY + (buttonHeight - h) / 2;
-        display.setCursor(text_x, text_y);
-        display.setTextColor(frameColor);
-        display.print("Naechste Passe");
-
-        if (isSelected) {
-            display.drawLine(text_x, text_y + h + 1, text_x + w, text_y + h + 1, frameColor);
-        }
-    }
-
-    if (shooterCount == 4) {
-        // =========================================================================
-        // Button 1: "Abfolge" (nur bei 3-4 Schützen)
-        // =========================================================================
-        {
-            uint16_t btnY = buttonY + buttonHeight + buttonSpacing;
-            bool isSelected = (cursorPosition == 1);
-
-            if (isSelected) {
-                display.fillRect(margin, btnY, buttonWidth, buttonHeight, Display::COLOR_DARKGRAY);
-            }
-
-            uint16_t frameColor = isSelected ? ST77XX_YELLOW : ST77XX_WHITE;
-            display.drawRect(margin, btnY, buttonWidth, buttonHeight, frameColor);
-
-            display.setTextSize(2);
-            display.getTextBounds("Abfolge", 0, 0, &x1, &y1, &w, &h);
-            uint16_t text_x = margin + (buttonWidth - w) / 2;
-            uint16_t text_y = btnY + (buttonHeight - h) / 2;
-            display.setCursor(text_x, text_y);
-            display.setTextColor(frameColor);
-            display.print("Abfolge");
-
-            if (isSelected) {
-                display.drawLine(text_x, text_y + h + 1, text_x + w, text_y + h + 1, frameColor);
-            }
-        }
-
-        // =========================================================================
-        // Button 2: "Neustart"
-        // =========================================================================
-        {
-            uint16_t btnY = buttonY + 2 * (buttonHeight + buttonSpacing);
-            bool isSelected = (cursorPosition == 2);
-
-            if (isSelected) {
-                display.fillRect(margin, btnY, buttonWidth, buttonHeight, Display::COLOR_DARKGRAY);
-            }
-
-            uint16_t frameColor = isSelected ? ST77XX_YELLOW : ST77XX_WHITE;
-            display.drawRect(margin, btnY, buttonWidth, buttonHeight, frameColor);
-
-            display.setTextSize(2);
-            display.getTextBounds("Neustart", 0, 0, &x1, &y1, &w, &h);
-            uint16_t text_x = margin + (buttonWidth - w) / 2;
-            uint16_t text_y = btnY + (buttonHeight - h) / 2;
-            display.setCursor(text_x, text_y);
-            display.setTextColor(frameColor);
-            display.print("Neustart");
-
-            if (isSelected) {
-                display.drawLine(text_x, text_y + h + 1, text_x + w, text_y + h + 1, frameColor);
-            }
-        }
-    } else {
-        // =========================================================================
-        // Button 1: "Neustart" (bei 1-2 Schützen)
-        // =========================================================================
-        {
-            uint16_t btnY = buttonY + buttonHeight + buttonSpacing;
-            bool isSelected = (cursorPosition == 1);
-
-            if (isSelected) {
-                display.fillRect(margin, btnY, buttonWidth, buttonHeight, Display::COLOR_DARKGRAY);
-            }
-
-            uint16_t frameColor = isSelected ? ST77XX_YELLOW : ST77XX_WHITE;
-            display.drawRect(margin, btnY, buttonWidth, buttonHeight, frameColor);
-
-            display.setTextSize(2);
-            display.getTextBounds("Neustart", 0, 0, &x1, &y1, &w, &h);
-            uint16_t text_x = margin + (buttonWidth - w) / 2;
-            uint16_t text_y = btnY + (buttonHeight - h) / 2;
-            display.setCursor(text_x, text_y);
-            display.setTextColor(frameColor);
-            display.print("Neustart");
-
-            if (isSelected) {
-                display.drawLine(text_x, text_y + h + 1, text_x + w, text_y + h + 1, frameColor);
-            }
-        }
+    display.setTextSize(2);
+    display.getTextBounds(label, 0, 0, &x1, &y1, &w, &h);
+    uint16_t text_x = area.x + (area.w - w) / 2;
+    uint16_t text_y = area.y + (area.h - h) / 2;
+    display.setCursor(text_x, text_y);
+    display.setTextColor(frameColor);
+    display.print(label);
+
+    if (isSelected) {
+        display.drawLine(text_x, text_y + h + 1, text_x + w, text_y + h + 1, frameColor);
     }
 }
 
@@ -280,9 +231,9 @@ void PfeileHolenMenu::drawHelp() {
     // Hilfetext unten (Portrait: mehr Platz)
     display.setTextSize(1);
     display.setTextColor(Display::COLOR_GRAY);
-    display.setCursor(10, display.height() - 20);
+    display.setCursor(HELP_AREA.x, HELP_AREA.y);
     display.print(F("L/R: Auswaehlen"));
-    display.setCursor(10, display.height() - 8);
+    display.setCursor(HELP_AREA.x, HELP_AREA.y + 12);
     display.print(F("OK: Bestaetigen"));
 }
 
@@ -290,114 +241,58 @@ void PfeileHolenMenu::drawConnectionIcon() {
     // Icon-Position: Rechts oben (WLAN-Balken Icon)
     const uint16_t iconX = display.width() - 25;
     const uint16_t iconY = 10;
-    const uint16_t iconWidth = 11;
     const uint16_t iconHeight = 10;
 
-    // Text-Position: Unter dem Icon
+    // Text-Position: Unter dem Icon ("100%" ist breiter als das Icon, LINK_AREA)
     const uint16_t textX = iconX;
     const uint16_t textY = iconY + iconHeight + 2;
 
-    // Bereich löschen (Icon + Text)
-    display.fillRect(iconX - 2, iconY - 2, iconWidth + 4, iconHeight + 14, ST77XX_BLACK);
-
-    // WLAN-Balken Icon zeichnen (4 Balken unterschiedlicher Höhe)
-    // Balken-Höhen: 2, 4, 6, 8 Pixel (von links nach rechts)
-    // Balken-Breite: 2px, Abstand: 1px
-    const uint8_t barWidth = 2;
-    const uint8_t barSpacing = 1;
-    const uint8_t barHeights[4] = {2, 4, 6, 8};
-
-    // Farben
-    uint16_t successColor = ST77XX_GREEN;      // Grün für erfolgreichen ACK
-    uint16_t failColor = Display::COLOR_GRAY;  // Grau für fehlgeschlagenen ACK
-
-    // Zeichne alle 4 Balken basierend auf Ping-Historie
-    for (uint8_t i = 0; i < 4; i++) {
-        uint16_t barX = iconX + i * (barWidth + barSpacing);
-        uint16_t barY = iconY + (iconHeight - barHeights[i]);
-        uint16_t barH = barHeights[i];
-
-        // Balken grün wenn ACK empfangen wurde, sonst grau
-        uint16_t barColor = pingHistory[i] ? successColor : failColor;
-        display.fillRect(barX, barY, barWidth, barH, barColor);
-    }
-
-    // Zähle erfolgreiche Pings für Text-Anzeige
-    uint8_t successfulPings = 0;
+    // WLAN-Balken Icon (Images::LINK, 4 Balken mit 2, 4, 6, 8 Pixel Höhe, unten bündig)
+    // Palette: Index 0 = Hintergrund, Index 1-4 = Balken 1-4
+    // Grün bis zur aktuellen Qualität, grau darüber - ein SPI-Burst für das ganze Icon
+    uint16_t palette[Images::LINK_COLORS];
+    palette[0] = ST77XX_BLACK;
     for (uint8_t i = 0; i < 4; i++) {
-        if (pingHistory[i]) successfulPings++;
+        palette[i + 1] = (i < linkBars) ? ST77XX_GREEN : Display::COLOR_GRAY;
     }
+    display.drawRLEImage(iconX, iconY + iconHeight - Images::LINK_HEIGHT, Images::LINK, palette);
 
-    // Text zeichnen: Anzahl erfolgreicher Pings von 4 (z.B. "3/4")
+    // Text zeichnen: Qualität in Prozent (z.B. "87%")
     display.setTextSize(1);
     display.setTextColor(Display::COLOR_GRAY);
     display.setCursor(textX, textY);
-    display.print(successfulPings);
-    display.print(F("/4"));
+    display.print(linkScore);
+    display.print(F("%"));
 }
 
 void PfeileHolenMenu::drawBatteryIcon() {
     // Icon-Position: Links vom Empfangs-Icon
     const uint16_t iconX = display.width() - 60;  // 35 Pixel links vom Empfangs-Icon
     const uint16_t iconY = 10;
-    const uint16_t iconWidth = 20;
     const uint16_t iconHeight = 10;
 
     // Text-Position: Unter dem Icon
     const uint16_t textX = iconX - 5;
     const uint16_t textY = iconY + iconHeight + 2;
 
-    // Bereich löschen (Icon + Text)
-    display.fillRect(iconX - 7, iconY - 2, iconWidth + 14, iconHeight + 16, ST77XX_BLACK);
-
-    // Batterie-Icon zeichnen
-    const uint16_t bodyWidth = 16;
-    const uint16_t bodyHeight = 8;
-    const uint16_t terminalWidth = 2;
-    const uint16_t terminalHeight = 4;
-
-    // Batterie-Rahmen (Körper)
-    uint16_t frameColor = ST77XX_WHITE;
-    display.drawRect(iconX, iconY, bodyWidth, bodyHeight, frameColor);
-
-    // Batterie-Terminal (Pluspol, rechts)
-    display.fillRect(iconX + bodyWidth, iconY + 2, terminalWidth, terminalHeight, frameColor);
-
-    // Füllstand berechnen und zeichnen
-    if (isUsbPowered) {
-        // USB-Modus: Volle Batterie (grün)
-        display.fillRect(iconX + 2, iconY + 2, bodyWidth - 4, bodyHeight - 4, ST77XX_GREEN);
-    } else {
-        // Batteriemodus: Füllstand basierend auf Spannung
-        // Prozentsatz berechnen
-        uint16_t percent = 0;
-        if (batteryVoltage >= Battery::VOLTAGE_MAX_MV) {
-            percent = 100;
-        } else if (batteryVoltage <= Battery::VOLTAGE_MIN_MV) {
-            percent = 0;
-        } else {
-            percent = ((batteryVoltage - Battery::VOLTAGE_MIN_MV) * 100) /
-                      (Battery::VOLTAGE_MAX_MV - Battery::VOLTAGE_MIN_MV);
-        }
-
-        // Füllbalken-Breite berechnen
-        uint16_t fillWidth = ((bodyWidth - 4) * percent) / 100;
-
-        // Farbe basierend auf Füllstand
-        uint16_t fillColor;
-        if (percent > 50) {
-            fillColor = ST77XX_GREEN;
-        } else if (percent > 20) {
-            fillColor = ST77XX_YELLOW;
-        } else {
-            fillColor = ST77XX_RED;
-        }
+    // Füllstand: USB-Modus volle Batterie (grün), sonst aus der Spannung
+    uint8_t fillWidth = BATTERY_FILL_MAX;
+    uint16_t fillColor = ST77XX_GREEN;
+    if (!isUsbPowered) {
+        uint8_t percent = batteryPercent(batteryVoltage);
+        fillWidth = (BATTERY_FILL_MAX * percent) / 100;
+        fillColor = batteryColor(percent);
+    }
 
-        // Füllbalken zeichnen
-        if (fillWidth > 0) {
-            display.fillRect(iconX + 2, iconY + 2, fillWidth, bodyHeight - 4, fillColor);
-        }
+    // Batterie-Icon (Images::BATTERY: Körper 16×8 mit Pluspol rechts)
+    // Palette: Index 0 = Hintergrund, 1 = Rahmen, 2-13 = Spalten des Füllbalkens
+    uint16_t palette[Images::BATTERY_COLORS];
+    palette[0] = ST77XX_BLACK;
+    palette[1] = ST77XX_WHITE;
+    for (uint8_t i = 0; i < BATTERY_FILL_MAX; i++) {
+        palette[i + 2] = (i < fillWidth) ? fillColor : ST77XX_BLACK;
     }
+    display.drawRLEImage(iconX, iconY, Images::BATTERY, palette);
 
     // Text zeichnen: "USB" oder Spannung
     display.setTextSize(1);
@@ -415,29 +310,92 @@ void PfeileHolenMenu::drawBatteryIcon() {
     }
 }
 
-void PfeileHolenMenu::updateConnectionStatus(bool isConnected) {
-    // Neues Ping-Ergebnis im Ring-Buffer speichern
-    pingHistory[pingHistoryIndex] = isConnected;
-    pingHistoryIndex = (pingHistoryIndex + 1) % 4;  // Nächster Index (0-3 mit Wrapping)
+void PfeileHolenMenu::drawReceiverStatus() {
+    // Eine Zeile zwischen Trennlinie (y=45) und erstem Button (y=60)
+    // Deckend (Hintergrund schwarz), der Rest der Zeile wird danach gelöscht
+    display.setTextSize(1);
+    display.setCursor(10, STATUS_AREA.y);
+
+    // Zustand: "OK" oder "ABW" (Empfänger zeigt etwas anderes als gesendet)
+    if (receiverMismatch) {
+        display.setTextColor(ST77XX_RED, ST77XX_BLACK);
+        display.print(F("ABW"));
+    } else {
+        display.setTextColor(ST77XX_GREEN, ST77XX_BLACK);
+        display.print(F("OK"));
+    }
+
+    // Zähler und Maxima (z.B. "RX 120 CRC 0 OV 0 L 5ms I 704us")
+    display.setTextColor(Display::COLOR_GRAY, ST77XX_BLACK);
+    display.print(F(" RX "));
+    display.print(receiverStatus.rxPackets);
+    display.print(F(" CRC "));
+    display.print(receiverStatus.badCrc);
+    display.print(F(" OV "));
+    display.print(receiverStatus.fifoOverflows);
+    display.print(F(" L "));
+    display.print(receiverStatus.maxLoopUs / 1000);
+    display.print(F("ms I "));
+    display.print(receiverStatus.maxIrqOffUs);
+    display.print(F("us"));
+
+    // Rest einer vorher längeren Zeile löschen
+    int16_t end = display.getCursorX();
+    if (display.getCursorY() == STATUS_AREA.y && end < STATUS_AREA.x + STATUS_AREA.w) {
+        display.fillRect(end, STATUS_AREA.y, STATUS_AREA.x + STATUS_AREA.w - end, STATUS_AREA.h, ST77XX_BLACK);
+    }
+}
+
+void PfeileHolenMenu::updateLinkQuality(uint8_t score, uint8_t bars) {
+    // Nur bei Änderung neu zeichnen (Aufruf jede Sekunde)
+    if (score == linkScore && bars == linkBars) return;
 
-    // connectionOk Status aktualisieren (aktuellstes Ping-Ergebnis)
-    connectionOk = isConnected;
+    linkScore = score;
+    linkBars = bars;
+    connectionOk = (bars > 0);
 
     // Flags setzen für Neuzeichnung
-    pingHistoryUpdated = true;
+    linkUpdated = true;
     needsUpdate = true;
 }
 
 void PfeileHolenMenu::updateBatteryStatus(uint16_t voltageMillivolts, bool usbPowered) {
+    // Nur bei sichtbarer Änderung neu zeichnen (Aufruf alle 5 Sekunden):
+    // USB/Batterie, angezeigte Zehntel-Volt, Breite oder Farbe des Füllbalkens
+    uint8_t oldPercent = batteryPercent(batteryVoltage);
+    uint8_t newPercent = batteryPercent(voltageMillivolts);
+    bool changed = (usbPowered != isUsbPowered) ||
+                   (!usbPowered &&
+                    (voltageMillivolts / 100 != batteryVoltage / 100 ||
+                     (BATTERY_FILL_MAX * newPercent) / 100 != (BATTERY_FILL_MAX * oldPercent) / 100 ||
+                     batteryColor(newPercent) != batteryColor(oldPercent)));
+
     batteryVoltage = voltageMillivolts;
     isUsbPowered = usbPowered;
-    batteryUpdated = true;
+
+    if (changed) {
+        batteryUpdated = true;
+        needsUpdate = true;
+    }
+}
+
+void PfeileHolenMenu::updateReceiverStatus(const ReceiverStatus& status, bool mismatch) {
+    receiverStatus = status;
+    receiverMismatch = mismatch;
+    receiverStatusValid = true;
+    receiverStatusUpdated = true;
     needsUpdate = true;
 }
 
 void PfeileHolenMenu::setTournamentConfig(uint8_t shooters, Groups::Type group, Groups::Position position) {
     // Prüfe ob sich Gruppe oder Position geändert hat
-    bool changed = (currentGroup != group) || (currentPosition != position) || (shooterCount != shooters);
+    bool changed = (currentGroup != group) || (currentPosition != position);
+
+    // Andere Schützenanzahl: andere Buttons, alles neu zeichnen
+    if (shooterCount != shooters) {
+        firstDraw = true;
+        changed = true;
+    }
 
     shooterCount = shooters;
     currentGroup = group;
@@ -450,17 +408,11 @@ void PfeileHolenMenu::setTournamentConfig(uint8_t shooters, Groups::Type group,
 }
 
 void PfeileHolenMenu::drawShooterGroupInfo() {
-    // Nur bei 3-4 Schützen anzeigen
-    if (shooterCount != 4) return;
-
     // Portrait: Position unter den 3 Buttons (60 + 3*50 = 210)
-    const uint16_t infoY = 220;
-    const uint16_t infoX = 10;
+    const uint16_t infoY = GROUP_AREA.y;
+    const uint16_t infoX = GROUP_AREA.x;
     const uint16_t lineHeight = 22;
 
-    // Bereich löschen
-    display.fillRect(0, infoY, display.width(), 70, ST77XX_BLACK);
-
     // Zeile 1: "Nächste: A/B" oder "Nächste: C/D"
     display.setCursor(infoX, infoY);
     display.setTextSize(2);
@@ -13,6 +13,8 @@
 #include <Adafruit_ST7789.h>
 #include "Config.h"
 #include "ButtonManager.h"
+#include "RedrawManager.h"
+#include "Commands.h"
 
 /**
  * @brief Aktionen die im Pfeile-Holen-Menü gewählt werden können
@@ -51,8 +53,9 @@ public:
      * @brief Konstruktor
      * @param tft Display-Referenz
      * @param btnMgr ButtonManager-Referenz
+     * @param redrawMgr Gemeinsame Invalidierung aller Screens
      */
-    PfeileHolenMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr);
+    PfeileHolenMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr, RedrawManager& redrawMgr);
 
     /**
      * @brief Initialisiert das Menü
@@ -65,7 +68,7 @@ public:
     void update();
 
     /**
-     * @brief Zeichnet das komplette Menü
+     * @brief Zeichnet das Menü (beim ersten Aufruf komplett, danach nur geänderte Widgets)
      */
     void draw();
 
@@ -87,10 +90,11 @@ public:
     void resetAction() { selectedAction = PfeileHolenAction::NONE; }
 
     /**
-     * @brief Aktualisiert den Verbindungsstatus zum Empfänger
-     * @param isConnected true wenn Empfänger erreichbar, false sonst
+     * @brief Aktualisiert die Verbindungsqualität zum Empfänger
+     * @param score Erfolgsquote pro Sendeversuch in Prozent (0-100)
+     * @param bars Balken im Empfangs-Icon (0 = keine Verbindung bis 4)
      */
-    void updateConnectionStatus(bool isConnected);
+    void updateLinkQuality(uint8_t score, uint8_t bars);
 
     /**
      * @brief Aktualisiert den Batteriestatus
@@ -99,6 +103,13 @@ public:
      */
     void updateBatteryStatus(uint16_t voltageMillivolts, bool usbPowered);
 
+    /**
+     * @brief Aktualisiert die Telemetrie des Empfängers (Statuszeile unter der Überschrift)
+     * @param status Zustand und Diagnosezähler aus der ACK-Payload
+     * @param mismatch true wenn der Empfänger vom gesendeten Zustand abweicht
+     */
+    void updateReceiverStatus(const ReceiverStatus& status, bool mismatch);
+
     /**
      * @brief Setzt die Turnierkonfiguration
      * @param shooters Anzahl Schützen (2 oder 4)
@@ -110,6 +121,7 @@ public:
 private:
     Adafruit_ST7789& display;
     ButtonManager& buttons;
+    RedrawManager& redraw;
 
     // UI-State
     uint8_t cursorPosition;   // 0 = Nächste Passe, 1 = Reihenfolge, 2 = Neustart
@@ -126,16 +138,22 @@ private:
     bool connectionOk;
     bool lastConnectionOk;
 
-    // Ping-Historie für Empfangsstärke-Anzeige (letzte 4 Pings)
-    bool pingHistory[4];      // true = ACK empfangen, false = kein ACK
-    uint8_t pingHistoryIndex; // Ring-Buffer Index (0-3)
-    bool pingHistoryUpdated;  // Flag: Ping-Historie wurde aktualisiert
+    // Verbindungsqualität für Empfangsstärke-Anzeige (LinkQuality)
+    uint8_t linkScore;        // Erfolgsquote pro Sendeversuch in Prozent
+    uint8_t linkBars;         // Grüne Balken (0-4)
+    bool linkUpdated;         // Flag: Verbindungsqualität wurde aktualisiert
 
     // Batteriestatus
     uint16_t batteryVoltage;  // Spannung in Millivolt
     bool isUsbPowered;        // true wenn USB, false wenn Batterie
     bool batteryUpdated;      // Flag: Batteriestatus wurde aktualisiert
 
+    // Telemetrie des Empfängers
+    ReceiverStatus receiverStatus;  // Zuletzt gemeldeter Zustand
+    bool receiverMismatch;          // Abweichung vom gesendeten Zustand?
+    bool receiverStatusValid;       // Schon eine Meldung empfangen?
+    bool receiverStatusUpdated;     // Flag: Telemetrie wurde aktualisiert
+
     // Turnierkonfiguration
     uint8_t shooterCount;           // 2 (1-2 Schützen) oder 4 (3-4 Schützen)
     Groups::Type currentGroup;      // Aktuelle Gruppe (GROUP_AB oder GROUP_CD)
@@ -144,9 +162,11 @@ private:
 
     // Hilfsfunktionen für selective drawing
     void drawHeader();
-    void drawOptions();
+    void drawButton(uint8_t index);
     void drawHelp();
     void drawConnectionIcon();
     void drawBatteryIcon();       // Zeigt Batteriestatus
+    void drawReceiverStatus();    // Zeigt Telemetrie des Empfängers
     void drawShooterGroupInfo();  // Zeigt Schützengruppen bei 3-4 Schützen
+    uint8_t buttonCount() const { return (shooterCount == 4) ? 3 : 2; }
 };
@@ -0,0 +1,137 @@
+/**
+ * @file RedrawManager.cpp
+ * @brief Implementierung der Bereichs-Invalidierung
+ */
+
+#include "RedrawManager.h"
+
+namespace {
+    int32_t area(const ScreenRect& r) {
+        return (int32_t)r.w * r.h;
+    }
+
+    ScreenRect unite(const ScreenRect& a, const ScreenRect& b) {
+        int16_t x0 = min(a.x, b.x);
+        int16_t y0 = min(a.y, b.y);
+        int16_t x1 = max(a.x + a.w, b.x + b.w);
+        int16_t y1 = max(a.y + a.h, b.y + b.h);
+        return { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+    }
+}
+
+RedrawManager::RedrawManager(Adafruit_ST7789& tft)
+    : display(tft)
+    , dirtyCount(0)
+    , paintedCount(1)
+    , fullPaint(false) {
+    // Display-RAM nach init() undefiniert: der erste Screen löscht alles
+    painted[0] = { 0, 0, (int16_t)Display::WIDTH, (int16_t)Display::HEIGHT };
+}
+
+void RedrawManager::beginScreen() {
+    fullPaint = true;
+    dirtyCount = 0;
+}
+
+void RedrawManager::invalidate(ScreenRect rect) {
+    add(dirty, dirtyCount, MAX_DIRTY, rect);
+}
+
+void RedrawManager::clear() {
+    display.resetByteCount();
+
+    if (fullPaint) {
+        // Alles vom vorherigen Screen löschen
+        for (uint8_t i = 0; i < paintedCount; i++) {
+            display.fillRect(painted[i].x, painted[i].y, painted[i].w, painted[i].h, ST77XX_BLACK);
+        }
+        paintedCount = 0;
+    }
+
+    for (uint8_t i = 0; i < dirtyCount; i++) {
+        display.fillRect(dirty[i].x, dirty[i].y, dirty[i].w, dirty[i].h, ST77XX_BLACK);
+    }
+}
+
+bool RedrawManager::needsPaint(ScreenRect rect) {
+    bool paint = fullPaint;
+    for (uint8_t i = 0; i < dirtyCount && !paint; i++) {
+        paint = intersects(dirty[i], rect);
+    }
+
+    if (paint) {
+        markPainted(rect);
+    }
+    return paint;
+}
+
+bool RedrawManager::needsPaint(ScreenRect rect, bool changed) {
+    if (changed) {
+        markPainted(rect);
+        return true;
+    }
+    return needsPaint(rect);
+}
+
+void RedrawManager::markPainted(ScreenRect rect) {
+    add(painted, paintedCount, MAX_PAINTED, rect);
+}
+
+void RedrawManager::endFrame() {
+    dirtyCount = 0;
+    fullPaint = false;
+
+    // Nur mit Compiler-Flag -DSPITFT_COUNT_BYTES (Benchmark-/Debug-Build)
+    #if defined(SPITFT_COUNT_BYTES)
+    DEBUG_PRINT(F("Display: "));
+    DEBUG_PRINT(display.getByteCount());
+    DEBUG_PRINTLN(F(" Bytes"));
+    #endif
+}
+
+//=============================================================================
+// Private Hilfsfunktionen
+//=============================================================================
+
+void RedrawManager::add(ScreenRect* list, uint8_t& count, uint8_t capacity, ScreenRect rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+
+    for (;;) {
+        // Zusammenfassen, wenn das gemeinsame Rechteck keine zusätzlichen Pixel hat
+        // (enthalten, überlappend oder bündig) - danach erneut gegen alle prüfen
+        bool merged = false;
+        for (uint8_t i = 0; i < count; i++) {
+            ScreenRect united = unite(list[i], rect);
+            if (area(united) <= area(list[i]) + area(rect)) {
+                rect = united;
+                list[i] = list[--count];
+                merged = true;
+                break;
+            }
+        }
+        if (merged) continue;
+
+        if (count < capacity) {
+            list[count++] = rect;
+            return;
+        }
+
+        // Liste voll: mit dem Bereich zusammenfassen, der am wenigsten zusätzliche Pixel bringt
+        uint8_t best = 0;
+        int32_t bestWaste = INT32_MAX;
+        for (uint8_t i = 0; i < count; i++) {
+            int32_t waste = area(unite(list[i], rect)) - area(list[i]) - area(rect);
+            if (waste < bestWaste) {
+                bestWaste = waste;
+                best = i;
+            }
+        }
+        rect = unite(list[best], rect);
+        list[best] = list[--count];
+    }
+}
+
+bool RedrawManager::intersects(const ScreenRect& a, const ScreenRect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w &&
+           a.y < b.y + b.h && b.y < a.y + a.h;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file RedrawManager.h
+ * @brief Ungültige Bildschirmbereiche sammeln, zusammenfassen und gezielt löschen
+ *
+ * fillScreen() schickt 153.600 Bytes über SPI (240×320 Pixel × 2 Bytes), ein
+ * Textwechsel mit großflächigem fillRect() leicht 50 KB. Die Screens melden
+ * stattdessen nur die Bereiche ihrer Widgets, die sich wirklich geändert
+ * haben. Beim Screen-Wechsel wird nur gelöscht, was der vorherige Screen
+ * tatsächlich gezeichnet hat.
+ */
+
+#pragma once
+
+#include <Adafruit_ST7789.h>
+#include "Config.h"
+
+/**
+ * @brief Rechteck auf dem Display (Pixel)
+ */
+struct ScreenRect {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
+/**
+ * @brief Gemeinsame Invalidierung für alle Screens (eine Instanz in der StateMachine)
+ *
+ * Ablauf pro Frame (in draw()):
+ * 1. beginScreen() beim Betreten eines Screens, sonst invalidate() für jedes
+ *    geänderte Widget
+ * 2. clear(): löscht die ungültigen Bereiche (ein fillRect() pro Bereich)
+ * 3. needsPaint() pro Widget: true, wenn der Screen neu ist oder clear() das
+ *    Widget getroffen hat - das Widget zeichnet sich dann vollständig neu
+ * 4. endFrame()
+ *
+ * Überlappende oder aneinandergrenzende Bereiche werden zusammengefasst, wenn
+ * das gemeinsame Rechteck nicht mehr Pixel hat als beide einzeln. Ist eine
+ * Liste voll, wird mit dem Bereich zusammengefasst, der am wenigsten wächst.
+ *
+ * Zusätzlich merkt sich der RedrawManager alle gezeichneten Bereiche des
+ * aktuellen Screens. clear() nach beginScreen() löscht genau diese, statt
+ * fillScreen(). Nach dem Start gilt das ganze Display als belegt (der
+ * Display-RAM ist nach init() undefiniert).
+ *
+ * Die Widget-Rechtecke sind Layout-Konstanten der Screens und müssen alles
+ * umfassen, was das Widget zeichnet.
+ *
+ * Deckend gezeichnete Widgets (Text mit Hintergrundfarbe, gleiche Länge)
+ * überschreiben ihren Bereich selbst: statt invalidate() meldet
+ * needsPaint(rect, true) die Änderung, gelöscht wird nichts.
+ *
+ * Usage:
+ * @code
+ * void Menu::draw() {
+ *     if (firstDraw) redraw.beginScreen();
+ *     else if (valueChanged) redraw.invalidate(VALUE_AREA);
+ *
+ *     redraw.clear();
+ *     if (redraw.needsPaint(VALUE_AREA)) drawValue();
+ *     redraw.endFrame();
+ * }
+ * @endcode
+ */
+class RedrawManager {
+public:
+    static constexpr uint8_t MAX_DIRTY = 4;     // Ungültige Bereiche pro Frame
+    static constexpr uint8_t MAX_PAINTED = 8;   // Gezeichnete Bereiche pro Screen
+
+    explicit RedrawManager(Adafruit_ST7789& tft);
+
+    /**
+     * @brief Neuer Screen: clear() löscht alles, was der vorherige gezeichnet hat
+     *
+     * Bis endFrame() liefert needsPaint() immer true.
+     */
+    void beginScreen();
+
+    /**
+     * @brief Markiert einen Bereich als ungültig (wird von clear() gelöscht)
+     * @param rect Bereich eines geänderten Widgets
+     */
+    void invalidate(ScreenRect rect);
+
+    /**
+     * @brief Löscht alle ungültigen Bereiche (schwarz) und setzt den Byte-Zähler zurück
+     */
+    void clear();
+
+    /**
+     * @brief Muss ein Widget in diesem Frame gezeichnet werden?
+     *
+     * Bei true wird der Bereich als gezeichnet gemerkt.
+     *
+     * @param rect Bereich des Widgets
+     * @return true bei neuem Screen oder wenn clear() den Bereich getroffen hat
+     */
+    bool needsPaint(ScreenRect rect);
+
+    /**
+     * @brief Wie needsPaint(), für deckend gezeichnete Widgets
+     * @param rect Bereich des Widgets
+     * @param changed Inhalt geändert (Widget überschreibt sich ohne Löschen)
+     * @return true wenn changed oder needsPaint(rect)
+     */
+    bool needsPaint(ScreenRect rect, bool changed);
+
+    /**
+     * @brief Merkt einen Bereich als gezeichnet (Screens, die selbst löschen, z.B. Splash)
+     * @param rect Gezeichneter Bereich
+     */
+    void markPainted(ScreenRect rect);
+
+    /**
+     * @brief Schließt den Frame ab (Debug: über SPI gesendete Bytes)
+     */
+    void endFrame();
+
+private:
+    Adafruit_ST7789& display;
+
+    ScreenRect dirty[MAX_DIRTY];
+    uint8_t dirtyCount;
+    ScreenRect painted[MAX_PAINTED];
+    uint8_t paintedCount;
+    bool fullPaint;         // Neuer Screen: alles zeichnen
+
+    static void add(ScreenRect* list, uint8_t& count, uint8_t capacity, ScreenRect rect);
+    static bool intersects(const ScreenRect& a, const ScreenRect& b);
+};
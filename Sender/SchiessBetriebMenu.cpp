@@ -4,10 +4,25 @@
  */
 
 #include "SchiessBetriebMenu.h"
+#include "TextMetrics.h"
+
+namespace {
+    // Widget-Bereiche (x, y, Breite, Höhe) - umfassen alles, was das Widget zeichnet
+    // (Phasentext: SchiessBetriebMenu::phaseArea(), hängt von der Schützenanzahl ab)
+    constexpr ScreenRect TITLE_AREA      = { 36, 15, 168, 16 };   // "Schiessbetrieb": 14 Zeichen × 12px
+    constexpr ScreenRect RULE_AREA       = { 10, 50, 220, 1 };
+    constexpr ScreenRect SEQUENCE_AREA   = { 10, 60, 144, 41 };   // 2 Zeilen "{A/B -> C/D}"
+    // (Countdown: SchiessBetriebMenu::countdownArea(), bei 3-4 Schützen links neben der Gruppe)
+    constexpr ScreenRect GROUP_AREA      = { 126, 151, 108, 48 }; // "A/B" in Größe 6: 3 Zeichen × 36px
+    constexpr ScreenRect END_BUTTON_AREA = { 20, 240, 200, 35 };
+    constexpr ScreenRect HELP_AREA       = { 10, 300, 102, 8 };   // 17 Zeichen × 6px
+}
 
-SchiessBetriebMenu::SchiessBetriebMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr)
+SchiessBetriebMenu::SchiessBetriebMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr, RedrawManager& redrawMgr)
     : display(tft)
     , buttons(btnMgr)
+    , redraw(redrawMgr)
+    , countdown(tft)
     , shootingTime(120)
     , shooterCount(2)
     , currentGroup(Groups::Type::GROUP_AB)
@@ -17,12 +32,16 @@ SchiessBetriebMenu::SchiessBetriebMenu(Adafruit_ST7789& tft, ButtonManager& btnM
     , lastRemainingSec(0xFFFF)
     , needsUpdate(true)
     , firstDraw(true)
+    , phaseChanged(false)
+    , groupChanged(false)
     , endRequested(false) {
 }
 
 void SchiessBetriebMenu::begin() {
     needsUpdate = true;
     firstDraw = true;
+    phaseChanged = false;
+    groupChanged = false;
     endRequested = false;
     lastRemainingSec = 0xFFFF;  // Force timer redraw
 }
@@ -35,77 +54,120 @@ void SchiessBetriebMenu::update() {
 }
 
 void SchiessBetriebMenu::draw() {
-    // Beim ersten Aufruf: Komplettes Display zeichnen
     if (firstDraw) {
-        display.fillScreen(ST77XX_BLACK);
-        drawHeader();
-        drawGroupSequence();
-        drawTimer();
-        drawEndButton();
-        drawHelp();
-
+        // Neuer Screen: nur löschen, was der vorherige Screen gezeichnet hat
+        redraw.beginScreen();
+        ScreenRect area = countdownArea();
+        countdown.reset(area.x, area.y);
         firstDraw = false;
     }
-    // Selective Redraw: Nur bei Phasenwechsel (Vorbereitung ↔ Schießbetrieb)
-    // Da wir keine Sekunden mehr anzeigen, kein Update bei jeder Sekunde nötig
-    else if (needsUpdate) {
-        updateTimer();
+
+    // Selective Redraw: Phasentext, Gruppensequenz und große Gruppe werden deckend
+    // gezeichnet (gleiche Textlänge) und überschreiben sich ohne Löschen
+    redraw.clear();
+    if (redraw.needsPaint(TITLE_AREA)) drawHeader();
+    if (redraw.needsPaint(RULE_AREA)) {
+        display.drawFastHLine(RULE_AREA.x, RULE_AREA.y, RULE_AREA.w, Display::COLOR_GRAY);
+    }
+    // Gruppensequenz und große Gruppe nur bei 3-4 Schützen
+    if (shooterCount == 4 && redraw.needsPaint(SEQUENCE_AREA, groupChanged)) drawGroupSequence();
+    if (redraw.needsPaint(phaseArea(), phaseChanged)) drawPhase();
+    // Countdown: zeichnet nur die Segmente, die sich gegenüber dem letzten Wert ändern
+    if (redraw.needsPaint(countdownArea(), remainingSec != lastRemainingSec || phaseChanged)) {
+        countdown.show(remainingSec, countdownColor());
+        lastRemainingSec = remainingSec;
     }
+    if (shooterCount == 4 && redraw.needsPaint(GROUP_AREA, groupChanged)) drawGroup();
+    if (redraw.needsPaint(END_BUTTON_AREA)) drawEndButton();
+    if (redraw.needsPaint(HELP_AREA)) drawHelp();
+    redraw.endFrame();
 
+    phaseChanged = false;
+    groupChanged = false;
     needsUpdate = false;
 }
 
 void SchiessBetriebMenu::setTournamentConfig(uint8_t shootingTime, uint8_t shooterCount,
                                              Groups::Type group, Groups::Position position) {
-    // Prüfe ob sich Gruppe/Position geändert hat (erfordert komplettes Neuzeichnen)
-    bool groupChanged = (this->currentGroup != group) || (this->currentPosition != position);
+    // Prüfe ob sich Gruppe/Position geändert hat
+    bool changed = (this->currentGroup != group) || (this->currentPosition != position);
+
+    // Andere Schützenanzahl: anderes Layout, alles neu zeichnen
+    if (this->shooterCount != shooterCount) {
+        firstDraw = true;
+        changed = true;
+    }
 
     this->shootingTime = shootingTime;
     this->shooterCount = shooterCount;
     this->currentGroup = group;
     this->currentPosition = position;
 
-    if (groupChanged) {
-        firstDraw = true;  // Komplettes Neuzeichnen
+    if (changed) {
+        groupChanged = true;
         needsUpdate = true;
     }
 }
 
 void SchiessBetriebMenu::setPreparationPhase(bool inPrep, uint32_t remainingMs) {
+    if (inPrep != this->inPreparationPhase) phaseChanged = true;
     this->inPreparationPhase = inPrep;
     this->remainingSec = (remainingMs + 999) / 1000;  // Aufrunden auf Sekunden
     needsUpdate = true;
 }
 
 void SchiessBetriebMenu::setShootingPhase(uint32_t remainingMs) {
+    if (this->inPreparationPhase) phaseChanged = true;
     this->inPreparationPhase = false;
     this->remainingSec = (remainingMs + 999) / 1000;  // Aufrunden auf Sekunden
     needsUpdate = true;
 }
 
+void SchiessBetriebMenu::setRemainingSeconds(uint16_t seconds) {
+    if (seconds == remainingSec) return;
+    remainingSec = seconds;
+    needsUpdate = true;
+}
+
 //=============================================================================
 // Private Hilfsfunktionen für Selective Drawing
 //=============================================================================
 
+ScreenRect SchiessBetriebMenu::phaseArea() const {
+    // Bei 3-4 Schützen: Nach Gruppensequenz (2 Zeilen bei Y=60 und Y=85)
+    // Breite: längster Text "Alles ins Gold" (14 Zeichen × 12px), zentriert
+    return { 36, (int16_t)((shooterCount == 4) ? 120 : 80), 168, 16 };
+}
+
+ScreenRect SchiessBetriebMenu::countdownArea() const {
+    // Bei 3-4 Schützen links neben der großen Gruppe, sonst zentriert unter der Phase
+    if (shooterCount == 4) {
+        return { 12, 145, SegmentDisplay::WIDTH, SegmentDisplay::HEIGHT };
+    }
+    return { (int16_t)((Display::WIDTH - SegmentDisplay::WIDTH) / 2), 115,
+             SegmentDisplay::WIDTH, SegmentDisplay::HEIGHT };
+}
+
+uint16_t SchiessBetriebMenu::countdownColor() const {
+    // Wie die große Anzeige: Vorbereitung rot, Schießen grün, letzte Sekunden orange, Ende rot
+    if (inPreparationPhase || remainingSec == 0) return ST77XX_RED;
+    if (remainingSec <= Timing::WARNING_TIME_S) return Display::COLOR_ORANGE;
+    return ST77XX_GREEN;
+}
+
 void SchiessBetriebMenu::drawHeader() {
     // Überschrift: "Schiessbetrieb" in Orange (Portrait: TextSize 2, zentriert)
     display.setTextSize(2);
     display.setTextColor(ST77XX_ORANGE);
-
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.getTextBounds(F("Schiessbetrieb"), 0, 0, &x1, &y1, &w, &h);
-    display.setCursor((display.width() - w) / 2, 15);
+    display.setCursor(TextMetrics::centerX("Schiessbetrieb", 2), TITLE_AREA.y);
     display.print(F("Schiessbetrieb"));
-
-    // Trennlinie
-    display.drawFastHLine(10, 50, display.width() - 20, Display::COLOR_GRAY);
 }
 
 void SchiessBetriebMenu::drawGroupSequence() {
     // Gruppensequenz anzeigen (nur bei 3-4 Schützen)
     if (shooterCount == 4) {
         // Portrait: Auf zwei Zeilen aufteilen für 240px Breite
+        // Deckend (Hintergrund schwarz): nur die Farben ändern sich, kein Löschen nötig
         display.setTextSize(2);
 
         // Bestimme welcher Teil gelb sein soll
@@ -116,92 +178,73 @@ void SchiessBetriebMenu::drawGroupSequence() {
 
         // Zeile 1: "{A/B -> C/D}"
         display.setCursor(10, 60);
-        display.setTextColor(Display::COLOR_GRAY);
+        display.setTextColor(Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F("{"));
-        display.setTextColor(highlightAB1 ? ST77XX_YELLOW : Display::COLOR_GRAY);
+        display.setTextColor(highlightAB1 ? ST77XX_YELLOW : Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F("A/B"));
-        display.setTextColor(Display::COLOR_GRAY);
+        display.setTextColor(Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F(" -> "));
-        display.setTextColor(highlightCD2 ? ST77XX_YELLOW : Display::COLOR_GRAY);
+        display.setTextColor(highlightCD2 ? ST77XX_YELLOW : Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F("C/D"));
-        display.setTextColor(Display::COLOR_GRAY);
+        display.setTextColor(Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F("}"));
 
         // Zeile 2: "{C/D -> A/B}"
         display.setCursor(10, 85);
-        display.setTextColor(Display::COLOR_GRAY);
+        display.setTextColor(Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F("{"));
-        display.setTextColor(highlightCD1 ? ST77XX_YELLOW : Display::COLOR_GRAY);
+        display.setTextColor(highlightCD1 ? ST77XX_YELLOW : Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F("C/D"));
-        display.setTextColor(Display::COLOR_GRAY);
+        display.setTextColor(Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F(" -> "));
-        display.setTextColor(highlightAB2 ? ST77XX_YELLOW : Display::COLOR_GRAY);
+        display.setTextColor(highlightAB2 ? ST77XX_YELLOW : Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F("A/B"));
-        display.setTextColor(Display::COLOR_GRAY);
+        display.setTextColor(Display::COLOR_GRAY, ST77XX_BLACK);
         display.print(F("}"));
     }
     // Bei 1-2 Schützen: Keine Gruppenanzeige
 }
 
-void SchiessBetriebMenu::drawTimer() {
-    // Phasentext statt Timer
-    const char* phaseText = inPreparationPhase ? "Vorbereitung" : "Alles ins Gold";
+void SchiessBetriebMenu::drawPhase() {
+    // Phasentext statt Timer - beide Texte 14 Zeichen lang (zentriert mit Leerzeichen),
+    // deckend gezeichnet überschreibt der neue Text den alten vollständig
+    const char* phaseText = inPreparationPhase ? " Vorbereitung " : "Alles ins Gold";
     uint16_t phaseColor = inPreparationPhase ? Display::COLOR_ORANGE : ST77XX_GREEN;
 
-    // Portrait: Positionen angepasst (mehr vertikaler Platz)
-    // Bei 3-4 Schützen: Nach Gruppensequenz (2 Zeilen bei Y=60 und Y=85)
-    uint16_t phaseY = (shooterCount == 4) ? 120 : 80;
-
+    ScreenRect area = phaseArea();
     display.setTextSize(2);
-    display.setTextColor(phaseColor);
-
-    // Text horizontal zentrieren
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.getTextBounds(phaseText, 0, 0, &x1, &y1, &w, &h);
-    uint16_t phaseX = (display.width() - w) / 2;
-
-    display.setCursor(phaseX, phaseY);
+    display.setTextColor(phaseColor, ST77XX_BLACK);
+    display.setCursor(area.x, area.y);
     display.print(phaseText);
+}
 
-    // Aktuelle Gruppe groß darunter anzeigen (nur bei 3-4 Schützen)
-    if (shooterCount == 4) {
-        const char* groupText = (currentGroup == Groups::Type::GROUP_AB) ? "A/B" : "C/D";
-
-        display.setTextSize(6);  // Sehr groß
-        display.setTextColor(ST77XX_YELLOW);
-
-        // Text zentrieren
-        display.getTextBounds(groupText, 0, 0, &x1, &y1, &w, &h);
-        uint16_t groupX = (display.width() - w) / 2;
-        uint16_t groupY = 155;  // Unterhalb der Phase (Portrait: mehr Platz)
+void SchiessBetriebMenu::drawGroup() {
+    // Aktuelle Gruppe groß rechts neben dem Countdown anzeigen (nur bei 3-4 Schützen)
+    const char* groupText = (currentGroup == Groups::Type::GROUP_AB) ? "A/B" : "C/D";
 
-        display.setCursor(groupX, groupY);
-        display.print(groupText);
-    }
+    // Deckend: "A/B" und "C/D" sind gleich breit, kein Löschen nötig
+    display.setTextSize(6);  // Sehr groß
+    display.setTextColor(ST77XX_YELLOW, ST77XX_BLACK);
+    display.setCursor(GROUP_AREA.x, GROUP_AREA.y);
+    display.print(groupText);
 }
 
 void SchiessBetriebMenu::drawEndButton() {
     // Button "Passe beenden" (Portrait: weiter unten, mehr Platz)
-    const uint16_t btnY = 240;
-    const uint16_t btnH = 35;
-    const uint16_t margin = 20;
-    uint16_t btnW = display.width() - 2 * margin;
+    const ScreenRect& area = END_BUTTON_AREA;
 
     // Grauer Hintergrund (wie bei anderen Buttons)
-    display.fillRect(margin, btnY, btnW, btnH, Display::COLOR_DARKGRAY);
+    display.fillRect(area.x, area.y, area.w, area.h, Display::COLOR_DARKGRAY);
 
     // Oranger Rahmen
-    display.drawRect(margin, btnY, btnW, btnH, Display::COLOR_ORANGE);
+    display.drawRect(area.x, area.y, area.w, area.h, Display::COLOR_ORANGE);
 
     display.setTextSize(2);
     display.setTextColor(Display::COLOR_ORANGE);
 
-    // Text zentrieren
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.getTextBounds("Passe beenden", 0, 0, &x1, &y1, &w, &h);
-    display.setCursor(margin + (btnW - w) / 2, btnY + (btnH - h) / 2);
+    // Text zentrieren (Position steht zur Compile-Zeit fest)
+    display.setCursor(TextMetrics::centerX("Passe beenden", 2, area.x, area.w),
+                      TextMetrics::centerY(2, area.y, area.h));
     display.print(F("Passe beenden"));
 }
 
@@ -209,47 +252,6 @@ void SchiessBetriebMenu::drawHelp() {
     // Hinweis unten (Portrait: mehr Platz)
     display.setTextSize(1);
     display.setTextColor(Display::COLOR_GRAY);
-    display.setCursor(10, display.height() - 20);
+    display.setCursor(HELP_AREA.x, HELP_AREA.y);
     display.print(F("OK: Passe beenden"));
 }
-
-void SchiessBetriebMenu::updateTimer() {
-    // Portrait: Positionen angepasst
-    const uint16_t phaseY = (shooterCount == 4) ? 120 : 80;
-
-    // Lösche gesamten Bereich (Phase + große Gruppe bei 3-4 Schützen)
-    const uint16_t clearHeight = (shooterCount == 4) ? 100 : 25;
-    display.fillRect(0, phaseY, display.width(), clearHeight, ST77XX_BLACK);
-
-    // Phasentext und -farbe
-    const char* phaseText = inPreparationPhase ? "Vorbereitung" : "Alle ins Gold";
-    uint16_t phaseColor = inPreparationPhase ? Display::COLOR_ORANGE : ST77XX_GREEN;
-
-    // Text horizontal zentrieren
-    display.setTextSize(2);
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.getTextBounds(phaseText, 0, 0, &x1, &y1, &w, &h);
-    uint16_t phaseX = (display.width() - w) / 2;
-
-    // Phasentext neu zeichnen
-    display.setTextColor(phaseColor);
-    display.setCursor(phaseX, phaseY);
-    display.print(phaseText);
-
-    // Aktuelle Gruppe groß darunter anzeigen (nur bei 3-4 Schützen)
-    if (shooterCount == 4) {
-        const char* groupText = (currentGroup == Groups::Type::GROUP_AB) ? "A/B" : "C/D";
-
-        display.setTextSize(6);  // Sehr groß
-        display.setTextColor(ST77XX_YELLOW);
-
-        // Text zentrieren
-        display.getTextBounds(groupText, 0, 0, &x1, &y1, &w, &h);
-        uint16_t groupX = (display.width() - w) / 2;
-        uint16_t groupY = 155;  // Unterhalb der Phase (Portrait)
-
-        display.setCursor(groupX, groupY);
-        display.print(groupText);
-    }
-}
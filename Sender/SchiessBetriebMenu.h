@@ -3,8 +3,8 @@
  * @brief Menü für "Schießbetrieb" State
  *
  * Zeigt Schießbetrieb-UI mit:
- * - Vorbereitungsphase (10s, orange Countdown)
- * - Schießphase (120/240s, grüner Countdown)
+ * - Vorbereitungsphase (10s, roter Countdown)
+ * - Schießphase (120/240s, grüner Countdown, orange in den letzten 30s)
  * - Gruppensequenz-Anzeige (bei 3-4 Schützen)
  * - "Passe beenden" Button
  */
@@ -14,13 +14,16 @@
 #include <Adafruit_ST7789.h>
 #include "Config.h"
 #include "ButtonManager.h"
+#include "RedrawManager.h"
+#include "SegmentDisplay.h"
 
 /**
  * @brief Menü für Schießbetrieb (aktive Schießphase)
  *
  * Verwaltet die UI-Logik für den Schießbetrieb-State mit:
- * - Vorbereitungsphase (10s, orange)
- * - Schießphase (120/240s, grün)
+ * - Vorbereitungsphase (10s, rot)
+ * - Schießphase (120/240s, grün, dann orange)
+ * - Restzeit als große Sieben-Segment-Ziffern (Farben wie der Empfänger)
  * - Gruppenanzeige bei 3-4 Schützen
  * - Button "Passe beenden"
  *
@@ -31,6 +34,7 @@
  * schiessBetriebMenu.setPreparationPhase(true, 10000);
  *
  * // In loop():
+ * schiessBetriebMenu.setRemainingSeconds(seconds);
  * schiessBetriebMenu.update();
  * if (schiessBetriebMenu.needsRedraw()) {
  *     schiessBetriebMenu.draw();
@@ -47,8 +51,9 @@ public:
      * @brief Konstruktor
      * @param tft Display-Referenz
      * @param btnMgr ButtonManager-Referenz
+     * @param redrawMgr Gemeinsame Invalidierung aller Screens
      */
-    SchiessBetriebMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr);
+    SchiessBetriebMenu(Adafruit_ST7789& tft, ButtonManager& btnMgr, RedrawManager& redrawMgr);
 
     /**
      * @brief Initialisiert das Menü
@@ -61,7 +66,7 @@ public:
     void update();
 
     /**
-     * @brief Zeichnet das komplette Menü
+     * @brief Zeichnet das Menü (beim ersten Aufruf komplett, danach nur geänderte Widgets)
      */
     void draw();
 
@@ -94,6 +99,16 @@ public:
      */
     void setShootingPhase(uint32_t remainingMs);
 
+    /**
+     * @brief Setzt die angezeigte Restzeit der aktuellen Phase
+     *
+     * Darf in jedem loop() aufgerufen werden, neu gezeichnet wird nur bei
+     * einem anderen Wert (nur die geänderten Segmente).
+     *
+     * @param seconds Aufgerundete Restsekunden (wie auf der großen Anzeige)
+     */
+    void setRemainingSeconds(uint16_t seconds);
+
     /**
      * @brief Prüft ob "Passe beenden" gedrückt wurde
      * @return true wenn Button gedrückt wurde
@@ -108,6 +123,8 @@ public:
 private:
     Adafruit_ST7789& display;
     ButtonManager& buttons;
+    RedrawManager& redraw;
+    SegmentDisplay countdown;
 
     // Turnierkonfiguration
     uint8_t shootingTime;    // 120 oder 240 Sekunden
@@ -123,13 +140,18 @@ private:
     // UI-State
     bool needsUpdate;
     bool firstDraw;
+    bool phaseChanged;  // Vorbereitung ↔ Schießbetrieb seit dem letzten draw()
+    bool groupChanged;  // Gruppe/Position seit dem letzten draw()
     bool endRequested;  // "Passe beenden" Button gedrückt
 
     // Selective Drawing Helper
     void drawHeader();
     void drawGroupSequence();
-    void drawTimer();
+    void drawPhase();
+    void drawGroup();
     void drawEndButton();
     void drawHelp();
-    void updateTimer();  // Nur Timer aktualisieren (selective redraw)
+    ScreenRect phaseArea() const;
+    ScreenRect countdownArea() const;
+    uint16_t countdownColor() const;
 };
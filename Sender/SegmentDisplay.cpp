@@ -0,0 +1,110 @@
+/**
+ * @file SegmentDisplay.cpp
+ * @brief Implementierung des Sieben-Segment-Countdowns
+ */
+
+#include "SegmentDisplay.h"
+
+namespace {
+    constexpr int16_t T = SegmentDisplay::SEGMENT_THICKNESS;
+    constexpr int16_t W = SegmentDisplay::DIGIT_WIDTH;
+    constexpr int16_t H = SegmentDisplay::DIGIT_HEIGHT;
+    constexpr int16_t SIDE = (H - 3 * T) / 2;  // Länge der senkrechten Segmente
+
+    static_assert(SIDE > 0 && W > 2 * T, "SegmentDisplay: Ziffer zu klein für die Segmentstärke");
+    static_assert(H <= 255, "SegmentDisplay: Segmente sind als uint8_t gespeichert");
+
+    /**
+     * @brief Segment-Rechteck relativ zur Ziffer (liegt im PROGMEM)
+     */
+    struct Segment {
+        uint8_t x;
+        uint8_t y;
+        uint8_t w;
+        uint8_t h;
+    };
+
+    //      a
+    //    f   b
+    //      g
+    //    e   c
+    //      d
+    const Segment SEGMENTS[7] PROGMEM = {
+        { T,     0,            W - 2 * T, T    },  // a
+        { W - T, T,            T,         SIDE },  // b
+        { W - T, 2 * T + SIDE, T,         SIDE },  // c
+        { T,     H - T,        W - 2 * T, T    },  // d
+        { 0,     2 * T + SIDE, T,         SIDE },  // e
+        { 0,     T,            T,         SIDE },  // f
+        { T,     T + SIDE,     W - 2 * T, T    }   // g
+    };
+
+    // Leuchtende Segmente der Ziffern 0-9 (Bit 0 = a ... Bit 6 = g)
+    const uint8_t DIGIT_SEGMENTS[10] PROGMEM = {
+        0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+    };
+}
+
+SegmentDisplay::SegmentDisplay(Adafruit_ST7789& tft)
+    : display(tft)
+    , originX(0)
+    , originY(0)
+    , shownColor(ST77XX_BLACK) {
+    for (uint8_t i = 0; i < DIGITS; i++) {
+        shownMask[i] = 0;
+    }
+}
+
+void SegmentDisplay::reset(int16_t x, int16_t y) {
+    originX = x;
+    originY = y;
+    for (uint8_t i = 0; i < DIGITS; i++) {
+        shownMask[i] = 0;
+    }
+}
+
+void SegmentDisplay::show(uint16_t value, uint16_t color) {
+    if (value > 999) value = 999;
+    bool colorChanged = (color != shownColor);
+
+    // Ein SPI-Transfer für alle Segmente
+    display.startWrite();
+    for (uint8_t digit = 0; digit < DIGITS; digit++) {
+        uint8_t mask = segmentsOf(value, digit);
+
+        // Geänderte Segmente, bei neuer Farbe zusätzlich alle leuchtenden
+        uint8_t paint = mask ^ shownMask[digit];
+        if (colorChanged) paint |= mask;
+
+        int16_t digitX = originX + digit * (DIGIT_WIDTH + DIGIT_GAP);
+        for (uint8_t s = 0; paint != 0; s++, paint >>= 1) {
+            if (!(paint & 1)) continue;
+
+            Segment seg;
+            memcpy_P(&seg, &SEGMENTS[s], sizeof(seg));
+            display.writeFillRect(digitX + seg.x, originY + seg.y, seg.w, seg.h,
+                                  (mask & (1 << s)) ? color : ST77XX_BLACK);
+        }
+        shownMask[digit] = mask;
+    }
+    display.endWrite();
+
+    shownColor = color;
+}
+
+//=============================================================================
+// Private Hilfsfunktionen
+//=============================================================================
+
+uint8_t SegmentDisplay::segmentsOf(uint16_t value, uint8_t digit) {
+    // Stelle von links: 0 = Hunderter
+    uint16_t divisor = 1;
+    for (uint8_t i = digit + 1; i < DIGITS; i++) {
+        divisor *= 10;
+    }
+
+    // Führende Nullen dunkel, die letzte Stelle immer sichtbar
+    if (value < divisor && digit < DIGITS - 1) return 0;
+
+    return pgm_read_byte(&DIGIT_SEGMENTS[(value / divisor) % 10]);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file SegmentDisplay.h
+ * @brief Große Sieben-Segment-Ziffern für den Countdown auf dem TFT
+ *
+ * Text in Größe 6 wäre lesbar, kostet aber pro Ziffer und Sekunde rund 3,5 KB
+ * SPI (Hintergrund inklusive). Die Ziffern bestehen hier aus sieben festen
+ * Rechtecken; pro Sekunde werden nur die Segmente neu gefüllt, die zwischen
+ * altem und neuem Wert an- bzw. ausgehen (ein fillRect() pro Segment).
+ */
+
+#pragma once
+
+#include <Adafruit_ST7789.h>
+#include "Config.h"
+
+/**
+ * @brief Dreistelliger Sieben-Segment-Countdown (0-999)
+ *
+ * Ein Segment ist ein einfarbiges Rechteck: ein Adressfenster (11 Bytes)
+ * plus 2 Bytes pro Pixel, also rund 260 Bytes. Ein Sekundenwechsel ändert
+ * typisch 2-9 Segmente (0,5-2,5 KB, bei 8 MHz SPI wenige Millisekunden).
+ * Nur ein Farbwechsel füllt alle leuchtenden Segmente neu (höchstens 21).
+ *
+ * Führende Nullen bleiben dunkel, die letzte Stelle zeigt immer eine Ziffer.
+ *
+ * Das Widget merkt sich, was auf dem Display steht, und zeichnet deckend:
+ * es braucht kein Löschen durch den RedrawManager. Nach reset() gilt der
+ * Bereich als schwarz (z.B. nach RedrawManager::beginScreen()).
+ *
+ * Usage:
+ * @code
+ * SegmentDisplay countdown(tft);
+ * countdown.reset(x, y);              // Bereich ist schwarz
+ * countdown.show(120, ST77XX_GREEN);  // Alle Segmente von "120"
+ * countdown.show(119, ST77XX_GREEN);  // Nur die Unterschiede zu "120"
+ * @endcode
+ */
+class SegmentDisplay {
+public:
+    static constexpr uint8_t DIGITS = 3;
+
+    // Geometrie einer Ziffer (Pixel)
+    static constexpr int16_t DIGIT_WIDTH = 32;
+    static constexpr int16_t DIGIT_HEIGHT = 60;
+    static constexpr int16_t SEGMENT_THICKNESS = 6;
+    static constexpr int16_t DIGIT_GAP = 8;
+
+    // Gesamtgröße des Widgets
+    static constexpr int16_t WIDTH = DIGITS * DIGIT_WIDTH + (DIGITS - 1) * DIGIT_GAP;
+    static constexpr int16_t HEIGHT = DIGIT_HEIGHT;
+
+    explicit SegmentDisplay(Adafruit_ST7789& tft);
+
+    /**
+     * @brief Setzt die Position, der Bereich gilt als schwarz (nichts gezeichnet)
+     * @param x Linke Kante
+     * @param y Obere Kante
+     */
+    void reset(int16_t x, int16_t y);
+
+    /**
+     * @brief Zeigt einen Wert an (zeichnet nur geänderte Segmente)
+     * @param value Wert 0-999 (größere Werte werden auf 999 begrenzt)
+     * @param color Farbe der leuchtenden Segmente (RGB565)
+     */
+    void show(uint16_t value, uint16_t color);
+
+private:
+    Adafruit_ST7789& display;
+
+    int16_t originX;
+    int16_t originY;
+    uint8_t shownMask[DIGITS];  // Leuchtende Segmente pro Stelle (Bit 0 = a ... Bit 6 = g)
+    uint16_t shownColor;
+
+    static uint8_t segmentsOf(uint16_t value, uint8_t digit);
+};
@@ -13,6 +13,12 @@
 
 #include "StateMachine.h"
 #include "ButtonManager.h"
+#include "Timebase.h"
+#include "ClockSync.h"
+#include "TxQueue.h"
+#include "LinkQuality.h"
+#include "LinkAdapter.h"
+#include "ChannelScan.h"
 
 //=============================================================================
 // Globale Instanzen
@@ -22,22 +28,26 @@
 ButtonManager buttons;
 Adafruit_ST7789 tft = Adafruit_ST7789(Pins::TFT_CS, Pins::TFT_DC, Pins::TFT_RST);
 RF24 radio(Pins::NRF_CE, Pins::NRF_CSN);
+TxQueue txQueue(radio);
 StateMachine stateMachine(tft, buttons);
 
-//=============================================================================
-// Timer1 für Interrupt-basierte 1-Sekunden-Ticks (wie Empfänger)
-//=============================================================================
+// Uhr des Empfängers (aus den ACK-Payloads geschätzt)
+ClockSync clockSync;
+uint32_t lastTxTime = 0;  // Zeitpunkt des letzten Sendeversuchs (millis, für Beacons)
 
-volatile bool senderSecondTick = false;     // Flag: Sekunde vergangen?
+// Verbindungsqualität (aus jeder Übertragung geschätzt)
+LinkQuality linkQuality;
+bool radioAvailable = false;  // Funkmodul initialisiert? (sonst keine PINGs)
 
-/**
- * @brief Timer1 Compare Match A Interrupt - wird jede Sekunde ausgelöst
- *
- * Diese ISR wird exakt jede Sekunde aufgerufen (identisch zum Empfänger).
- */
-ISR(TIMER1_COMPA_vect) {
-    senderSecondTick = true;
-}
+// Kanalbelegung (Scan beim Start) und Funkparameter (aus denselben Übertragungen geregelt)
+ChannelScan channelScan(radio, Pins::NRF_CE);
+LinkAdapter linkAdapter(radio, txQueue, channelScan);
+
+// Telemetrie des Empfängers (kommt mit der ACK-Payload, keine zusätzliche Sendezeit)
+PassState sentStates[2];          // Gesendeter Zustand der letzten zwei Pakete (Index: seq & 1)
+ReceiverStatus receiverStatus;    // Zuletzt gemeldeter Zustand des Empfängers
+bool receiverStatusNew = false;   // Seit dem letzten takeReceiverStatus() aktualisiert?
+bool receiverMismatch = false;    // Weicht der Empfänger vom gesendeten Zustand ab?
 
 //=============================================================================
 // Setup
@@ -57,8 +67,8 @@ void setup() {
     // Pins initialisieren
     initializePins();
 
-    // Timer1 für Sekunden-Ticks initialisieren (MUSS VOR State Machine starten!)
-    setupTimer1();
+    // Timer1 als Zeitbasis starten (MUSS VOR State Machine starten!)
+    Timebase::begin();
 
     // Button Manager initialisieren
     buttons.begin();
@@ -68,6 +78,9 @@ void setup() {
     bool radioOk = initializeRadio();
     DEBUG_PRINTLN(radioOk ? F("NRF OK") : F("NRF FAIL"));
 
+    // Sendewarteschlange: Zustand beim Start eintragen, ACK-Payload nach dem Senden auswerten
+    txQueue.begin(preparePacket, packetComplete);
+
     // Display initialisieren (nach Radio)
     tft.init(Display::WIDTH, Display::HEIGHT);  // ST7789 benötigt Auflösung
     tft.invertDisplay(false);
@@ -91,6 +104,12 @@ void loop() {
     // Button Manager Update (immer zuerst!)
     buttons.update();
 
+    // Funkparameter anpassen (vor der TxQueue, damit Profil-Pakete sofort starten)
+    linkAdapter.update();
+
+    // Laufende Übertragung prüfen, nächstes Paket starten (blockiert nie)
+    txQueue.update();
+
     // Alarm-Detection (globale Prüfung, hat Vorrang vor allem anderen)
     // Nur während Schießbetrieb aktiv
     if (buttons.isAlarmTriggered() && stateMachine.getCurrentState() == State::STATE_SCHIESS_BETRIEB) {
@@ -101,8 +120,11 @@ void loop() {
     // State Machine Update (verwaltet alle States inkl. Splash Screen)
     stateMachine.update();
 
-    // Kleine Pause um CPU zu entlasten
-    delay(10);
+    // Zustands-Beacon bei Funkstille (korrigiert verlorene Kommandos beim Empfänger)
+    sendBeaconIfDue();
+
+    // Keine Pause: txQueue.update() erkennt ACKs sonst erst nach der Pause
+    // (rttTicks wäre die Loop-Periode, Abfragen und Alarm-Runden würden gestreckt)
 }
 
 //=============================================================================
@@ -123,53 +145,6 @@ void initializePins() {
     // Keine manuelle Initialisierung nötig
 }
 
-/**
- * @brief Konfiguriert Timer1 für exakte 1-Sekunden-Interrupts (identisch zum Empfänger)
- *
- * Timer1 ist ein 16-Bit-Timer auf dem ATmega328P.
- * Mit Prescaler 256 und einem Compare-Wert von 62499:
- * - F_CPU = 16 MHz
- * - Prescaler = 256
- * - Timer-Takt = 16 MHz / 256 = 62.5 kHz
- * - Für 1 Hz: 62.5 kHz / 62500 = 1 Hz (exakt 1 Sekunde)
- */
-void setupTimer1() {
-    cli();  // Interrupts temporär deaktivieren
-
-    // Timer1 zurücksetzen
-    TCCR1A = 0;
-    TCCR1B = 0;
-    TCNT1 = 0;
-
-    // Compare-Wert setzen für 1 Hz (1 Sekunde)
-    // OCR1A = (F_CPU / (Prescaler * gewünschte Frequenz)) - 1
-    // OCR1A = (16000000 / (256 * 1)) - 1 = 62499
-    OCR1A = 62499;
-
-    // CTC-Modus (Clear Timer on Compare Match)
-    TCCR1B |= (1 << WGM12);
-
-    // Prescaler 256
-    TCCR1B |= (1 << CS12);
-
-    // Timer1 Compare Match A Interrupt aktivieren
-    TIMSK1 |= (1 << OCIE1A);
-
-    sei();  // Interrupts wieder aktivieren
-
-    DEBUG_PRINTLN(F("Timer1 konfiguriert (1s Ticks)"));
-}
-
-/**
- * @brief Setzt den Sender-Timer zurück (für synchronen Start)
- */
-void resetSenderTimer() {
-    cli();  // Interrupts kurz deaktivieren
-    TCNT1 = 0;  // Timer1 Counter zurücksetzen
-    senderSecondTick = false;
-    sei();
-}
-
 /**
  * @brief Initialisiert das NRF24L01 Funkmodul
  * @return true wenn erfolgreich, false bei Fehler
@@ -214,25 +189,31 @@ bool initializeRadio() {
         return false;  // Hardware nicht gefunden
     }
 
-    // Pipe-Adresse aus PROGMEM laden
-    uint8_t pipeAddr[5];
-    memcpy_P(pipeAddr, RF::PIPE_ADDRESS, 5);
-
-    // Radio konfigurieren
-    radio.setPALevel(RF::POWER_LEVEL);
-    radio.setDataRate(RF::DATA_RATE);
-    radio.setChannel(RF::CHANNEL);
-    radio.setPayloadSize(sizeof(RadioPacket));
+    // Kanalbelegung messen (ca. 200ms, vor dem Öffnen der Pipes)
+    channelScan.scan(RF::SCAN_PASSES);
 
     // Auto-ACK AKTIVIERT für Verbindungskontrolle
     radio.setAutoAck(RF::AUTO_ACK_ENABLED);
-    radio.setRetries(RF::RETRY_DELAY, RF::RETRY_COUNT);
+
+    // Kanal, Datenrate, Sendeleistung und Retries: Treffpunkt und Startprofil
+    // (danach regelt der LinkAdapter)
+    linkAdapter.begin();
+
+    // Dynamische Payload-Länge auf allen Pipes (wie beim Empfänger, dort
+    // braucht sie die Multicast-Pipe 2)
+    radio.enableDynamicPayloads();
+
+    // ACK-Payloads (Zeitabgleich) - benötigt dynamische Payload-Länge
+    radio.enableAckPayload();
+
+    // Multicast an alle Anzeigen ohne ACK (W_TX_PAYLOAD_NO_ACK)
+    radio.enableDynamicAck();
 
     // TX-Modus aktivieren
     radio.stopListening();
 
-    // Pipe für Schreiben öffnen
-    radio.openWritingPipe(pipeAddr);
+    // TX-Adresse setzt die TxQueue pro Anzeige (bzw. Multicast)
+    txQueue.radioReset();
 
     #if DEBUG_ENABLED
     DEBUG_PRINT(F("NRF Ch"));
@@ -241,97 +222,217 @@ bool initializeRadio() {
     DEBUG_PRINTLN(radio.isPVariant() ? F("+") : F(""));
     #endif
 
+    radioAvailable = true;
     return true;
 }
 
 /**
- * @brief Sendet ein Radio-Kommando an den Empfänger
- * @param cmd RadioCommand (CMD_STOP, CMD_START_120, CMD_START_240, CMD_INIT, CMD_ALARM)
- * @return TransmissionResult (TX_SUCCESS, TX_TIMEOUT, TX_ERROR)
+ * @brief Reiht ein Radio-Kommando ein (kehrt sofort zurück)
+ * @param cmd RadioCommand (CMD_STOP, CMD_START_120, CMD_START_240, CMD_INIT, CMD_ALARM, ...)
+ * @return false wenn die Sendewarteschlange voll ist
  */
-TransmissionResult sendCommand(RadioCommand cmd) {
-    // RadioPacket erstellen
-    RadioPacket packet;
-    packet.command = static_cast<uint8_t>(cmd);
-    packet.checksum = calculateChecksum(packet.command);
+bool sendCommand(RadioCommand cmd) {
+    return txQueue.enqueue(cmd, nullptr, nullptr);
+}
 
-    // Kurze Pause vor dem Senden (Radio stabilisieren)
-    delay(10);
+/**
+ * @brief Reiht ein Radio-Kommando mit Callback ein (kehrt sofort zurück)
+ * @param cmd RadioCommand
+ * @param callback Wird nach der Übertragung mit dem Ergebnis aufgerufen
+ * @param context Wird an den Callback durchgereicht
+ * @return false wenn die Sendewarteschlange voll ist (kein Callback)
+ */
+bool sendCommand(RadioCommand cmd, TxCallback callback, void* context) {
+    return txQueue.enqueue(cmd, callback, context);
+}
 
-    // Senden mit Auto-Retry und ACK-Prüfung
-    bool success = radio.write(&packet, sizeof(RadioPacket));
+/**
+ * @brief Trägt den aktuellen Zustand ins Paket ein (TxQueue, direkt vor dem Senden)
+ * @param packet Paket mit command und seq
+ */
+void preparePacket(RadioPacket& packet) {
+    stateMachine.getPassState(packet.state);
+    if (packet.command == CMD_RADIO_PROFILE || packet.command == CMD_CHANNEL) {
+        packet.state.param = linkAdapter.requestParam();
+    }
+    sentStates[packet.seq & 1] = packet.state;
+    lastTxTime = millis();
+}
+
+/**
+ * @brief Wertet eine abgeschlossene Abfrage aus (TxQueue, pro Anzeige vor dem Callback)
+ * @param report Ergebnis der Abfrage (report.display = Anzeige)
+ */
+void packetComplete(const TxReport& report) {
+    // Jede Abfrage ist eine Messung der Verbindungsqualität (ACK, Retries, Dauer) -
+    // offline Anzeigen zählen nur, solange keine andere antwortet
+    if (txQueue.isOnline(report.display) || !txQueue.anyOnline()) {
+        linkQuality.addReport(report);
+        linkAdapter.addReport(report);
+    }
+
+    if (report.result == TX_SUCCESS) {
+        // ACK-Payload gehört zum vorherigen Paket, danach dieses Paket vormerken
+        readAckPayload(report.seq, report.display);
+
+        // Zeitabgleich nur mit der Hauptanzeige und nur mit exaktem Sendezeitpunkt
+        // (bei Multicast ist unbekannt, welche Kopie zuerst ankam)
+        if (report.display == 0 && !report.multicast) {
+            clockSync.sentPacket(report.seq, report.rxTicks);
+        }
+    }
 
     #if DEBUG_ENABLED
-    DEBUG_PRINT(F("TX:"));
-    DEBUG_PRINTLN(success ? F("OK") : F("FAIL"));
+    DEBUG_PRINT(F("TX"));
+    DEBUG_PRINT(report.display);
+    DEBUG_PRINT(F(":"));
+    DEBUG_PRINTLN(report.result == TX_SUCCESS ? F("OK") : F("FAIL"));
     #endif
-
-    // success == true bedeutet: ACK empfangen
-    // success == false bedeutet: Kein ACK nach allen Retries
-    return success ? TX_SUCCESS : TX_TIMEOUT;
 }
 
 /**
- * @brief Sendet Alarm-Kommando mit mehrfachen Retry-Versuchen
- * @return TransmissionResult
+ * @brief Liest ACK-Payloads aus dem RX-FIFO (Zeitabgleich und Telemetrie)
+ * @param txSeq Sequenznummer des gerade bestätigten Pakets
+ * @param display Anzeige, die das ACK gesendet hat
+ *
+ * Zeitabgleich und Zustands-Rückmeldung nur von der Hauptanzeige (0),
+ * die Kanal-Messung von allen Anzeigen.
  */
-TransmissionResult sendAlarmWithRetry() {
-    TransmissionResult result;
+void readAckPayload(uint8_t txSeq, uint8_t display) {
+    while (radio.available()) {
+        if (radio.getDynamicPayloadSize() != sizeof(AckPayload)) {
+            radio.flush_rx();  // Unbekanntes Format (getDynamicPayloadSize leert bei >32 selbst)
+            break;
+        }
+
+        AckPayload ack;
+        radio.read(&ack, sizeof(AckPayload));
+        linkAdapter.addChannelReport(ack.status.channelReport);
 
-    for (uint8_t retry = 0; retry < Timing::ALARM_MAX_RETRIES; retry++) {
-        if (retry > 0) {
-            delay(Timing::ALARM_RETRY_DELAY_MS);
+        // Zustand nach genau diesem Paket gemeldet (bestätigt u.a. den Alarm)
+        if (ack.seq == txSeq) {
+            txQueue.confirm();
         }
+        if (display != 0) continue;
 
-        result = sendCommand(CMD_ALARM);
+        clockSync.receivedAck(ack);
 
-        if (result == TX_SUCCESS) {
-            return TX_SUCCESS;
+        // Vergleich nur mit einem der beiden zuletzt gesendeten Zustände möglich
+        receiverStatus = ack.status;
+        if ((uint8_t)(txSeq - ack.seq) <= 1) {
+            receiverMismatch = receiverDiffers(ack.status, sentStates[ack.seq & 1]);
         }
+        receiverStatusNew = true;
     }
+}
+
+/**
+ * @brief Vergleicht den gemeldeten Zustand des Empfängers mit dem gesendeten
+ * @param status Zustand des Empfängers nach dem Paket
+ * @param sent Mit diesem Paket gesendeter Zustand
+ * @return true bei abweichender Phase oder Gruppe
+ *
+ * Kurz vor einem Phasenwechsel (Restzeit < 1s) und im Alarm wird die Phase
+ * nicht verglichen - dort dürfen beide Seiten kurz unterschiedlich sein.
+ */
+bool receiverDiffers(const ReceiverStatus& status, const PassState& sent) {
+    // In der Konfiguration gleicht der Empfänger nichts ab
+    if (sent.phase == PHASE_SETUP) return false;
+
+    if (status.group != sent.group) return true;
+    if (sent.group != PASS_GROUP_NONE && status.position != sent.position) return true;
+
+    bool nearBoundary = (sent.phase == PHASE_PREPARATION || sent.phase == PHASE_SHOOTING) &&
+                        sent.remainingMs < 1000;
+    if (sent.phase == PHASE_ALARM || nearBoundary) return false;
 
-    // Alle Retries fehlgeschlagen
-    return result;
+    return status.phase != sent.phase;
 }
 
 /**
- * @brief Testet Verbindung zum Empfänger mit einem einzelnen PING
- * @return true wenn ACK empfangen wurde, false sonst
+ * @brief Holt die zuletzt gemeldete Telemetrie des Empfängers
+ * @param status Zustand und Diagnosezähler
+ * @param mismatch true wenn der Empfänger vom gesendeten Zustand abweicht
+ * @return true wenn seit dem letzten Aufruf eine neue Meldung kam
  */
-bool testReceiverConnection() {
-    TransmissionResult result = sendCommand(CMD_PING);
-    return (result == TX_SUCCESS);
+bool takeReceiverStatus(ReceiverStatus& status, bool& mismatch) {
+    if (!receiverStatusNew) return false;
+
+    receiverStatusNew = false;
+    status = receiverStatus;
+    mismatch = receiverMismatch;
+    return true;
 }
 
 /**
- * @brief Testet Verbindungsqualität mit 10 Pings in 5 Sekunden
- * @return Erfolgsrate in Prozent (0-100)
+ * @brief Sendet bei Funkstille ein CMD_SYNC (ab Turnierstart) bzw. CMD_PING (Splash/Konfiguration)
  *
- * Sendet 10 PING-Kommandos im Abstand von 500ms und zählt erfolgreiche ACKs.
- * Die Rückgabe ist die Erfolgsrate in Prozent (0% = alle fehlgeschlagen, 100% = alle erfolgreich).
+ * Der Beacon trägt den aktuellen Zustand und liefert nebenbei neue
+ * Messungen für ClockSync und LinkQuality. Nach RF::BEACON_INTERVAL_MS
+ * ohne Paket, solange LinkQuality noch keine RF::LINK_SETTLE_SAMPLES
+ * Messungen hat nach RF::LINK_FAST_PROBE_MS.
  */
-uint8_t testConnectionQuality() {
-    uint8_t successCount = 0;
-    const uint8_t totalPings = RF::QUALITY_TEST_PINGS;
+void sendBeaconIfDue() {
+    // Wartende oder laufende Pakete tragen den Zustand ohnehin
+    if (!radioAvailable || !txQueue.isIdle()) return;
+
+    bool settling = linkQuality.sampleCount() < RF::LINK_SETTLE_SAMPLES;
+    uint16_t interval = settling ? RF::LINK_FAST_PROBE_MS : RF::BEACON_INTERVAL_MS;
+    if (millis() - lastTxTime < interval) return;
+
+    // Vor Turnierstart gleicht der Empfänger nichts ab: PING genügt
+    State state = stateMachine.getCurrentState();
+    bool setup = (state == State::STATE_SPLASH || state == State::STATE_CONFIG_MENU);
+    sendCommand(setup ? CMD_PING : CMD_SYNC);
+}
 
-    for (uint8_t i = 0; i < totalPings; i++) {
-        // Sende PING und prüfe ACK
-        TransmissionResult result = sendCommand(CMD_PING);
+/**
+ * @brief Aktuelle Verbindungsqualität (LinkQuality)
+ * @param score Erfolgsquote pro Sendeversuch in Prozent (0-100)
+ * @param bars Balken für das Empfangs-Icon (0-4)
+ * @return false solange noch keine Übertragung ausgewertet wurde
+ */
+bool getLinkQuality(uint8_t& score, uint8_t& bars) {
+    score = linkQuality.score();
+    bars = linkQuality.bars();
+    return linkQuality.hasSamples();
+}
 
-        if (result == TX_SUCCESS) {
-            successCount++;
-        }
+/**
+ * @brief Kanalbelegung (Scan beim Start) und aktueller Kanal
+ * @param channel Aktueller Kanal (vom LinkAdapter gewählt)
+ * @return Belegungskarte (passes() == 0: noch nicht gescannt)
+ */
+const ChannelScan& getChannelMap(uint8_t& channel) {
+    channel = linkAdapter.channel();
+    return channelScan;
+}
 
-        // Warte 500ms bis zum nächsten Ping (außer beim letzten)
-        if (i < totalPings - 1) {
-            delay(RF::QUALITY_TEST_INTERVAL_MS);
-        }
-    }
+/**
+ * @brief Aktuelle Zeit auf der Uhr des Empfängers
+ * @return Geschätzte Empfänger-Ticks (Timebase-Einheit)
+ */
+uint32_t receiverNow() {
+    return clockSync.toRemote(Timebase::now());
+}
 
-    // Erfolgsrate berechnen (0-100%)
-    uint8_t qualityPercent = (successCount * 100) / totalPings;
+/**
+ * @brief Rechnet einen lokalen Zeitpunkt in Empfänger-Ticks um
+ * @param localTicks Lokaler Zeitpunkt (z.B. TxReport::rxTicks)
+ * @return Geschätzte Empfänger-Ticks
+ */
+uint32_t toReceiverTicks(uint32_t localTicks) {
+    return clockSync.toRemote(localTicks);
+}
 
-    return qualityPercent;
+/**
+ * @brief Vom Empfänger gemeldeter Empfangszeitpunkt eines Pakets
+ * @param seq Sequenznummer (TxReport::seq)
+ * @param remoteTicks Empfangszeitpunkt in Empfänger-Ticks
+ * @return true wenn die Meldung schon vorliegt (kommt mit dem ACK des nächsten Pakets)
+ */
+bool receiverTicksOf(uint8_t seq, uint32_t& remoteTicks) {
+    return clockSync.remoteTicksOf(seq, remoteTicks);
 }
 
 /**
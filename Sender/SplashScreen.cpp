@@ -4,28 +4,45 @@
  */
 
 #include "SplashScreen.h"
+#include "Commands.h"
+#include "TextMetrics.h"
+#include "Images.h"
+
+namespace {
+    // Belegte Bereiche (x, y, Breite, Höhe) - die Updates löschen nur innerhalb davon
+    constexpr ScreenRect IMAGE_AREA   = { (Display::WIDTH - Images::LOGO_WIDTH) / 2, 18,
+                                          Images::LOGO_WIDTH, Images::LOGO_HEIGHT };  // Zielscheibe (Images::LOGO)
+    constexpr ScreenRect LOGO_AREA    = { 10, 65, 220, 60 };    // Rahmen um "BOGENAMPEL"
+    constexpr ScreenRect QUALITY_AREA = { 0, 130, 240, 70 };    // Version, Verbindungsqualität
+    constexpr ScreenRect STATUS_AREA  = { 0, 225, 240, 20 };    // Hinweis, Verbindungsstatus
+    constexpr ScreenRect RF_AREA      = { 10, 255, 114, 18 };   // RF-Konfiguration (2 Zeilen)
+    constexpr ScreenRect MAP_AREA     = { 0, 289, 240, 26 };    // Kanalbelegung
+}
 
-SplashScreen::SplashScreen(Adafruit_ST7789& tft)
-    : display(tft) {
+SplashScreen::SplashScreen(Adafruit_ST7789& tft, RedrawManager& redrawMgr)
+    : display(tft)
+    , redraw(redrawMgr) {
 }
 
 void SplashScreen::draw() {
-    // Hintergrund schwarz
-    display.fillScreen(ST77XX_BLACK);
+    // Hintergrund schwarz (erster Screen: ganzes Display, der Display-RAM ist nach init() undefiniert)
+    redraw.beginScreen();
+    redraw.clear();
 
     // Layout-Berechnungen (bei Rotation 1: 320x240)
     const int16_t centerY = display.height() / 2;
     const int16_t centerX = display.width() / 2;
 
+    // Logo-Bild über dem Schriftzug (RLE, ein SPI-Burst)
+    display.drawRLEImage(IMAGE_AREA.x, IMAGE_AREA.y, Images::LOGO);
+
     // Logo-Text "BOGENAMPEL" - groß und zentriert
     display.setTextColor(ST77XX_GREEN);
     display.setTextSize(3);
 
-    // Text-Bounds für "BOGENAMPEL" ermitteln
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.getTextBounds("BOGENAMPEL", 0, 0, &x1, &y1, &w, &h);
-    display.setCursor(centerX - w/2, centerY - 75 - h/2);  // 15 Pixel nach oben verschoben
+    // Textmaße stehen zur Compile-Zeit fest (TextMetrics)
+    display.setCursor(TextMetrics::centerX("BOGENAMPEL", 3),
+                      centerY - 75 - TextMetrics::height(3) / 2);  // 15 Pixel nach oben verschoben
     display.print("BOGENAMPEL");
 
     // Rahmen um Logo (Portrait: 240 Breite)
@@ -34,15 +51,14 @@ void SplashScreen::draw() {
     // Versions-Text
     display.setTextColor(ST77XX_WHITE);
     display.setTextSize(2);
-    display.getTextBounds("Bogenampel V1.0", 0, 0, &x1, &y1, &w, &h);
-    display.setCursor(centerX - w/2, centerY + 20 - h/2);
+    display.setCursor(TextMetrics::centerX("Bogenampel V2.3", 2), centerY + 20 - TextMetrics::height(2) / 2);
     display.print("Bogenampel V2.3");
 
     // Hinweis zum Überspringen
     display.setTextColor(Display::COLOR_GRAY);
     display.setTextSize(1);
-    display.getTextBounds("Taste druecken zum Ueberspringen", 0, 0, &x1, &y1, &w, &h);
-    display.setCursor(centerX - w/2, centerY + 80 - h/2);
+    display.setCursor(TextMetrics::centerX("Taste druecken zum Ueberspringen", 1),
+                      centerY + 80 - TextMetrics::height(1) / 2);
     display.print("Taste druecken zum Ueberspringen");
 
     // Verbindungsstatus (initial)
@@ -72,6 +88,15 @@ void SplashScreen::draw() {
         case RF24_PA_HIGH: display.print(F("HIGH (-6dBm)")); break;
         case RF24_PA_MAX:  display.print(F("MAX (0dBm)")); break;
     }
+
+    // Für den nächsten Screen: nur diese Bereiche löschen
+    redraw.markPainted(IMAGE_AREA);
+    redraw.markPainted(LOGO_AREA);
+    redraw.markPainted(QUALITY_AREA);
+    redraw.markPainted(STATUS_AREA);
+    redraw.markPainted(RF_AREA);
+    redraw.markPainted(MAP_AREA);
+    redraw.endFrame();
 }
 
 void SplashScreen::updateConnectionStatus(const char* status) {
@@ -101,10 +126,7 @@ void SplashScreen::showConnectionQuality(uint8_t qualityPercent) {
     // Überschrift "Verbindung"
     display.setTextSize(1);
     display.setTextColor(ST77XX_WHITE);
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.getTextBounds("Verbindung", 0, 0, &x1, &y1, &w, &h);
-    display.setCursor(centerX - w/2, centerY - 25);
+    display.setCursor(TextMetrics::centerX("Verbindung", 1), centerY - 25);
     display.print("Verbindung");
 
     // Prozentanzeige (mittel)
@@ -122,8 +144,7 @@ void SplashScreen::showConnectionQuality(uint8_t qualityPercent) {
 
     // Zentrier-Position berechnen (nutze "100%" als Worst-Case für Breite)
     display.setTextColor(color);
-    display.getTextBounds("100%", 0, 0, &x1, &y1, &w, &h);
-    display.setCursor(centerX - w/2, centerY - 5);
+    display.setCursor(TextMetrics::centerX("100%", 3), centerY - 5);
     display.print(qualityPercent);
     display.print(F("%"));
 
@@ -155,7 +176,35 @@ void SplashScreen::showConnectionQuality(uint8_t qualityPercent) {
     } else {
         qualityText = "Keine Verbindung";
     }
+    // Laufzeittext: Breite über getTextBounds()
+    int16_t x1, y1;
+    uint16_t w, h;
     display.getTextBounds(qualityText, 0, 0, &x1, &y1, &w, &h);
     display.setCursor(centerX - w/2, barY + barHeight + 5);
     display.print(qualityText);
 }
+
+void SplashScreen::showChannelMap(const ChannelScan& scan, uint8_t activeChannel) {
+    uint8_t passes = scan.passes();
+    if (passes == 0) return;
+
+    display.fillRect(0, MAP_BOTTOM - MAP_HEIGHT - 1, display.width(), MAP_HEIGHT + 2, ST77XX_BLACK);
+
+    for (uint8_t channel = 0; channel < ChannelScan::CHANNELS; channel++) {
+        int16_t x = MAP_X + (int16_t)((uint16_t)channel * MAP_WIDTH / ChannelScan::CHANNELS);
+
+        // Aktueller Kanal: volle Höhe
+        if (channel == activeChannel) {
+            display.fillRect(x, MAP_BOTTOM - MAP_HEIGHT, 2, MAP_HEIGHT, ST77XX_GREEN);
+            continue;
+        }
+
+        // Belegt: Höhe nach Anteil der Treffer, außerhalb des ISM-Bands grau
+        uint8_t hits = scan.hits(channel);
+        int16_t height = 1 + (int16_t)hits * (MAP_HEIGHT - 1) / passes;
+        uint16_t color = (channel > CHANNEL_MAX_ALLOWED) ? Display::COLOR_DARKGRAY
+                       : (hits == 0) ? Display::COLOR_GRAY
+                       : (hits * 2 >= passes) ? ST77XX_RED : Display::COLOR_ORANGE;
+        display.fillRect(x, MAP_BOTTOM - height, 2, height, color);
+    }
+}
@@ -10,10 +10,16 @@
 
 #include <Adafruit_ST7789.h>
 #include "Config.h"
+#include "RedrawManager.h"
+#include "ChannelScan.h"
 
 class SplashScreen {
 public:
-    SplashScreen(Adafruit_ST7789& tft);
+    /**
+     * @param tft Display-Referenz
+     * @param redrawMgr Gemeinsame Invalidierung aller Screens
+     */
+    SplashScreen(Adafruit_ST7789& tft, RedrawManager& redrawMgr);
 
     /**
      * @brief Zeichnet den kompletten Splash Screen
@@ -32,9 +38,23 @@ public:
      */
     void showConnectionQuality(uint8_t qualityPercent);
 
+    /**
+     * @brief Zeigt die Kanalbelegung aus dem Scan (unten, ein Balken pro Kanal)
+     * @param scan Belegungskarte (ohne Scan wird nichts gezeichnet)
+     * @param activeChannel Aktueller Kanal (grün markiert)
+     */
+    void showChannelMap(const ChannelScan& scan, uint8_t activeChannel);
+
 private:
     Adafruit_ST7789& display;
+    RedrawManager& redraw;
 
     // Position für Status-Text (Portrait: 240x320)
     static constexpr uint16_t STATUS_Y = 230;
+
+    // Kanalbelegung (unter der RF-Konfiguration)
+    static constexpr uint16_t MAP_X = 6;
+    static constexpr uint16_t MAP_WIDTH = 228;
+    static constexpr uint16_t MAP_BOTTOM = 314;
+    static constexpr uint16_t MAP_HEIGHT = 24;
 };
@@ -5,11 +5,17 @@
 
 #include "StateMachine.h"
 #include "Commands.h"
+#include "Timebase.h"
 
 // Forward-Deklarationen für Radio-Funktionen (implementiert in Sender.ino)
-extern TransmissionResult sendCommand(RadioCommand cmd);
-extern bool testReceiverConnection();
-extern uint8_t testConnectionQuality();
+extern bool sendCommand(RadioCommand cmd);
+extern bool sendCommand(RadioCommand cmd, TxCallback callback, void* context);
+extern uint32_t receiverNow();
+extern uint32_t toReceiverTicks(uint32_t localTicks);
+extern bool receiverTicksOf(uint8_t seq, uint32_t& remoteTicks);
+extern bool takeReceiverStatus(ReceiverStatus& status, bool& mismatch);
+extern bool getLinkQuality(uint8_t& score, uint8_t& bars);
+extern const ChannelScan& getChannelMap(uint8_t& channel);
 extern bool initializeRadio();
 
 // Forward-Deklarationen für Batterie-Funktionen (implementiert in Sender.ino)
@@ -19,26 +25,31 @@ extern bool isUsbPowered();
 StateMachine::StateMachine(Adafruit_ST7789& tft, ButtonManager& btnMgr)
     : display(tft)
     , buttons(btnMgr)
-    , splashScreen(tft)
-    , configMenu(tft, btnMgr)
-    , pfeileHolenMenu(tft, btnMgr)
-    , schiessBetriebMenu(tft, btnMgr)
-    , alarmScreen(tft, btnMgr)
+    , redraw(tft)
+    , splashScreen(tft, redraw)
+    , configMenu(tft, btnMgr, redraw)
+    , pfeileHolenMenu(tft, btnMgr, redraw)
+    , schiessBetriebMenu(tft, btnMgr, redraw)
+    , alarmScreen(tft, btnMgr, redraw)
     , currentState(State::STATE_SPLASH)
     , previousState(State::STATE_SPLASH)
     , stateStartTime(0)
     , shootingTime(EEPROM_Config::DEFAULT_TIME)
     , shooterCount(EEPROM_Config::DEFAULT_COUNT)
     , radioInitialized(false)
-    , connectionTested(false)
-    , connectionSuccessful(false)
-    , qualityTestDone(false)
-    , connectionQuality(0)
+    , testStatusShown(false)
+    , qualityShown(false)
     , qualityDisplayStartTime(0)
+    , mapChannel(RF::CHANNEL)
     , lastConnectionCheck(0)
-    , initialPingsDone(false)
+    , lastBatteryCheck(0)
     , currentGroup(Groups::Type::GROUP_AB)     // Start mit A/B
-    , currentPosition(Groups::Position::POS_1) { // Start mit Position 1
+    , currentPosition(Groups::Position::POS_1)  // Start mit Position 1
+    , passRunning(false)
+    , inPreparationPhase(false)
+    , prepEndTicks(0)
+    , shootEndTicks(0)
+    , startSeq(0) {
 }
 
 void StateMachine::begin() {
@@ -108,10 +119,8 @@ void StateMachine::setState(State newState) {
 
 void StateMachine::enterSplash() {
     // Verbindungstest-Variablen zurücksetzen
-    connectionTested = false;
-    connectionSuccessful = false;
-    qualityTestDone = false;
-    connectionQuality = 0;
+    testStatusShown = false;
+    qualityShown = false;
     qualityDisplayStartTime = 0;
     lastConnectionCheck = 0;  // Sofort testen
 
@@ -122,6 +131,14 @@ void StateMachine::enterSplash() {
     if (!radioInitialized) {
         splashScreen.updateConnectionStatus("Suche Funkmodul");
     }
+
+    // Kanalbelegung aus dem Scan beim Start
+    showChannelMap();
+}
+
+void StateMachine::showChannelMap() {
+    const ChannelScan& scan = getChannelMap(mapChannel);
+    splashScreen.showChannelMap(scan, mapChannel);
 }
 
 void StateMachine::handleSplash() {
@@ -140,30 +157,50 @@ void StateMachine::handleSplash() {
 
             if (!radioInitialized) {
                 splashScreen.updateConnectionStatus("Suche Funkmodul");
+            } else {
+                showChannelMap();
             }
         }
         // Splash Screen bleibt solange bestehen, bis Modul gefunden wird
         return;
     }
 
-    // Fall 2: Radio initialisiert, aber Quality Test noch nicht durchgeführt
-    if (!qualityTestDone) {
-        // Status anzeigen
-        splashScreen.updateConnectionStatus("Teste Verbindung");
+    // Fall 2: Radio initialisiert, aber noch keine Übertragung ausgewertet
+    // (PINGs laufen im Hintergrund, siehe sendBeaconIfDue() in Sender.ino)
+    uint8_t score;
+    uint8_t bars;
+    bool measured = getLinkQuality(score, bars);
+    if (!qualityShown) {
+        if (!measured) {
+            if (!testStatusShown) {
+                splashScreen.updateConnectionStatus("Teste Verbindung");
+                testStatusShown = true;
+            }
+            return;
+        }
 
-        // Connection Quality Test durchführen (blockierend, ~5 Sekunden)
-        connectionQuality = testConnectionQuality();
-        qualityTestDone = true;
-        connectionTested = true;
-        connectionSuccessful = (connectionQuality > 0);
+        // Erste Messung: Qualität anzeigen
+        qualityShown = true;
         qualityDisplayStartTime = millis();
-
-        // Qualität anzeigen
-        splashScreen.showConnectionQuality(connectionQuality);
+        lastConnectionCheck = millis();
+        splashScreen.showConnectionQuality(score);
         return;
     }
 
-    // Fall 3: Quality Test durchgeführt - zeige Qualität für 5 Sekunden
+    // Fall 3: Qualität wird angezeigt - jede Sekunde aktualisieren
+    if (millis() - lastConnectionCheck >= RF::LINK_DISPLAY_MS) {
+        splashScreen.showConnectionQuality(score);
+        lastConnectionCheck = millis();
+
+        // Kanalwechsel (LinkAdapter) in der Kanalbelegung nachführen
+        uint8_t channel;
+        getChannelMap(channel);
+        if (channel != mapChannel) {
+            showChannelMap();
+        }
+    }
+
+    // Nach 5 Sekunden Anzeige weiter
     uint32_t qualityDisplayTime = millis() - qualityDisplayStartTime;
     if (qualityDisplayTime >= Timing::QUALITY_DISPLAY_DURATION_MS) {
         // 5 Sekunden sind vorbei -> zum Config Menu
@@ -182,9 +219,6 @@ void StateMachine::enterConfigMenu() {
     // ConfigMenu initialisieren
     configMenu.begin();
     configMenu.draw();
-
-    // Initiale Pings zurücksetzen für nächsten Pfeile-Holen State
-    initialPingsDone = false;
 }
 
 void StateMachine::handleConfigMenu() {
@@ -244,45 +278,35 @@ void StateMachine::enterPfeileHolen() {
     }
     sendCommand(groupCmd);
 
-    // Verbindungstest-Timer zurücksetzen (sofort testen)
+    // Verbindungsqualität und Batterie sofort anzeigen
     lastConnectionCheck = 0;
+    lastBatteryCheck = 0;
 }
 
 void StateMachine::handlePfeileHolen() {
-    // Beim ersten Aufruf: 4 schnelle Pings durchführen um die Ping-Historie zu füllen
-    if (!initialPingsDone) {
-        // 4 schnelle Pings im Abstand von 200ms
-        for (uint8_t i = 0; i < 4; i++) {
-            bool connected = testReceiverConnection();
-            pfeileHolenMenu.updateConnectionStatus(connected);
-
-            // Warte 200ms bis zum nächsten Ping (außer beim letzten)
-            if (i < 3) {
-                delay(200);
-            }
-        }
-
-        // Initiale Batteriemessung durchführen
-        uint16_t voltage = readBatteryVoltage();
-        bool usbPowered = isUsbPowered();
-        pfeileHolenMenu.updateBatteryStatus(voltage, usbPowered);
-
-        // Flags setzen
-        initialPingsDone = true;
+    // Verbindungsqualität jede Sekunde anzeigen (gemessen an jeder Übertragung,
+    // PINGs nur bei Funkstille - hier genügen die Beacons)
+    if (lastConnectionCheck == 0 || millis() - lastConnectionCheck >= RF::LINK_DISPLAY_MS) {
+        uint8_t score;
+        uint8_t bars;
+        getLinkQuality(score, bars);
+        pfeileHolenMenu.updateLinkQuality(score, bars);
         lastConnectionCheck = millis();
     }
 
-    // Verbindungstest alle 5 Sekunden durchführen (nach den initialen Pings)
-    if (millis() - lastConnectionCheck >= 5000) {
-        bool connected = testReceiverConnection();
-        pfeileHolenMenu.updateConnectionStatus(connected);
-
-        // Batteriemessung durchführen
+    // Batteriemessung alle 5 Sekunden
+    if (lastBatteryCheck == 0 || millis() - lastBatteryCheck >= 5000) {
         uint16_t voltage = readBatteryVoltage();
         bool usbPowered = isUsbPowered();
         pfeileHolenMenu.updateBatteryStatus(voltage, usbPowered);
+        lastBatteryCheck = millis();
+    }
 
-        lastConnectionCheck = millis();
+    // Telemetrie des Empfängers (kommt mit den ACKs von Beacons und Pings)
+    ReceiverStatus receiverStatus;
+    bool mismatch;
+    if (takeReceiverStatus(receiverStatus, mismatch)) {
+        pfeileHolenMenu.updateReceiverStatus(receiverStatus, mismatch);
     }
 
     // PfeileHolenMenu aktualisieren
@@ -363,27 +387,8 @@ void StateMachine::exitPfeileHolen() {
 //=============================================================================
 
 void StateMachine::enterSchiessBetrieb() {
-    // Starte mit Vorbereitungsphase (10 Sekunden, oder 5s im DEBUG)
-    inPreparationPhase = true;
-    preparationSecondsRemaining = Timing::PREPARATION_TIME_MS / 1000;  // 10s oder 5s
-
-    // Schießzeit setzen (normal oder verkürzt für DEBUG)
-    #if DEBUG_SHORT_TIMES
-        // DEBUG: 15s für beide Modi
-        shootingDurationMs = 15000UL;
-        shootingSecondsRemaining = 15;
-    #else
-        shootingDurationMs = shootingTime * 1000UL;  // Sekunden → Millisekunden
-        shootingSecondsRemaining = shootingTime;     // 120s oder 240s
-    #endif
-
-    // Sende START-Kommando sofort (Empfänger startet eigene 10s Vorbereitungsphase)
-    RadioCommand cmd = (shootingTime == 120) ? CMD_START_120 : CMD_START_240;
-    sendCommand(cmd);
-
-    // SOFORT danach: Starte Sender-Timer (Interrupt-basiert, synchron mit Empfänger)
-    extern void resetSenderTimer();  // Funktion aus Sender.ino
-    resetSenderTimer();
+    // START senden, Fristen auf der Uhr des Empfängers setzen
+    startPasse();
 
     // Menü initialisieren
     schiessBetriebMenu.begin();
@@ -397,44 +402,33 @@ void StateMachine::enterSchiessBetrieb() {
 }
 
 void StateMachine::handleSchiessBetrieb() {
-    // Prüfe ob eine Sekunde vergangen ist (Interrupt-Flag aus Sender.ino)
-    extern volatile bool senderSecondTick;
+    // Fristen liegen auf der Uhr des Empfängers: Phasenwechsel gleichzeitig mit der Anzeige
+    uint32_t now = receiverNow();
 
-    if (senderSecondTick) {
-        senderSecondTick = false;  // Flag zurücksetzen
+    // Fall 1: Vorbereitungsphase (10 Sekunden oder 5s im DEBUG, orange Countdown)
+    if (inPreparationPhase) {
+        if (Timebase::reached(now, prepEndTicks)) {
+            // Beende Vorbereitungsphase → Wechsel zur Schießphase
+            inPreparationPhase = false;
 
-        // Fall 1: Vorbereitungsphase (10 Sekunden oder 5s im DEBUG, orange Countdown)
-        if (inPreparationPhase) {
-            // Dekrementiere verbleibende Zeit
-            if (preparationSecondsRemaining > 0) {
-                preparationSecondsRemaining--;
-            }
-
-            // Prüfe ob Vorbereitungsphase vorbei
-            if (preparationSecondsRemaining == 0) {
-                // Beende Vorbereitungsphase → Wechsel zur Schießphase
-                inPreparationPhase = false;
-
-                DEBUG_PRINTLN(F("Prep END -> Shooting START"));
-
-                // Display aktualisieren (nur beim Phasenwechsel!)
-                schiessBetriebMenu.setShootingPhase(shootingSecondsRemaining * 1000);
-            }
-        }
-        // Fall 2: Eigentliche Schießphase (120/240 Sekunden oder 15s im DEBUG, grün)
-        else {
-            // Dekrementiere verbleibende Zeit
-            if (shootingSecondsRemaining > 0) {
-                shootingSecondsRemaining--;
-            }
+            DEBUG_PRINTLN(F("Prep END -> Shooting START"));
 
-            // Automatisches Ende bei Zeitablauf
-            if (shootingSecondsRemaining == 0) {
-                handleShootingPhaseEnd();
-                return;
-            }
+            // Display aktualisieren (nur beim Phasenwechsel!)
+            schiessBetriebMenu.setShootingPhase(Timebase::toMillis(shootEndTicks - now));
         }
     }
+    // Fall 2: Eigentliche Schießphase (120/240 Sekunden oder 15s im DEBUG, grün)
+    else if (Timebase::reached(now, shootEndTicks)) {
+        // Automatisches Ende bei Zeitablauf
+        handleShootingPhaseEnd();
+        return;
+    }
+
+    // Countdown wie auf der großen Anzeige: aufgerundete Restsekunden der Phase
+    // (draw() nur, wenn sich die Sekunde ändert)
+    uint32_t deadline = inPreparationPhase ? prepEndTicks : shootEndTicks;
+    uint32_t left = Timebase::reached(now, deadline) ? 0 : deadline - now;
+    schiessBetriebMenu.setRemainingSeconds((left + Timebase::TICKS_PER_SECOND - 1) / Timebase::TICKS_PER_SECOND);
 
     // Menu aktualisieren (jeder Frame, nicht nur bei Sekunden-Tick)
     schiessBetriebMenu.update();
@@ -449,7 +443,7 @@ void StateMachine::handleSchiessBetrieb() {
         if (inPreparationPhase) {
             // Während Vorbereitungsphase: Abbruch
             advanceToNextGroup();
-            sendCommand(CMD_STOP);
+            stopPasse();
             setState(State::STATE_PFEILE_HOLEN);
         } else {
             // Während Schießphase: Normale Beendigung
@@ -470,7 +464,7 @@ void StateMachine::handleShootingPhaseEnd() {
     if (shooterCount <= 2) {
         // 1-2 Schützen: Nur eine Gruppe
         // Sende STOP (3 Pieptöne auf Empfänger)
-        sendCommand(CMD_STOP);
+        stopPasse();
 
         // Wechsle zur nächsten Gruppe (für nächste Passe)
         advanceToNextGroup();
@@ -486,19 +480,9 @@ void StateMachine::handleShootingPhaseEnd() {
             // Erste Gruppe der Passe fertig → Starte zweite Gruppe
             advanceToNextGroup();  // Wechsle zur zweiten Gruppe
 
-            // Vorbereitung für zweite Gruppe manuell neu starten (Interrupt-basiert)
+            // Vorbereitung für zweite Gruppe manuell neu starten
             // (setState würde nicht funktionieren da wir bereits in STATE_SCHIESS_BETRIEB sind)
-            inPreparationPhase = true;
-            preparationSecondsRemaining = Timing::PREPARATION_TIME_MS / 1000;  // 10s oder 5s
-            shootingSecondsRemaining = shootingDurationMs / 1000;  // Wiederherstellen
-
-            // Sende START-Kommando (Empfänger startet eigene 10s Vorbereitungsphase)
-            RadioCommand startCmd = (shootingTime == 120) ? CMD_START_120 : CMD_START_240;
-            sendCommand(startCmd);
-
-            // Timer zurücksetzen für synchronen Start
-            extern void resetSenderTimer();
-            resetSenderTimer();
+            startPasse();
 
             // Menü für zweite Gruppe aktualisieren
             schiessBetriebMenu.setTournamentConfig(shootingTime, shooterCount, currentGroup, currentPosition);
@@ -507,7 +491,7 @@ void StateMachine::handleShootingPhaseEnd() {
         } else {
             // Zweite Gruppe der Passe fertig (POS_2) → Ende der Passe
             // Sende STOP (3 Pieptöne auf Empfänger)
-            sendCommand(CMD_STOP);
+            stopPasse();
 
             // Wechsle zur nächsten Gruppe (für nächste Passe)
             advanceToNextGroup();
@@ -519,6 +503,110 @@ void StateMachine::handleShootingPhaseEnd() {
 }
 
 void StateMachine::exitSchiessBetrieb() {
+    passRunning = false;
+}
+
+/**
+ * @brief Sendet START und setzt die Fristen der Passe
+ *
+ * Der Empfänger rechnet seine Fristen ab dem Empfang des START-Kommandos.
+ * Der Sender übernimmt genau diesen Zeitpunkt (aus der ACK-Payload) und
+ * vergleicht mit receiverNow(), damit beide Anzeigen gleichzeitig umschalten.
+ * Vorläufige Fristen vor dem Senden: das START-Paket trägt damit schon die
+ * volle Restzeit der Vorbereitung. Beide Pakete laufen über die TxQueue,
+ * die Fristen werden in onStartReport() nachgeführt.
+ */
+void StateMachine::startPasse() {
+    // Starte mit Vorbereitungsphase (10 Sekunden, oder 5s im DEBUG)
+    passRunning = true;
+    inPreparationPhase = true;
+
+    setDeadlines(receiverNow());
+
+    // Sende START-Kommando (Empfänger startet eigene Vorbereitungsphase),
+    // der Empfangszeitpunkt kommt erst mit dem ACK des folgenden CMD_SYNC zurück
+    RadioCommand cmd = (shootingTime == 120) ? CMD_START_120 : CMD_START_240;
+    sendCommand(cmd, onStartReport, this);
+    sendCommand(CMD_SYNC, onStartReport, this);
+}
+
+/**
+ * @brief Führt die Fristen nach START bzw. dem folgenden CMD_SYNC nach
+ *
+ * START bestätigt: Empfangszeitpunkt aus Sendestart und Retries geschätzt.
+ * SYNC bestätigt: Empfangszeitpunkt des START laut Empfänger (ACK-Payload).
+ */
+void StateMachine::onStartReport(void* context, const TxReport& report) {
+    StateMachine* self = static_cast<StateMachine*>(context);
+    if (!self->passRunning || report.result != TX_SUCCESS) return;
+
+    if (report.command == CMD_SYNC) {
+        uint32_t startTicks;
+        if (receiverTicksOf(self->startSeq, startTicks)) {
+            self->setDeadlines(startTicks);
+        }
+        return;
+    }
+
+    self->startSeq = report.seq;
+    self->setDeadlines(toReceiverTicks(report.rxTicks));
+}
+
+void StateMachine::setDeadlines(uint32_t startTicks) {
+    prepEndTicks = startTicks + Timebase::fromSeconds(Timing::PREPARATION_TIME_MS / 1000);
+    shootEndTicks = prepEndTicks + Timebase::fromSeconds(shootingSeconds());
+}
+
+/**
+ * @brief Beendet die Passe und sendet STOP
+ *
+ * Die Passe gilt schon vor dem Senden als beendet, damit das STOP-Paket
+ * (und jeder folgende Beacon) PHASE_IDLE trägt.
+ */
+void StateMachine::stopPasse() {
+    passRunning = false;
+    sendCommand(CMD_STOP);
+}
+
+void StateMachine::getPassState(PassState& state) const {
+    state.group = PASS_GROUP_NONE;
+    if (shooterCount > 2) {
+        state.group = (currentGroup == Groups::Type::GROUP_AB) ? PASS_GROUP_AB : PASS_GROUP_CD;
+    }
+    state.position = (currentPosition == Groups::Position::POS_1) ? 1 : 2;
+    state.prepSeconds = Timing::PREPARATION_TIME_MS / 1000;
+    state.shootSeconds = shootingSeconds();
+    state.param = 0;
+    state.remainingMs = 0;
+
+    switch (currentState) {
+        case State::STATE_SPLASH:
+        case State::STATE_CONFIG_MENU:
+            state.phase = PHASE_SETUP;
+            break;
+
+        case State::STATE_ALARM:
+            state.phase = PHASE_ALARM;
+            break;
+
+        case State::STATE_SCHIESS_BETRIEB:
+            if (passRunning) {
+                // Restzeit auf der Uhr des Empfängers (0 sobald die Frist erreicht ist)
+                uint32_t now = receiverNow();
+                uint32_t deadline = inPreparationPhase ? prepEndTicks : shootEndTicks;
+                state.phase = inPreparationPhase ? PHASE_PREPARATION : PHASE_SHOOTING;
+                if (!Timebase::reached(now, deadline)) {
+                    state.remainingMs = Timebase::toMillis(deadline - now);
+                }
+                break;
+            }
+            state.phase = PHASE_IDLE;
+            break;
+
+        default:
+            state.phase = PHASE_IDLE;
+            break;
+    }
 }
 
 //=============================================================================
@@ -526,14 +614,19 @@ void StateMachine::exitSchiessBetrieb() {
 //=============================================================================
 
 void StateMachine::enterAlarm() {
+    // CMD_ALARM zuerst: das erste Paket liegt nach sendCommand() im TX-FIFO.
+    // Der Alarm-Screen (Löschen + Text, mehrere 10 KB SPI) kommt danach.
+    sendCommand(CMD_ALARM);
+
+    #if DEBUG_ENABLED
+    // Latenz Alarm-Erkennung (Taste 2s gehalten) → erstes Paket im TX-FIFO
+    DEBUG_PRINT(F("ALARM triggered, erstes Paket nach us: "));
+    DEBUG_PRINTLN((Timebase::now() - buttons.getAlarmTicks()) * (1000000UL / Timebase::TICKS_PER_SECOND));
+    #endif
+
     // Alarm-Screen initialisieren
     alarmScreen.begin();
     alarmScreen.draw();
-
-    // CMD_ALARM an Empfänger senden
-    sendCommand(CMD_ALARM);
-
-    DEBUG_PRINTLN(F("ALARM triggered"));
 }
 
 void StateMachine::handleAlarm() {
@@ -559,6 +652,14 @@ bool StateMachine::timeInState(uint32_t milliseconds) const {
     return (millis() - stateStartTime) >= milliseconds;
 }
 
+uint8_t StateMachine::shootingSeconds() const {
+    #if DEBUG_SHORT_TIMES
+        return 15;  // DEBUG: 15s für beide Modi
+    #else
+        return shootingTime;  // 120s oder 240s
+    #endif
+}
+
 void StateMachine::advanceToNextGroup() {
     // 4-Zyklus: AB_POS1 -> CD_POS2 -> CD_POS1 -> AB_POS2 -> AB_POS1
     if (currentGroup == Groups::Type::GROUP_AB && currentPosition == Groups::Position::POS_1) {
@@ -8,11 +8,15 @@
 #include <Adafruit_ST7789.h>
 #include "Config.h"
 #include "ButtonManager.h"
+#include "RedrawManager.h"
 #include "ConfigMenu.h"
 #include "SplashScreen.h"
 #include "PfeileHolenMenu.h"
 #include "SchiessBetriebMenu.h"
 #include "AlarmScreen.h"
+#include "Commands.h"
+#include "TxQueue.h"
+#include "ChannelScan.h"
 
 /**
  * @brief System-Zustände (Tournament State Machine)
@@ -79,9 +83,16 @@ public:
      */
     uint8_t getShooterCount() const { return shooterCount; }
 
+    /**
+     * @brief Vollständiger Soll-Zustand für den Empfänger (wird in jedes Paket geschrieben)
+     * @param state Phase, Gruppe, Position, Zeiten und Restzeit der laufenden Phase
+     */
+    void getPassState(PassState& state) const;
+
 private:
     Adafruit_ST7789& display;
     ButtonManager& buttons;
+    RedrawManager redraw;           // Invalidierung für alle Screens (vor den Screens initialisieren!)
     SplashScreen splashScreen;      // Splash Screen (nur UI)
     ConfigMenu configMenu;          // Konfigurationsmenü
     PfeileHolenMenu pfeileHolenMenu; // Pfeile-Holen-Menü
@@ -101,17 +112,16 @@ private:
     // State Variables: SPLASH
     //-------------------------------------------------------------------------
     bool radioInitialized;      // NRF24L01 Modul gefunden?
-    bool connectionTested;      // Verbindungstest durchgeführt?
-    bool connectionSuccessful;  // Empfänger gefunden?
-    bool qualityTestDone;       // Connection Quality Test durchgeführt?
-    uint8_t connectionQuality;  // Verbindungsqualität in Prozent (0-100)
+    bool testStatusShown;       // "Teste Verbindung" angezeigt?
+    bool qualityShown;          // Verbindungsqualität angezeigt? (ab der ersten Messung)
     uint32_t qualityDisplayStartTime; // Zeitpunkt wann Qualitätsanzeige gestartet wurde
+    uint8_t mapChannel;         // In der Kanalbelegung markierter Kanal
 
     //-------------------------------------------------------------------------
     // State Variables: PFEILE_HOLEN
     //-------------------------------------------------------------------------
-    uint32_t lastConnectionCheck;  // Zeitpunkt der letzten Verbindungsprüfung
-    bool initialPingsDone;         // Wurden die 4 initialen schnellen Pings bereits durchgeführt?
+    uint32_t lastConnectionCheck;  // Zeitpunkt der letzten Anzeige der Verbindungsqualität
+    uint32_t lastBatteryCheck;     // Zeitpunkt der letzten Batteriemessung
 
     //-------------------------------------------------------------------------
     // Schützengruppen-Tracking (für 3-4 Schützen Modus)
@@ -120,12 +130,13 @@ private:
     Groups::Position currentPosition; // Aktuelle Position (POS_1 oder POS_2)
 
     //-------------------------------------------------------------------------
-    // State Variables: SCHIESS_BETRIEB (Interrupt-basiert)
+    // State Variables: SCHIESS_BETRIEB (Fristen auf der Uhr des Empfängers)
     //-------------------------------------------------------------------------
+    bool passRunning;                     // Läuft eine Passe? (false vor jedem STOP)
     bool inPreparationPhase;              // Sind wir in der Vorbereitungsphase? (10s oder 5s)
-    uint32_t preparationSecondsRemaining; // Verbleibende Sekunden Vorbereitungsphase
-    uint32_t shootingSecondsRemaining;    // Verbleibende Sekunden Schießphase
-    uint32_t shootingDurationMs;          // Dauer in Millisekunden (nur für Kompatibilität)
+    uint32_t prepEndTicks;                // Ende der Vorbereitung (Empfänger-Ticks)
+    uint32_t shootEndTicks;               // Ende der Schießphase (Empfänger-Ticks)
+    uint8_t startSeq;                     // Sequenznummer des bestätigten START-Pakets
 
     //-------------------------------------------------------------------------
     // State Handlers
@@ -140,17 +151,26 @@ private:
     // State Entry/Exit Functions
     //-------------------------------------------------------------------------
     void enterSplash();
+    void showChannelMap();          // Kanalbelegung mit aktuellem Kanal zeichnen
     void exitSplash();
     void enterConfigMenu();
     void exitConfigMenu();
     void enterPfeileHolen();
     void exitPfeileHolen();
     void enterSchiessBetrieb();
+    void startPasse();              // START senden und Fristen setzen (beide Gruppen)
+    void stopPasse();               // STOP senden (Passe im Zustand vorher beenden)
+    void setDeadlines(uint32_t startTicks); // Fristen ab Startzeitpunkt (Empfänger-Ticks)
     void handleShootingPhaseEnd();  // Behandelt Ende der Schießphase (1-2 vs 3-4 Schützen)
     void exitSchiessBetrieb();
     void enterAlarm();
     void exitAlarm();
 
+    //-------------------------------------------------------------------------
+    // TxQueue-Callbacks (context: StateMachine)
+    //-------------------------------------------------------------------------
+    static void onStartReport(void* context, const TxReport& report);
+
     //-------------------------------------------------------------------------
     // Hilfsfunktionen
     //-------------------------------------------------------------------------
@@ -165,4 +185,9 @@ private:
      * AB_POS1 -> CD_POS2 -> CD_POS1 -> AB_POS2 -> AB_POS1
      */
     void advanceToNextGroup();
+
+    /**
+     * @brief Dauer der Schießphase in Sekunden (120/240, im DEBUG 15s)
+     */
+    uint8_t shootingSeconds() const;
 };
@@ -0,0 +1,105 @@
+/**
+ * @file TextMetrics.h
+ * @brief Textgrößen zur Compile-Zeit (für konstante Texte)
+ *
+ * getTextBounds() läuft bei jedem Zeichnen Zeichen für Zeichen durch
+ * charBounds(), nur um einen konstanten Text zu zentrieren. Für Schriften
+ * mit fester Zeichenbreite steht das Ergebnis schon beim Kompilieren fest:
+ * die Funktionen hier sind constexpr, zentrierte Layouts werden zu
+ * konstanten Koordinaten.
+ *
+ * Unterstützt:
+ * - Eingebaute 5×7-Schrift (setFont() ohne Font): 6 × 8 Pixel pro Zeichen
+ * - Mitgelieferte Schriften mit fester Breite (FreeMono*): siehe FREE_MONO_*
+ *
+ * Proportionale GFX-Fonts (FreeSans, FreeSerif, ...) und Texte, die erst zur
+ * Laufzeit feststehen (Akkuspannung, Statusmeldungen), messen weiterhin mit
+ * getTextBounds().
+ *
+ * Die Werte entsprechen getTextBounds() bei der 5×7-Schrift (ohne Umbruch,
+ * ohne '\n'): Breite = Zeichen × 6 × Größe, Höhe = 8 × Größe.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "Config.h"
+
+/**
+ * @brief Schriftmaße einer Schrift mit fester Zeichenbreite
+ */
+struct MonoFont {
+    uint8_t xAdvance;   // Cursor-Vorschub pro Zeichen (Pixel bei Größe 1)
+    uint8_t yAdvance;   // Zeilenabstand (Pixel bei Größe 1)
+};
+
+namespace TextMetrics {
+
+    // Eingebaute 5×7-Schrift (5 Pixel + 1 Pixel Abstand, 7 Pixel + 1 Zeile Unterlänge)
+    constexpr MonoFont CLASSIC = { 6, 8 };
+
+    // Mitgelieferte GFX-Fonts mit fester Breite (xAdvance/yAdvance aus Fonts/FreeMono*.h,
+    // gleich für Bold/Oblique). Gemessen wird der Cursor-Vorschub, nicht die Glyphen-Pixel.
+    constexpr MonoFont FREE_MONO_9PT  = { 11, 18 };
+    constexpr MonoFont FREE_MONO_12PT = { 14, 24 };
+    constexpr MonoFont FREE_MONO_18PT = { 21, 35 };
+    constexpr MonoFont FREE_MONO_24PT = { 28, 47 };
+
+    /**
+     * @brief Anzahl Zeichen eines String-Literals
+     */
+    constexpr uint16_t length(const char* text) {
+        return (*text == '\0') ? 0 : 1 + length(text + 1);
+    }
+
+    /**
+     * @brief Breite eines Textes in Pixel
+     * @param text String-Literal (eine Zeile)
+     * @param size Textgröße (setTextSize())
+     * @param font Schrift (Standard: eingebaute 5×7-Schrift)
+     */
+    constexpr int16_t width(const char* text, uint8_t size, MonoFont font = CLASSIC) {
+        return length(text) * font.xAdvance * size;
+    }
+
+    /**
+     * @brief Höhe einer Textzeile in Pixel
+     * @param size Textgröße (setTextSize())
+     * @param font Schrift (Standard: eingebaute 5×7-Schrift)
+     */
+    constexpr int16_t height(uint8_t size, MonoFont font = CLASSIC) {
+        return font.yAdvance * size;
+    }
+
+    /**
+     * @brief X-Position für einen zentrierten Text
+     * @param text String-Literal (eine Zeile)
+     * @param size Textgröße
+     * @param areaX Linke Kante des Bereichs (Standard: Display)
+     * @param areaWidth Breite des Bereichs (Standard: Display)
+     * @param font Schrift (Standard: eingebaute 5×7-Schrift)
+     */
+    constexpr int16_t centerX(const char* text, uint8_t size,
+                              int16_t areaX = 0, int16_t areaWidth = Display::WIDTH,
+                              MonoFont font = CLASSIC) {
+        return areaX + (areaWidth - width(text, size, font)) / 2;
+    }
+
+    /**
+     * @brief Y-Position für eine vertikal zentrierte Textzeile (5×7-Schrift)
+     *
+     * Nur für die eingebaute Schrift: dort setzt setCursor() die Oberkante,
+     * bei GFX-Fonts die Grundlinie.
+     *
+     * @param size Textgröße
+     * @param areaY Obere Kante des Bereichs
+     * @param areaHeight Höhe des Bereichs
+     */
+    constexpr int16_t centerY(uint8_t size, int16_t areaY, int16_t areaHeight) {
+        return areaY + (areaHeight - height(size)) / 2;
+    }
+
+} // namespace TextMetrics
+
+// Wird zur Compile-Zeit ausgewertet: "Passe beenden" in Größe 2 = 13 × 12 Pixel
+static_assert(TextMetrics::width("Passe beenden", 2) == 156, "TextMetrics: Breite der 5x7-Schrift");
@@ -0,0 +1,415 @@
+/**
+ * @file TxQueue.cpp
+ * @brief Implementierung der nicht-blockierenden Sendewarteschlange
+ */
+
+#include "TxQueue.h"
+
+namespace {
+    constexpr uint8_t ALL_DISPLAYS = (uint8_t)((1 << RF::DISPLAY_COUNT) - 1);
+
+    // Alarm-Burst nur bei mehreren Anzeigen: mit einer einzigen ist die
+    // Abfrage mit ACK genauso schnell und bestätigt den Alarm gleich mit
+    constexpr uint8_t ALARM_BURST = (RF::DISPLAY_COUNT > 1) ? RF::ALARM_BURST_COPIES : 0;
+}
+
+TxQueue::TxQueue(RF24& radio)
+    : radio(radio)
+    , prepareHook(nullptr)
+    , completeHook(nullptr)
+    , count(0)
+    , busy(false)
+    , burstCopies(0)
+    , roundsLeft(0)
+    , nextPoll(0)
+    , pendingMask(0)
+    , polledMask(0)
+    , firstTicks(0)
+    , multicastTicks(0)
+    , target(0)
+    , startTicks(0)
+    , startMillis(0)
+    , addressByte(0)
+    , stateConfirmed(false)
+    , offlineMask(0)
+    , seq(0)
+    , airtimeUs(RF::TX_AIRTIME_US)
+    , retryGapUs((RF::RETRY_DELAY + 1) * 250U)
+    , resumeAt(0) {
+    memset(failStreak, 0, sizeof(failStreak));
+}
+
+void TxQueue::begin(PrepareHook prepare, CompleteHook complete) {
+    prepareHook = prepare;
+    completeHook = complete;
+}
+
+TxQueue::Priority TxQueue::priorityOf(RadioCommand command) {
+    switch (command) {
+        case CMD_ALARM:
+            return Priority::ALARM;
+        case CMD_PING:
+        case CMD_SYNC:
+        case CMD_RADIO_PROFILE:
+        case CMD_CHANNEL:
+            return Priority::BACKGROUND;
+        default:
+            return Priority::NORMAL;
+    }
+}
+
+bool TxQueue::enqueue(RadioCommand command, TxCallback callback, void* context) {
+    // Überholte Pakete entfernen (ihr Zustand geht mit dem neuen Paket raus)
+    for (uint8_t i = count; i > 0; i--) {
+        if (supersedes(command, entries[i - 1].command)) {
+            supersede(i - 1);
+        }
+    }
+
+    // Voll: ältestes Paket der niedrigsten Priorität verdrängen, falls unter der neuen (ALARM geht nie verloren)
+    if (count == RF::TX_QUEUE_SIZE) {
+        Priority priority = priorityOf(command);
+        uint8_t victim = RF::TX_QUEUE_SIZE;
+        for (uint8_t i = 0; i < count; i++) {
+            Priority queued = priorityOf(entries[i].command);
+            if (queued < priority && (victim == RF::TX_QUEUE_SIZE || queued < priorityOf(entries[victim].command))) {
+                victim = i;
+            }
+        }
+        if (victim == RF::TX_QUEUE_SIZE) {
+            DEBUG_PRINTLN(F("TX: Queue voll"));
+            return false;
+        }
+        supersede(victim);
+    }
+
+    Entry& entry = entries[count++];
+    entry.command = command;
+    entry.callback = callback;
+    entry.context = context;
+
+    // Alarm wartet nicht auf die laufende Zustellung (nur ein Handshake wird zu Ende gebracht,
+    // sonst schaltet der Empfänger womöglich allein um)
+    if (command == CMD_ALARM && busy && current.command != CMD_ALARM &&
+        current.command != CMD_RADIO_PROFILE && current.command != CMD_CHANNEL) {
+        preempt();
+    }
+
+    // Funkmodul frei: sofort starten (kein Warten auf den nächsten loop()-Durchlauf)
+    if (!busy) {
+        startNext();
+    }
+    return true;
+}
+
+void TxQueue::setTiming(uint16_t airtime, uint16_t retryGap) {
+    airtimeUs = airtime;
+    retryGapUs = retryGap;
+}
+
+void TxQueue::pause(uint16_t ms) {
+    resumeAt = millis() + ms;
+}
+
+bool TxQueue::anyOnline() const {
+    return (offlineMask & ALL_DISPLAYS) != ALL_DISPLAYS;
+}
+
+void TxQueue::update() {
+    if (busy) {
+        if (target == MULTICAST) {
+            // Burst ohne ACK: fertig, sobald alle Kopien den TX-FIFO verlassen haben
+            if (radio.isFifo(true, true)) {
+                transmissionDone(TX_SUCCESS);
+            } else if (millis() - startMillis >= Timing::RF_TRANSMIT_TIMEOUT_MS) {
+                transmissionDone(TX_ERROR);
+            }
+        } else {
+            uint8_t status = radio.update();
+
+            if (status & RF24_TX_DS) {
+                transmissionDone(TX_SUCCESS);
+            } else if (status & RF24_TX_DF) {
+                transmissionDone(TX_TIMEOUT);
+            } else if (millis() - startMillis >= Timing::RF_TRANSMIT_TIMEOUT_MS) {
+                transmissionDone(TX_ERROR);  // Keine Rückmeldung vom Funkmodul
+            }
+        }
+
+        if (busy) return;  // Nächste Kopie bzw. Abfrage läuft
+    }
+
+    startNext();
+}
+
+//=============================================================================
+// Private Hilfsfunktionen
+//=============================================================================
+
+void TxQueue::startNext() {
+    // Höchste Priorität zuerst, bei Gleichstand das älteste Paket
+    uint8_t next = count;
+    for (uint8_t i = 0; i < count; i++) {
+        if (next == count || priorityOf(entries[i].command) > priorityOf(entries[next].command)) {
+            next = i;
+        }
+    }
+    if (next == count) return;
+
+    // Pause (Funkprofil wechselt) - ein Alarm geht trotzdem raus, die Runden wiederholen ihn
+    if ((int32_t)(millis() - resumeAt) < 0 && entries[next].command != CMD_ALARM) return;
+
+    current = entries[next];
+    remove(next);
+
+    packet.command = static_cast<uint8_t>(current.command);
+    packet.seq = ++seq;
+    if (prepareHook) {
+        prepareHook(packet);  // Zustand erst jetzt eintragen (Restzeit möglichst aktuell)
+    }
+    packet.crc = calculateChecksum(&packet);
+
+    // Multicast für zeitkritische Kommandos an mehrere Anzeigen
+    bool alarm = current.command == CMD_ALARM;
+    bool multicast = RF::DISPLAY_COUNT > 1 && priorityOf(current.command) >= Priority::NORMAL;
+    burstCopies = alarm ? ALARM_BURST : multicast ? RF::MULTICAST_COPIES : 0;
+    roundsLeft = (multicast && !alarm) ? RF::POLL_ROUNDS : 1;
+    nextPoll = 0;
+    pendingMask = ALL_DISPLAYS;
+    polledMask = 0;
+
+    summary.command = current.command;
+    summary.seq = packet.seq;
+    summary.result = TX_TIMEOUT;
+    summary.retries = 0;
+    summary.rxTicks = 0;
+    summary.display = 0;
+    summary.confirmedMask = 0;
+    summary.multicast = false;
+
+    firstTicks = Timebase::now();
+    busy = true;
+    transmitNext();
+}
+
+void TxQueue::preempt() {
+    // Paket im Funkmodul verwerfen - sein Zustand geht mit dem Alarm raus
+    radio.flush_tx();
+    radio.clearStatusFlags();
+    busy = false;
+    DEBUG_PRINTLN(F("TX: Abbruch für Alarm"));
+
+    notifySuperseded(current);
+}
+
+bool TxQueue::transmitNext() {
+    if (burstCopies > 0) {
+        transmit(MULTICAST);
+        return true;
+    }
+
+    // Runden über die erreichbaren Anzeigen, offline Anzeigen zum Schluss und nur einmal
+    // (der Alarm fragt in jeder Runde alle ab, die noch nicht bestätigt haben)
+    bool alarm = current.command == CMD_ALARM;
+    for (;;) {
+        uint8_t candidates;
+        if (alarm) {
+            candidates = (roundsLeft > 0) ? pendingMask : 0;
+        } else {
+            candidates = pendingMask & ((roundsLeft > 0) ? (uint8_t)~offlineMask : (uint8_t)(offlineMask & ~polledMask));
+        }
+        for (; nextPoll < RF::DISPLAY_COUNT; nextPoll++) {
+            if (candidates & (1 << nextPoll)) {
+                transmit(nextPoll++);
+                return true;
+            }
+        }
+        if (roundsLeft == 0) break;
+        roundsLeft--;
+        nextPoll = 0;
+    }
+
+    // Alarm: nächste Runde (Burst + Abfragen), bis alle bestätigt haben
+    if (alarm && pendingMask != 0 &&
+        Timebase::now() - firstTicks < Timebase::fromMillis(Timing::ALARM_CONFIRM_MS)) {
+        burstCopies = ALARM_BURST;
+        roundsLeft = 1;
+        nextPoll = 0;
+        return transmitNext();
+    }
+    return false;
+}
+
+void TxQueue::transmit(uint8_t to) {
+    // TX-Adresse (und RX_ADDR_P0 für das ACK) nur bei Wechsel des Ziels neu schreiben
+    uint8_t address0 = (to == MULTICAST) ? MULTICAST_ADDRESS_BYTE : displayAddressByte(to);
+    if (address0 != addressByte) {
+        uint8_t address[5];
+        memcpy_P(address, RF::PIPE_ADDRESS, 5);
+        address[0] = address0;
+        radio.openWritingPipe(address);
+        addressByte = address0;
+    }
+
+    target = to;
+    startTicks = Timebase::now();
+    startMillis = millis();
+    if (to == MULTICAST) {
+        // Alle Kopien auf einmal in den TX-FIFO (NO_ACK), CE bleibt high: kein
+        // Einschwingen zwischen den Kopien. Der nächste startWrite() nimmt CE zurück.
+        for (uint8_t i = 0; i < burstCopies; i++) {
+            radio.writeFast(&packet, sizeof(RadioPacket), true);
+        }
+        burstCopies = 0;
+    } else {
+        radio.startWrite(&packet, sizeof(RadioPacket), false);
+    }
+}
+
+void TxQueue::transmissionDone(TransmissionResult result) {
+    uint8_t retries = 0;
+    if (result == TX_SUCCESS) {
+        retries = radio.getARC();
+    } else {
+        radio.flush_tx();  // Paket nicht im FIFO liegen lassen
+    }
+    radio.clearStatusFlags();
+
+    if (target == MULTICAST) {
+        // Ohne ACK: TX_DS heißt nur "gesendet"
+        if (result == TX_SUCCESS && !summary.multicast) {
+            summary.multicast = true;
+            multicastTicks = startTicks;
+        }
+    } else {
+        TxReport report;
+        report.command = current.command;
+        report.seq = packet.seq;
+        report.result = result;
+        report.retries = 0;
+        report.rxTicks = 0;
+        report.display = target;
+        report.confirmedMask = 0;
+        report.multicast = summary.multicast;
+
+        uint32_t elapsed = Timebase::now() - startTicks;
+        report.rttTicks = (elapsed > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed;
+
+        if (result == TX_SUCCESS) {
+            report.retries = retries;
+            if (summary.multicast) {
+                // Meist kam schon die erste Multicast-Kopie an (der Empfänger meldet den ersten Empfang)
+                report.rxTicks = multicastTicks + Timebase::fromMicros(airtimeUs);
+            } else {
+                // Empfangen wurde der letzte Versuch: jeder vorherige kostet Sendezeit + Retry-Abstand
+                report.rxTicks = startTicks + Timebase::fromMicros(
+                    airtimeUs + (uint32_t)retries * (airtimeUs + retryGapUs));
+            }
+        }
+
+        stateConfirmed = false;
+        if (completeHook) {
+            completeHook(report);
+        }
+
+        // Erreichbarkeit erst nach dem Hook anpassen (er sieht den Stand vor dieser Abfrage)
+        uint8_t bit = 1 << target;
+        polledMask |= bit;
+        if (result == TX_SUCCESS) {
+            // Alarm: erst bestätigt, wenn die ACK-Payload den Alarm meldet (sonst nächste Runde)
+            if (current.command != CMD_ALARM || stateConfirmed) {
+                pendingMask &= ~bit;
+                if (summary.confirmedMask == 0 || target == 0) {
+                    summary.rxTicks = report.rxTicks;  // Hauptanzeige, sonst die erste
+                }
+                summary.confirmedMask |= bit;
+                if (retries > summary.retries) {
+                    summary.retries = retries;
+                }
+            }
+            failStreak[target] = 0;
+            if (offlineMask & bit) {
+                offlineMask &= ~bit;
+                DEBUG_PRINT(F("TX: Anzeige online "));
+                DEBUG_PRINTLN(target);
+            }
+        } else {
+            summary.result = result;
+            if (failStreak[target] < 255) {
+                failStreak[target]++;
+            }
+            if (failStreak[target] >= RF::DISPLAY_OFFLINE_FAILS && !(offlineMask & bit)) {
+                offlineMask |= bit;
+                DEBUG_PRINT(F("TX: Anzeige offline "));
+                DEBUG_PRINTLN(target);
+            }
+        }
+    }
+
+    if (!transmitNext()) {
+        finishDelivery();
+    }
+}
+
+void TxQueue::finishDelivery() {
+    // Erfolg: mindestens eine Bestätigung und keine erreichbare Anzeige mehr offen
+    bool delivered = summary.confirmedMask != 0 && (pendingMask & ~offlineMask) == 0;
+    if (delivered) {
+        summary.result = TX_SUCCESS;
+    } else {
+        summary.retries = 0;
+        summary.rxTicks = 0;
+    }
+
+    uint32_t elapsed = Timebase::now() - firstTicks;
+    summary.rttTicks = (elapsed > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed;
+    busy = false;
+
+    #if DEBUG_ENABLED
+    if (current.command == CMD_ALARM) {
+        // Latenz Tastendruck-Kommando → Bestätigung durch die Anzeige(n)
+        DEBUG_PRINT(delivered ? F("TX: Alarm bestaetigt us: ") : F("TX: Alarm unbestaetigt us: "));
+        DEBUG_PRINTLN(elapsed * (1000000UL / Timebase::TICKS_PER_SECOND));
+    }
+    #endif
+
+    if (current.callback) {
+        current.callback(current.context, summary);
+    }
+}
+
+void TxQueue::remove(uint8_t index) {
+    for (uint8_t i = index; i + 1 < count; i++) {
+        entries[i] = entries[i + 1];
+    }
+    count--;
+}
+
+void TxQueue::supersede(uint8_t index) {
+    Entry entry = entries[index];
+    remove(index);
+    notifySuperseded(entry);
+}
+
+void TxQueue::notifySuperseded(const Entry& entry) {
+    if (entry.callback) {
+        TxReport report;
+        report.command = entry.command;
+        report.seq = 0;
+        report.result = TX_SUPERSEDED;
+        report.retries = 0;
+        report.rxTicks = 0;
+        report.rttTicks = 0;
+        report.display = 0;
+        report.confirmedMask = 0;
+        report.multicast = false;
+        entry.callback(entry.context, report);
+    }
+}
+
+bool TxQueue::supersedes(RadioCommand newer, RadioCommand queued) const {
+    // SYNC trägt nur den Zustand: jedes neuere Paket außer PING ersetzt es
+    if (queued == CMD_SYNC) return newer != CMD_PING;
+    if (queued == CMD_PING) return newer == CMD_PING;
+    return isGroupCommand(queued) && isGroupCommand(newer);
+}
@@ -0,0 +1,238 @@
+/**
+ * @file TxQueue.h
+ * @brief Nicht-blockierende Sendewarteschlange für den NRF24L01
+ *
+ * radio.write() wartet auf ACK oder alle Retries (bis zu 15 × 1.5ms) und
+ * hält dabei Tasten und Display an. Die TxQueue startet ein Paket mit
+ * radio.startWrite() und fragt in update() nur noch die Status-Flags ab -
+ * loop() läuft währenddessen weiter.
+ *
+ * Mit mehreren Anzeigen (RF::DISPLAY_COUNT > 1) besteht eine Zustellung aus
+ * Multicast-Kopien ohne ACK und Einzelabfragen pro Anzeige - siehe TxQueue.
+ */
+
+#pragma once
+
+#include <RF24.h>
+#include "Config.h"
+#include "Commands.h"
+#include "Timebase.h"
+
+/**
+ * @brief Ergebnis einer Übertragung (an Callback und Complete-Hook)
+ */
+struct TxReport {
+    RadioCommand command;       // Gesendetes Kommando
+    uint8_t seq;                // Sequenznummer des Pakets (0 bei TX_SUPERSEDED)
+    TransmissionResult result;  // TX_SUCCESS, TX_TIMEOUT, TX_ERROR oder TX_SUPERSEDED
+    uint8_t retries;            // Benötigte Retries (ARC, nur bei TX_SUCCESS; Callback: Maximum)
+    uint32_t rxTicks;           // Geschätzter Empfangszeitpunkt beim Empfänger (lokale Ticks)
+    uint16_t rttTicks;          // Sendestart bis erkannte Rückmeldung (Ticks, max. 65535)
+    uint8_t display;            // Abgefragte Anzeige (Complete-Hook, im Callback immer 0)
+    uint8_t confirmedMask;      // Anzeigen mit ACK (Bit = Anzeige-ID, nur im Callback)
+    bool multicast;             // Vorher per Multicast gesendet (rxTicks gilt für die erste Kopie)
+};
+
+static_assert(RF::DISPLAY_COUNT >= 1 && RF::DISPLAY_COUNT <= MAX_DISPLAYS, "RF::DISPLAY_COUNT: 1 bis MAX_DISPLAYS");
+
+/**
+ * @brief Callback pro Kommando (wird genau einmal aufgerufen)
+ * @param context Zeiger aus enqueue() (z.B. this)
+ * @param report Ergebnis der Übertragung
+ */
+typedef void (*TxCallback)(void* context, const TxReport& report);
+
+/**
+ * @brief Warteschlange mit Prioritäten für alle Pakete an den Empfänger
+ *
+ * - Es ist immer höchstens ein Paket im Funkmodul (TX-FIFO), der Rest wartet hier.
+ * - Reihenfolge: ALARM vor Bedien-Kommandos vor PING/SYNC, sonst in Einreihungs-Reihenfolge.
+ * - Jedes Paket trägt den vollständigen Zustand (Protokoll v3). Ein wartendes
+ *   SYNC wird deshalb von jedem neuen Kommando überholt, ein wartendes
+ *   Gruppen-Kommando vom nächsten Gruppen-Kommando, ein wartender PING vom
+ *   nächsten PING (Ergebnis TX_SUPERSEDED).
+ * - CMD_ALARM bricht eine laufende Zustellung ab (flush_tx, Ergebnis
+ *   TX_SUPERSEDED - der Zustand geht mit dem Alarm raus) und ignoriert pause().
+ *   Bei mehreren Anzeigen füllen pro Runde RF::ALARM_BURST_COPIES Kopien ohne
+ *   ACK den TX-FIFO (writeFast, Multicast-Adresse), danach wird jede Anzeige
+ *   abgefragt, die den Alarm noch nicht bestätigt hat. Mit einer Anzeige
+ *   besteht die Runde nur aus der Abfrage (ACK, ohne Burst). Bestätigt
+ *   ist er erst, wenn ihre ACK-Payload den Zustand nach dem Alarm-Paket meldet
+ *   (confirm()). Die Runden laufen bis dahin, höchstens Timing::ALARM_CONFIRM_MS.
+ *
+ * Mehrere Anzeigen (RF::DISPLAY_COUNT > 1), pro Paket (gleiche Sequenznummer):
+ * 1. Zeitkritische Kommandos (ab Priority::NORMAL): RF::MULTICAST_COPIES
+ *    Kopien ohne ACK an die Multicast-Adresse (ein Burst im TX-FIFO) - alle
+ *    Anzeigen schalten gleichzeitig, unabhängig von ihrer Anzahl.
+ * 2. Jede Anzeige einzeln mit ACK abfragen, nur solange sie nicht bestätigt hat.
+ *    Zeitkritische Kommandos: bis zu RF::POLL_ROUNDS Runden für die Nachzügler.
+ * 3. Anzeigen mit RF::DISPLAY_OFFLINE_FAILS Fehlschlägen in Folge gelten als
+ *    offline: sie werden zuletzt und nur einmal pro Paket abgefragt und
+ *    zählen nicht für das Ergebnis (bis sie wieder bestätigen).
+ * Der Complete-Hook kommt nach jeder Abfrage (TxReport::display), der
+ * Callback einmal: TX_SUCCESS, wenn alle erreichbaren Anzeigen bestätigt haben.
+ * Während einer Zustellung wird kein anderes Paket gesendet (außer ALARM, siehe oben).
+ *
+ * Callbacks und Hooks dürfen selbst keine Pakete einreihen.
+ *
+ * Usage:
+ * @code
+ * TxQueue txQueue(radio);
+ * txQueue.begin(preparePacket, packetComplete);
+ *
+ * txQueue.enqueue(CMD_PING, onPingResult, this);
+ *
+ * // in loop():
+ * txQueue.update();
+ * @endcode
+ */
+class TxQueue {
+public:
+    /**
+     * @brief Wird direkt vor dem Senden aufgerufen (Zustand eintragen)
+     * @param packet Paket mit command und seq, crc wird danach berechnet
+     */
+    typedef void (*PrepareHook)(RadioPacket& packet);
+
+    /**
+     * @brief Wird nach jeder Abfrage einer Anzeige vor dem Callback aufgerufen (ACK-Payload auswerten)
+     * @param report Ergebnis der Abfrage (nie TX_SUPERSEDED), TxReport::display = Anzeige
+     */
+    typedef void (*CompleteHook)(const TxReport& report);
+
+    /**
+     * @brief Priorität eines Kommandos
+     */
+    enum class Priority : uint8_t {
+        BACKGROUND = 0,  // CMD_PING, CMD_SYNC, CMD_RADIO_PROFILE, CMD_CHANNEL
+        NORMAL = 1,      // Bedien-Kommandos
+        ALARM = 2        // CMD_ALARM
+    };
+
+    explicit TxQueue(RF24& radio);
+
+    /**
+     * @brief Setzt die Hooks (Radio muss bereits initialisiert sein)
+     * @param prepare Trägt den Zustand ins Paket ein
+     * @param complete Wertet das Ergebnis aus (z.B. ACK-Payload lesen)
+     */
+    void begin(PrepareHook prepare, CompleteHook complete);
+
+    /**
+     * @brief Reiht ein Kommando ein (startet sofort, wenn das Funkmodul frei ist)
+     * @param command RadioCommand
+     * @param callback Wird mit dem Ergebnis aufgerufen (nullptr: kein Callback)
+     * @param context Wird an den Callback durchgereicht
+     * @return false wenn die Warteschlange voll ist (kein Callback)
+     */
+    bool enqueue(RadioCommand command, TxCallback callback, void* context);
+
+    /**
+     * @brief Update-Funktion (in loop() aufrufen): Status-Flags prüfen, nächstes Paket starten
+     */
+    void update();
+
+    /**
+     * @brief Nichts in Übertragung und nichts wartend?
+     */
+    bool isIdle() const { return !busy && count == 0; }
+
+    /**
+     * @brief Sendezeiten des aktuellen Funkprofils (für TxReport::rxTicks)
+     * @param airtimeUs Dauer eines Sendeversuchs bis zum Empfang
+     * @param retryGapUs Abstand zwischen zwei Versuchen (ARD)
+     */
+    void setTiming(uint16_t airtimeUs, uint16_t retryGapUs);
+
+    /**
+     * @brief Startet für eine Weile kein neues Paket (z.B. während das Funkprofil wechselt)
+     * @param ms Pause ab jetzt in Millisekunden
+     */
+    void pause(uint16_t ms);
+
+    /**
+     * @brief Funkmodul wurde (neu) initialisiert: TX-Adresse vor dem nächsten Paket setzen
+     */
+    void radioReset() { addressByte = 0; }
+
+    /**
+     * @brief Antwortet eine Anzeige (weniger als RF::DISPLAY_OFFLINE_FAILS Fehlschläge in Folge)?
+     * @param display Anzeige-ID
+     */
+    bool isOnline(uint8_t display) const { return !(offlineMask & (1 << display)); }
+
+    /**
+     * @brief Antwortet mindestens eine Anzeige?
+     */
+    bool anyOnline() const;
+
+    /**
+     * @brief Complete-Hook: die ACK-Payload der abgefragten Anzeige meldet den
+     *        Zustand nach genau diesem Paket (AckPayload::seq == TxReport::seq)
+     *
+     * Nur für CMD_ALARM nötig - ohne diese Bestätigung gilt ein ACK dort nicht.
+     */
+    void confirm() { stateConfirmed = true; }
+
+    /**
+     * @brief Priorität eines Kommandos
+     */
+    static Priority priorityOf(RadioCommand command);
+
+private:
+    struct Entry {
+        RadioCommand command;
+        TxCallback callback;
+        void* context;
+    };
+
+    RF24& radio;
+    PrepareHook prepareHook;
+    CompleteHook completeHook;
+
+    Entry entries[RF::TX_QUEUE_SIZE];  // Wartend, in Einreihungs-Reihenfolge
+    uint8_t count;
+
+    static constexpr uint8_t MULTICAST = 0xFF;  // Ziel: alle Anzeigen ohne ACK
+
+    // Paket in Zustellung (alle Kopien und Abfragen senden dasselbe Paket)
+    bool busy;
+    Entry current;
+    RadioPacket packet;
+    TxReport summary;       // Ergebnis für den Callback (wird pro Abfrage ergänzt)
+    uint8_t burstCopies;    // Kopien des nächsten Multicast-Bursts (0 = keiner)
+    uint8_t roundsLeft;     // Abfragerunden (0 = nur noch offline Anzeigen)
+    uint8_t nextPoll;       // Nächste Anzeige der laufenden Runde
+    uint8_t pendingMask;    // Anzeigen ohne ACK
+    uint8_t polledMask;     // Schon abgefragte Anzeigen
+    uint32_t firstTicks;    // Start der ersten Übertragung (rttTicks im Callback)
+    uint32_t multicastTicks;  // Start der ersten gesendeten Multicast-Kopie
+
+    // Übertragung im Funkmodul
+    uint8_t target;         // Anzeige-ID oder MULTICAST
+    uint32_t startTicks;    // Sendestart (Timebase-Ticks)
+    uint32_t startMillis;   // Sendestart (millis, für den Timeout)
+    uint8_t addressByte;    // Byte 0 der eingestellten TX-Adresse (0 = neu setzen)
+    bool stateConfirmed;    // confirm() im Complete-Hook dieser Abfrage
+
+    // Erreichbarkeit der Anzeigen
+    uint8_t offlineMask;
+    uint8_t failStreak[RF::DISPLAY_COUNT];  // Fehlschläge in Folge
+
+    uint8_t seq;            // Sequenznummer des zuletzt gestarteten Pakets
+
+    uint16_t airtimeUs;     // Sendezeit pro Versuch (Funkprofil)
+    uint16_t retryGapUs;    // Abstand zwischen Versuchen (ARD)
+    uint32_t resumeAt;      // Vor diesem Zeitpunkt kein neues Paket (millis, pause())
+
+    void startNext();
+    void preempt();
+    bool transmitNext();
+    void transmit(uint8_t to);
+    void transmissionDone(TransmissionResult result);
+    void finishDelivery();
+    void remove(uint8_t index);
+    void supersede(uint8_t index);
+    static void notifySuperseded(const Entry& entry);
+    bool supersedes(RadioCommand newer, RadioCommand queued) const;
+};
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""
+Wandelt Bilder in das RLE/Paletten-Format von Adafruit_SPITFT::drawRLEImage()
+
+Rohe RGB565-Bitmaps passen nicht in die 32 KB Flash des Nano (ein 40x40
+Logo wären 3,2 KB). Das RLE-Format speichert bis zu 16 Farben als Palette
+und das Bild als Läufe gleicher Palettenindizes (ein Byte pro Lauf von
+1-15 Pixeln, zwei Bytes für 16-271 Pixel). Der Decoder streamt die Läufe
+mit writeColor() in ein einziges Adressfenster.
+
+Format (PROGMEM):
+    uint8_t  Breite, Höhe (je 1-255)
+    uint8_t  Anzahl Farben (1-16)
+    uint16_t Palette (RGB565, Low-Byte zuerst)
+    Läufe:   Low-Nibble = Palettenindex, High-Nibble = Länge - 1;
+             High-Nibble 15: Länge = 16 + nächstes Byte
+
+Eingabe:
+    XPM (Textformat, z.B. aus GIMP exportiert) - die Reihenfolge der Farben
+    in der XPM-Tabelle ist der Palettenindex. Mehrere Indizes dürfen
+    dieselbe Farbe haben: der Sketch kann sie zur Laufzeit per eigener
+    Palette umfärben (z.B. Füllstand des Batterie-Icons).
+    PNG/GIF/BMP nur mit Pillow (pip install pillow), Palette in der
+    Reihenfolge des ersten Auftretens.
+
+Usage:
+    python3 rleimage.py -o ../Images.h images/logo.xpm images/battery.xpm images/link.xpm
+"""
+
+import argparse
+import os
+import re
+import sys
+
+MAX_COLORS = 16
+MAX_SIZE = 255
+SHORT_RUN = 15          # Längste Lauflänge in einem Byte
+LONG_RUN = 16 + 255     # Längste Lauflänge mit Zusatzbyte
+
+NAMED_COLORS = {
+    'black': (0, 0, 0),
+    'white': (255, 255, 255),
+    'red': (255, 0, 0),
+    'green': (0, 255, 0),
+    'blue': (0, 0, 255),
+    'yellow': (255, 255, 0),
+    'gray': (128, 128, 128),
+    'grey': (128, 128, 128),
+}
+
+
+def rgb565(rgb):
+    r, g, b = rgb
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def parse_color(value, source):
+    value = value.strip().lower()
+    if value.startswith('#'):
+        digits = value[1:]
+        if len(digits) == 6:
+            return tuple(int(digits[i:i + 2], 16) for i in (0, 2, 4))
+        if len(digits) == 12:  # #RRRRGGGGBBBB
+            return tuple(int(digits[i:i + 4], 16) >> 8 for i in (0, 4, 8))
+    if value in NAMED_COLORS:
+        return NAMED_COLORS[value]
+    raise ValueError('%s: Farbe "%s" nicht unterstützt (None/Transparenz gibt es nicht)' % (source, value))
+
+
+def load_xpm(path):
+    """Liefert (Breite, Höhe, Palette [RGB], Pixel [Index])"""
+    with open(path) as f:
+        strings = re.findall(r'"((?:[^"\\]|\\.)*)"', f.read())
+
+    width, height, count, cpp = (int(v) for v in strings[0].split()[:4])
+    chars = {}
+    palette = []
+    for line in strings[1:1 + count]:
+        key = line[:cpp]
+        fields = line[cpp:].split()
+        if 'c' not in fields:
+            raise ValueError('%s: Farbe "%s" ohne Farbwert (c)' % (path, key))
+        chars[key] = len(palette)
+        palette.append(parse_color(fields[fields.index('c') + 1], path))
+
+    pixels = []
+    for row in strings[1 + count:1 + count + height]:
+        if len(row) != width * cpp:
+            raise ValueError('%s: Zeile hat %d statt %d Zeichen' % (path, len(row), width * cpp))
+        pixels.extend(chars[row[i:i + cpp]] for i in range(0, len(row), cpp))
+    return width, height, palette, pixels
+
+
+def load_pillow(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit('%s: für dieses Format wird Pillow benötigt (pip install pillow) - oder XPM verwenden' % path)
+
+    image = Image.open(path).convert('RGB')
+    palette = []
+    pixels = []
+    for rgb in image.getdata():
+        if rgb not in palette:
+            palette.append(rgb)
+        pixels.append(palette.index(rgb))
+    return image.width, image.height, palette, pixels
+
+
+def encode(pixels):
+    """Läufe gleicher Palettenindizes (über Zeilenenden hinweg)"""
+    data = []
+    i = 0
+    while i < len(pixels):
+        index = pixels[i]
+        run = 1
+        while i + run < len(pixels) and pixels[i + run] == index and run < LONG_RUN:
+            run += 1
+        if run <= SHORT_RUN:
+            data.append(((run - 1) << 4) | index)
+        else:
+            data.append(0xF0 | index)
+            data.append(run - 16)
+        i += run
+    return data
+
+
+def convert(path):
+    name = re.sub(r'\W', '_', os.path.splitext(os.path.basename(path))[0]).upper()
+    if path.lower().endswith('.xpm'):
+        width, height, palette, pixels = load_xpm(path)
+    else:
+        width, height, palette, pixels = load_pillow(path)
+
+    if not (1 <= width <= MAX_SIZE and 1 <= height <= MAX_SIZE):
+        sys.exit('%s: %dx%d Pixel, höchstens %dx%d' % (path, width, height, MAX_SIZE, MAX_SIZE))
+    if len(palette) > MAX_COLORS:
+        sys.exit('%s: %d Farben, höchstens %d' % (path, len(palette), MAX_COLORS))
+
+    data = [width, height, len(palette)]
+    for rgb in palette:
+        color = rgb565(rgb)
+        data += [color & 0xFF, color >> 8]
+    data += encode(pixels)
+    return name, width, height, palette, data
+
+
+def write_header(out, images, command):
+    lines = [
+        '/**',
+        ' * @file %s' % os.path.basename(out),
+        ' * @brief RLE/Paletten-Bilder für Adafruit_SPITFT::drawRLEImage()',
+        ' *',
+        ' * Generiert mit tools/rleimage.py - nicht von Hand bearbeiten:',
+        ' *     %s' % command,
+        ' */',
+        '',
+        '#pragma once',
+        '',
+        '#include <Arduino.h>',
+        '',
+        'namespace Images {',
+    ]
+    for name, width, height, palette, data in images:
+        raw = width * height * 2
+        lines += [
+            '',
+            '    // %dx%d Pixel, %d Farben: %d Bytes (RGB565: %d Bytes)' % (width, height, len(palette), len(data), raw),
+            '    constexpr uint8_t %s_WIDTH = %d;' % (name, width),
+            '    constexpr uint8_t %s_HEIGHT = %d;' % (name, height),
+            '    constexpr uint8_t %s_COLORS = %d;' % (name, len(palette)),
+            '    const uint8_t %s[%d] PROGMEM = {' % (name, len(data)),
+        ]
+        for i in range(0, len(data), 16):
+            chunk = ', '.join('0x%02X' % b for b in data[i:i + 16])
+            lines.append('        %s%s' % (chunk, ',' if i + 16 < len(data) else ''))
+        lines.append('    };')
+    lines += ['', '} // namespace Images', '']
+
+    # Sender-Quellen haben CRLF-Zeilenenden
+    with open(out, 'w', newline='\r\n') as f:
+        f.write('\n'.join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Bilder in das RLE/Paletten-Format für drawRLEImage() wandeln')
+    parser.add_argument('-o', '--output', required=True, help='Erzeugter Header (z.B. ../Images.h)')
+    parser.add_argument('images', nargs='+', help='XPM-Dateien (PNG/GIF/BMP mit Pillow)')
+    args = parser.parse_args()
+
+    images = [convert(path) for path in args.images]
+    command = 'python3 rleimage.py -o %s %s' % (args.output, ' '.join(args.images))
+    write_header(args.output, images, command)
+
+    for name, width, height, palette, data in images:
+        print('%-10s %3dx%-3d %2d Farben %5d Bytes (RGB565: %d)' % (name, width, height, len(palette), len(data), width * height * 2))
+
+
+if __name__ == '__main__':
+    main()
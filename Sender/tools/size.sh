@@ -0,0 +1,24 @@
+#!/bin/sh
+#
+# Flash- und SRAM-Verbrauch des Senders für den Arduino Nano
+#
+# Baut den Sketch mit und ohne Debug-Ausgaben (DEBUG_ENABLED) und gibt die
+# Größenangaben von arduino-cli aus. Grenzen (ATmega328P mit Optiboot):
+# 30720 Bytes Flash, 2048 Bytes SRAM.
+#
+# Usage:
+#     cd tools && ./size.sh
+#     FQBN=arduino:avr:nano:cpu=atmega328old ./size.sh   # Nano mit altem Bootloader
+#
+set -e
+
+FQBN=${FQBN:-arduino:avr:nano}
+SKETCH=$(cd "$(dirname "$0")/.." && pwd)
+
+for debug in 1 0; do
+    echo "DEBUG_ENABLED=$debug:"
+    arduino-cli compile --fqbn "$FQBN" \
+        --libraries "$SKETCH/../libraries" \
+        --build-property "compiler.cpp.extra_flags=-DDEBUG_ENABLED=$debug" \
+        "$SKETCH" | grep -E "Sketch uses|Global variables"
+done
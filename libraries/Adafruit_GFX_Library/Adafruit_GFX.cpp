@@ -1349,6 +1349,20 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 
   } // End classic vs custom font
 }
+/**************************************************************************/
+/*!
+    @brief  Locate a character of the 'classic' built-in font
+    @param  c  The 8-bit font-indexed character (likely ascii)
+    @returns Pointer (PROGMEM) to the 5 column bytes of the glyph, bit 0 of
+             each byte is the top row
+*/
+/**************************************************************************/
+const uint8_t *Adafruit_GFX::classicGlyph(unsigned char c) const {
+  if (!_cp437 && (c >= 176))
+    c++; // Handle 'classic' charset behavior
+  return (const uint8_t *)&font[c * 5];
+}
+
 /**************************************************************************/
 /*!
     @brief  Print one byte/character of data, used to support print()
@@ -105,6 +105,12 @@ static const struct {
 #define TFT_SOFT_SPI 1 ///< Display interface = software SPI
 #define TFT_PARALLEL 2 ///< Display interface = 8- or 16-bit parallel
 
+#if defined(SPITFT_COUNT_BYTES)
+#define SPITFT_COUNT(n) byteCount += (n) ///< Add to getByteCount()
+#else
+#define SPITFT_COUNT(n) ///< Byte counting disabled
+#endif
+
 // CONSTRUCTORS ------------------------------------------------------------
 
 /*!
@@ -1213,6 +1219,8 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
   if (!len)
     return; // Avoid 0-byte transfers
 
+  SPITFT_COUNT(len * 2);
+
   uint8_t hi = color >> 8, lo = color;
 
 #if defined(ESP32) // ESP32 has a special SPI pixel-writing function...
@@ -1918,6 +1926,149 @@ void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
   endWrite();
 }
 
+/*!
+    @brief  Draw a run-length encoded palette image stored in PROGMEM.
+            An image that lies completely on the display is streamed into
+            a single address window: one writeColor() per run of equal
+            color (neighbouring runs of the same color are merged, runs
+            continue across row ends). Clipped images fall back to one
+            writeFastHLine() per run and row.
+
+            Format (all bytes in PROGMEM, create with a converter such as
+            the sketch's tools/rleimage.py):
+            - uint8_t width, uint8_t height (1-255 pixels each)
+            - uint8_t palette size (1-16 colors)
+            - palette: 16-bit 5-6-5 colors, low byte first
+            - runs, row by row from the top left corner until width *
+              height pixels are covered. One byte per run: low nibble =
+              palette index, high nibble = length - 1 (1-15 pixels). A
+              high nibble of 15 means 16 + the next byte (16-271 pixels).
+    @param  x        Top left corner horizontal coordinate.
+    @param  y        Top left corner vertical coordinate.
+    @param  image    Pointer to the image data in PROGMEM.
+    @param  palette  Optional palette in RAM replacing the stored one
+                     (at least as many entries). Lets one image show
+                     dynamic states, e.g. a bar per palette index.
+*/
+void Adafruit_SPITFT::drawRLEImage(int16_t x, int16_t y, const uint8_t *image,
+                                   const uint16_t *palette) {
+  int16_t w = pgm_read_byte(&image[0]);
+  int16_t h = pgm_read_byte(&image[1]);
+  uint8_t colors = pgm_read_byte(&image[2]) & 0x1F;
+  const uint8_t *data = &image[3 + 2 * colors];
+
+  if ((x >= _width) || (y >= _height) || (x + w <= 0) || (y + h <= 0))
+    return;
+
+  uint16_t lut[16];
+  for (uint8_t i = 0; i < 16; i++) {
+    if (i >= colors)
+      lut[i] = 0;
+    else if (palette)
+      lut[i] = palette[i];
+    else
+      lut[i] = pgm_read_byte(&image[3 + 2 * i]) |
+               (pgm_read_byte(&image[4 + 2 * i]) << 8);
+  }
+
+  bool clipped = (x < 0) || (y < 0) || (x + w > _width) || (y + h > _height);
+  uint32_t left = (uint32_t)w * h; // Pixels still to decode
+  uint16_t pending = 0;            // Merged run not yet sent (unclipped)
+  uint16_t pendingColor = 0;
+  int16_t px = 0, py = 0;          // Position in the image (clipped)
+
+  startWrite();
+  if (!clipped)
+    setAddrWindow(x, y, w, h);
+  while (left) {
+    uint8_t b = pgm_read_byte(data++);
+    uint16_t color = lut[b & 0x0F];
+    uint16_t run = (b >> 4) + 1;
+    if (run == 16)
+      run += pgm_read_byte(data++);
+    if (run > left)
+      run = left; // Corrupt data: never write past the window
+    left -= run;
+
+    if (!clipped) {
+      if (pending && (color != pendingColor)) {
+        writeColor(pendingColor, pending);
+        pending = 0;
+      }
+      pendingColor = color;
+      pending += run;
+      continue;
+    }
+
+    while (run) { // Split the run at row ends, writeFastHLine() clips
+      int16_t n = min((int16_t)run, (int16_t)(w - px));
+      writeFastHLine(x + px, y + py, n, color);
+      run -= n;
+      px += n;
+      if (px == w) {
+        px = 0;
+        py++;
+      }
+    }
+  }
+  if (pending)
+    writeColor(pendingColor, pending);
+  endWrite();
+}
+
+/*!
+    @brief  Draw a single character. Opaque characters of the classic
+            font (bg != color) that lie completely on the display are
+            streamed into one address window per 6x8 glyph cell: rows top
+            to bottom, every font pixel repeated size_x times per row and
+            every row size_y times. This replaces one address window per
+            font pixel (a writeFillRect() each at larger sizes) and
+            overwrites the old cell, so no separate fillRect() is needed to
+            clear it. Transparent text, custom fonts and clipped characters
+            use Adafruit_GFX::drawChar().
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  c       The 8-bit font-indexed character (likely ascii).
+    @param  color   16-bit 5-6-5 text color.
+    @param  bg      16-bit 5-6-5 background color (same as color:
+                    transparent).
+    @param  size_x  Font magnification level in X-axis.
+    @param  size_y  Font magnification level in Y-axis.
+*/
+void Adafruit_SPITFT::drawChar(int16_t x, int16_t y, unsigned char c,
+                               uint16_t color, uint16_t bg, uint8_t size_x,
+                               uint8_t size_y) {
+  int16_t w = 6 * size_x, h = 8 * size_y;
+  if (gfxFont || (bg == color) || (x < 0) || (y < 0) || (x + w > _width) ||
+      (y + h > _height)) {
+    Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+    return;
+  }
+
+  const uint8_t *glyph = classicGlyph(c);
+  uint8_t column[6];
+  for (uint8_t i = 0; i < 5; i++)
+    column[i] = pgm_read_byte(&glyph[i]);
+  column[5] = 0; // Spacing column
+
+  startWrite();
+  setAddrWindow(x, y, w, h);
+  for (uint8_t mask = 1; mask; mask <<= 1) { // Font rows, top to bottom
+    for (uint8_t sy = 0; sy < size_y; sy++) {
+      // Runs of equal color within the row, each pixel size_x wide
+      for (uint8_t i = 0; i < 6;) {
+        bool on = column[i] & mask;
+        uint8_t run = 1;
+        while ((i + run < 6) && (!(column[i + run] & mask) == !on))
+          run++;
+        writeColor(on ? color : bg, (uint32_t)run * size_x);
+        i += run;
+      }
+    }
+  }
+  endWrite();
+}
+
 // -------------------------------------------------------------------------
 // Miscellaneous class member functions that don't draw anything.
 
@@ -2163,6 +2314,7 @@ inline void Adafruit_SPITFT::SPI_END_TRANSACTION(void) {
     @param  b  8-bit value to write.
 */
 void Adafruit_SPITFT::spiWrite(uint8_t b) {
+  SPITFT_COUNT(1);
   if (connection == TFT_HARD_SPI) {
 #if defined(__AVR__)
     AVR_WRITESPI(b);
@@ -2447,6 +2599,7 @@ inline bool Adafruit_SPITFT::SPI_MISO_READ(void) {
     @param  w  16-bit value to write.
 */
 void Adafruit_SPITFT::SPI_WRITE16(uint16_t w) {
+  SPITFT_COUNT(2);
   if (connection == TFT_HARD_SPI) {
 #if defined(__AVR__)
     AVR_WRITESPI(w >> 8);
@@ -2503,6 +2656,7 @@ void Adafruit_SPITFT::SPI_WRITE16(uint16_t w) {
     @param  l  32-bit value to write.
 */
 void Adafruit_SPITFT::SPI_WRITE32(uint32_t l) {
+  SPITFT_COUNT(4);
   if (connection == TFT_HARD_SPI) {
 #if defined(__AVR__)
     AVR_WRITESPI(l >> 24);
@@ -92,6 +92,15 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 #include <Adafruit_ZeroDMA.h>
 #endif
 
+// Count every byte sent to the display (commands, parameters, pixel data),
+// see getByteCount(). Useful to compare redraw strategies; costs a few
+// cycles per transfer. DMA transfers are not counted. Off by default: enable
+// it for benchmark or debug builds with a compiler flag, so the library is
+// built with it too (a #define in the sketch does not reach Adafruit_SPITFT.cpp):
+//   arduino-cli compile --build-property
+//     "compiler.cpp.extra_flags=-DSPITFT_COUNT_BYTES" ...
+//   PlatformIO: build_flags = -DSPITFT_COUNT_BYTES
+
 // This is kind of a kludge. Needed a way to disambiguate the software SPI
 // and parallel constructors via their argument lists. Originally tried a
 // bool as the first argument to the parallel constructor (specifying 8-bit
@@ -247,6 +256,16 @@ public:
   // user code, so it's public...
   bool dmaBusy(void) const; // true if DMA is used and busy, false otherwise
   void swapBytes(uint16_t *src, uint32_t len, uint16_t *dest = NULL);
+  /*!
+    @brief   Bytes sent to the display since the last resetByteCount()
+             (always 0 unless SPITFT_COUNT_BYTES is defined).
+    @return  Byte count.
+  */
+  uint32_t getByteCount(void) const { return byteCount; }
+  /*!
+    @brief   Restart the byte count, e.g. before a redraw.
+  */
+  void resetByteCount(void) { byteCount = 0; }
 
   // These functions are similar to the 'write' functions above, but with
   // a chip-select and/or SPI transaction built-in. They're typically used
@@ -264,6 +283,13 @@ public:
   using Adafruit_GFX::drawRGBBitmap; // Check base class first
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
                      int16_t h);
+  // Run-length/palette compressed image from PROGMEM (see drawRLEImage()):
+  void drawRLEImage(int16_t x, int16_t y, const uint8_t *image,
+                    const uint16_t *palette = NULL);
+  // Opaque text of the classic font is streamed glyph by glyph:
+  using Adafruit_GFX::drawChar;
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                uint16_t bg, uint8_t size_x, uint8_t size_y);
 
   void invertDisplay(bool i);
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
@@ -535,6 +561,9 @@ protected:
   uint8_t invertOffCommand = 0; ///< Command to disable invert mode
 
   uint32_t _freq = 0; ///< Dummy var to keep subclasses happy
+
+  // Always present, so the class layout does not depend on the flag
+  uint32_t byteCount = 0; ///< Bytes sent (SPITFT_COUNT_BYTES)
 };
 
 #endif // end __AVR_ATtiny85__ __AVR_ATtiny84__
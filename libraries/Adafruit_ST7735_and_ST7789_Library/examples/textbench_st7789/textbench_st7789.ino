@@ -0,0 +1,97 @@
+/**************************************************************************
+  Text rendering benchmark for ST7789 displays.
+
+  Replaces the same string at text sizes 1, 2, 3 and 6 in three ways and
+  prints the bytes sent to the display and the time per string:
+
+  - clear+transp: fillRect() over the text, then transparent text
+                  (one address window per font pixel)
+  - opaque/pixel: Adafruit_GFX::drawChar() with a background color
+                  (one address window per font pixel, background included)
+  - opaque/glyph: Adafruit_SPITFT::drawChar() with a background color
+                  (one address window per glyph, pixels streamed)
+
+  Byte counts need SPITFT_COUNT_BYTES (off by default, build with
+  -DSPITFT_COUNT_BYTES, see Adafruit_SPITFT.h), otherwise they read 0.
+  Output goes to the serial monitor (115200 baud).
+
+  MIT license, all text above must be included in any redistribution
+ **************************************************************************/
+
+#include <Adafruit_GFX.h>    // Core graphics library
+#include <Adafruit_ST7789.h> // Hardware-specific library for ST7789
+#include <SPI.h>
+
+#define TFT_CS        10
+#define TFT_RST        9 // Or set to -1 and connect to Arduino RESET pin
+#define TFT_DC         8
+
+Adafruit_ST7789 tft = Adafruit_ST7789(TFT_CS, TFT_DC, TFT_RST);
+
+// Longest string that fits 240 pixels at size 6 (6 x 36 = 216)
+const char text[] = "C/D 42";
+const uint8_t sizes[] = {1, 2, 3, 6};
+const uint8_t REPEAT = 4; // Strings per measurement (result is the average)
+
+enum Method { CLEAR_TRANSPARENT, OPAQUE_PIXEL, OPAQUE_GLYPH };
+
+void drawText(Method method, uint8_t size, uint16_t color) {
+  int16_t x = 0, y = 0;
+  uint8_t len = strlen(text);
+
+  if (method == CLEAR_TRANSPARENT) {
+    tft.fillRect(x, y, len * 6 * size, 8 * size, ST77XX_BLACK);
+  }
+  for (uint8_t i = 0; i < len; i++, x += 6 * size) {
+    switch (method) {
+    case CLEAR_TRANSPARENT:
+      tft.Adafruit_GFX::drawChar(x, y, text[i], color, color, size, size);
+      break;
+    case OPAQUE_PIXEL:
+      tft.Adafruit_GFX::drawChar(x, y, text[i], color, ST77XX_BLACK, size,
+                                 size);
+      break;
+    case OPAQUE_GLYPH:
+      tft.drawChar(x, y, text[i], color, ST77XX_BLACK, size, size);
+      break;
+    }
+  }
+}
+
+void measure(Method method, uint8_t size) {
+  tft.resetByteCount();
+  uint32_t start = micros();
+  for (uint8_t r = 0; r < REPEAT; r++) {
+    drawText(method, size, (r & 1) ? ST77XX_YELLOW : ST77XX_GREEN);
+  }
+  uint32_t time = micros() - start;
+
+  Serial.print(F("  "));
+  Serial.print(tft.getByteCount() / REPEAT);
+  Serial.print(F(" bytes, "));
+  Serial.print(time / REPEAT);
+  Serial.print(F(" us"));
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  Serial.println(F("ST7789 text benchmark"));
+
+  tft.init(240, 320); // Init ST7789 320x240
+  tft.fillScreen(ST77XX_BLACK);
+
+  Serial.print(F("String \""));
+  Serial.print(text);
+  Serial.println(F("\", per string:"));
+  Serial.println(F("size  clear+transp  opaque/pixel  opaque/glyph"));
+
+  for (uint8_t i = 0; i < sizeof(sizes); i++) {
+    Serial.print(sizes[i]);
+    measure(CLEAR_TRANSPARENT, sizes[i]);
+    measure(OPAQUE_PIXEL, sizes[i]);
+    measure(OPAQUE_GLYPH, sizes[i]);
+    Serial.println();
+  }
+}
+
+void loop() {}
@@ -139,6 +139,44 @@ static uint8_t gTimeErrorAccum256ths;
 
 #define FASTLED_HAS_CLOCKLESS 1
 
+// ClocklessController::showRuns() uses a hand-timed loop for 800 kHz chipsets at 16 MHz
+// that writes the port with OUT, so it needs a classic AVR with the pin in I/O space.
+#if (F_CPU == 16000000) && !defined(__AVR_ATmega4809__) && !defined(__AVR_ATtinyxy7__) && !defined(__AVR_ATtinyxy6__) && !defined(__AVR_ATtinyxy4__) && !defined(__AVR_ATtinyxy2__)
+#define FASTLED_HAS_CLOCKLESS_RUNS 1
+#ifndef FASTLED_MAX_PIXEL_RUNS
+/// Upper bound for palette entries and (merged) runs per ClocklessController::showRuns() call
+#define FASTLED_MAX_PIXEL_RUNS 32
+#endif
+
+// With FASTLED_AVR_INTERRUPT_WINDOWS 1, showRuns() sends the frame in chunks and enables
+// interrupts between them, so Timer0 (millis()) and timer compare ISRs never wait longer
+// than one chunk. While the ISRs run the data line is low; if that gap gets longer than
+// FASTLED_AVR_CHUNK_SLACK_US the strip may have latched a partial frame, so the frame is
+// sent again after FASTLED_AVR_RESET_US low (see ClocklessController::retriedFrames()).
+#ifndef FASTLED_AVR_INTERRUPT_WINDOWS
+#define FASTLED_AVR_INTERRUPT_WINDOWS 0
+#endif
+#ifndef FASTLED_AVR_CHUNK_LEDS
+/// Pixels per chunk; 24 pixels are 720us, shorter than one Timer0 overflow (1024us)
+#define FASTLED_AVR_CHUNK_LEDS 24
+#endif
+#ifndef FASTLED_AVR_CHUNK_SLACK_US
+/// Longest measured gap between two chunks. WS2812B latch after 50us low (newer ones after
+/// 280us); the measurement has 4us resolution and misses about 5us of loop overhead.
+#define FASTLED_AVR_CHUNK_SLACK_US 40
+#endif
+#ifndef FASTLED_AVR_RESET_US
+/// Low time before a failed frame is sent again, so every strip has latched (and so
+/// discarded) the partial frame first. Must cover the slowest latch on the strip
+/// (newer WS2812B: 280us).
+#define FASTLED_AVR_RESET_US 300
+#endif
+#ifndef FASTLED_AVR_CHUNK_RETRIES
+/// Attempts with interrupt windows before the frame is sent with interrupts disabled
+#define FASTLED_AVR_CHUNK_RETRIES 3
+#endif
+#endif
+
 template <uint8_t DATA_PIN, int T1, int T2, int T3, EOrder RGB_ORDER = RGB, int XTRA0 = 0, bool FLIP = false, int WAIT_TIME = 10>
 class ClocklessController : public CPixelLEDController<RGB_ORDER> {
 	static_assert(T1 >= 2 && T2 >= 2 && T3 >= 3, "Not enough cycles - use a higher clock speed");
@@ -167,15 +205,27 @@ protected:
 			showRGBInternal(pixels);
 		}
 
-		// Adjust the timer
+		// Adjust the timer (scales with the number of pixels actually sent)
+#if (!defined(NO_CLOCK_CORRECTION) || (NO_CLOCK_CORRECTION == 0)) && (FASTLED_ALLOW_INTERRUPTS == 0)
+		adjustClock(pixels.size());
+#endif
+
+#if (!defined(FASTLED_ALLOW_INTERRUPTS) || FASTLED_ALLOW_INTERRUPTS == 0)
+		sei();
+#endif
+		mWait.mark();
+	}
+
 #if (!defined(NO_CLOCK_CORRECTION) || (NO_CLOCK_CORRECTION == 0)) && (FASTLED_ALLOW_INTERRUPTS == 0)
-		uint32_t microsTaken = pixels.size();
+	// Add the time interrupts were disabled for nLeds pixels to the millis() counter
+	static void adjustClock(uint16_t nLeds) {
+		uint32_t microsTaken = nLeds;
 		microsTaken *= CLKS_TO_MICROS(24 * (T1 + T2 + T3));
 
         // adust for approximate observed actal runtime (as of January 2015)
         // roughly 9.6 cycles per pixel, which is 0.6us/pixel at 16MHz
         // microsTaken += nLeds * 0.6 * CLKS_TO_MICROS(16);
-        microsTaken += scale16by8(pixels.size(),(0.6 * 256) + 1) * CLKS_TO_MICROS(16);
+        microsTaken += scale16by8(nLeds,(0.6 * 256) + 1) * CLKS_TO_MICROS(16);
 
         // if less than 1000us, there is NO timer impact,
         // this is because the ONE interrupt that might come in while interrupts
@@ -216,14 +266,8 @@ protected:
 		//uint16_t microsTaken = (uint32_t)nLeds * (uint32_t)CLKS_TO_MICROS((24) * (T1 + T2 + T3));
         MS_COUNTER += static_cast<uint16_t>(microsTaken >> 10);
 #endif
-
-#endif
-
-#if (!defined(FASTLED_ALLOW_INTERRUPTS) || FASTLED_ALLOW_INTERRUPTS == 0)
-		sei();
-#endif
-		mWait.mark();
 	}
+#endif
 #define USE_ASM_MACROS
 
 
@@ -593,8 +637,252 @@ protected:
 
 	}
 
+#if FASTLED_HAS_CLOCKLESS_RUNS
+public:
+	/// Write a frame that consists of runs of equally coloured pixels (e.g. the segments
+	/// of a seven-segment display) without a CRGB buffer for the whole strip.
+	///
+	/// Run @p i is @p lengths[i] pixels of @p palette[@p indices[i]]. Brightness and colour
+	/// correction are applied once per palette entry; the bit-banging loop only shifts out
+	/// prepared bytes. Neighbouring runs of the same entry are merged, empty runs skipped.
+	/// Between two runs the line stays low about 1us longer than between pixels, far below
+	/// the latch time of the chipset. No dithering.
+	/// @param palette the colours referenced by @p indices
+	/// @param paletteSize number of entries in @p palette (at most FASTLED_MAX_PIXEL_RUNS)
+	/// @param indices palette index of each run
+	/// @param lengths number of pixels of each run
+	/// @param nRuns number of runs (at most FASTLED_MAX_PIXEL_RUNS after merging)
+	/// @param maxLeds stop after this many pixels, the rest keep their latched colour
+	/// @param brightness the brightness of the LEDs
+	/// @returns the number of pixels written
+	uint16_t showRuns(const CRGB *palette, uint8_t paletteSize, const uint8_t *indices, const uint8_t *lengths,
+	                  uint8_t nRuns, uint16_t maxLeds, uint8_t brightness) {
+		static_assert(T1 + T2 + T3 == 20, "showRuns() needs an 800 kHz chipset at 16 MHz (20 cycles per bit)");
+
+		if(paletteSize > FASTLED_MAX_PIXEL_RUNS) { paletteSize = FASTLED_MAX_PIXEL_RUNS; }
+
+		// Scale every palette entry once and store it in wire order
+		CRGB adj = this->getAdjustmentData(brightness).premixed;
+		uint8_t wire[3 * FASTLED_MAX_PIXEL_RUNS];
+		for(uint8_t p = 0; p < paletteSize; p++) {
+			wire[3 * p + 0] = scale8(palette[p].raw[RO(0)], adj.raw[RO(0)]);
+			wire[3 * p + 1] = scale8(palette[p].raw[RO(1)], adj.raw[RO(1)]);
+			wire[3 * p + 2] = scale8(palette[p].raw[RO(2)], adj.raw[RO(2)]);
+		}
+
+		// Run table for the asm loop: {offset into wire[], pixel count}
+		uint8_t runs[2 * FASTLED_MAX_PIXEL_RUNS];
+		uint8_t nOut = 0;
+		uint16_t nLeds = 0;
+		for(uint8_t r = 0; r < nRuns && nLeds < maxLeds; r++) {
+			uint8_t offset = (indices[r] < paletteSize) ? 3 * indices[r] : 0;
+			uint8_t len = lengths[r];
+			if(len > maxLeds - nLeds) { len = maxLeds - nLeds; }
+			if(len == 0) { continue; }
+
+			if(nOut > 0 && runs[2 * nOut - 2] == offset && runs[2 * nOut - 1] <= 255 - len) {
+				runs[2 * nOut - 1] += len;
+			} else {
+				if(nOut == FASTLED_MAX_PIXEL_RUNS) { break; }
+				runs[2 * nOut] = offset;
+				runs[2 * nOut + 1] = len;
+				nOut++;
+			}
+			nLeds += len;
+		}
+		if(nOut == 0) { return 0; }
+
+		mWait.wait();
+#if FASTLED_AVR_INTERRUPT_WINDOWS
+		// No clock correction needed: interrupts are never off longer than one chunk
+		uint8_t attempt = 0;
+		while(!showRunsChunked(wire, runs, nOut)) {
+			if(attempt == 0 && sRetriedFrames < 0xFFFF) { sRetriedFrames++; }
+			// A gap above the slack may or may not have latched the strip: hold the line low
+			// for the full reset time, or the retry is clocked in behind the partial frame
+			uint32_t lowSince = micros();
+			while((micros() - lowSince) < FASTLED_AVR_RESET_US) { }
+			if(++attempt < FASTLED_AVR_CHUNK_RETRIES) { continue; }
+
+			// Keep ISRs out for this one frame rather than showing a broken one
+			cli();
+			showRunsInternal(wire, runs, nOut);
+#if (!defined(NO_CLOCK_CORRECTION) || (NO_CLOCK_CORRECTION == 0)) && (FASTLED_ALLOW_INTERRUPTS == 0)
+			adjustClock(nLeds);
+#endif
+			sei();
+			break;
+		}
+#else
+		cli();
+		showRunsInternal(wire, runs, nOut);
+#if (!defined(NO_CLOCK_CORRECTION) || (NO_CLOCK_CORRECTION == 0)) && (FASTLED_ALLOW_INTERRUPTS == 0)
+		adjustClock(nLeds);
+#endif
+		sei();
+#endif
+		mWait.mark();
+		return nLeds;
+	}
+
+#if FASTLED_AVR_INTERRUPT_WINDOWS
+	/// Number of frames (saturating at 65535) that had to be sent again because an
+	/// interrupt between two chunks kept the line low longer than FASTLED_AVR_CHUNK_SLACK_US
+	static uint16_t retriedFrames() { return sRetriedFrames; }
+#endif
+
+private:
+	// One bit is 20 cycles: high at T=0, low at T=5 for a 0 and at T=13 for a 1 (cycle
+	// counts in the comments are at the end of each instruction). Each colour byte has its own
+	// copy of the bit loop, so switching bytes costs no extra cycles; only loading the
+	// next run stretches the low phase by 15 cycles.
+	static void showRunsInternal(const uint8_t *wire, const uint8_t *runs, uint8_t nRuns) {
+		data_ptr_t port = FastPin<DATA_PIN>::port();
+		data_t mask = FastPin<DATA_PIN>::mask();
+		uint8_t hi = *port | mask;
+		uint8_t lo = *port & ~mask;
+		*port = lo;
+
+		const uint8_t *x = runs + 2;
+		const uint8_t *z;
+		uint8_t c0 = wire[runs[0] + 0];
+		uint8_t c1 = wire[runs[0] + 1];
+		uint8_t c2 = wire[runs[0] + 2];
+		uint8_t count = runs[1];
+		uint8_t left = nRuns - 1;
+		uint8_t b = c0;
+		uint8_t bit = 8;
+		uint8_t next = lo;
+		uint8_t t;
+
+#define RUNS_BIT_LOOP(N, NEXT_BYTE)                                                     \
+		"H" #N "_%=:\n\t"                                                               \
+		"out %[PORT], %[hi]\n\t"        /* 1      T= 1  high                      */   \
+		"sbrc %[b], 7\n\t"              /* 1-2                                    */   \
+		"mov %[next], %[hi]\n\t"        /* 0-1    T= 3                            */   \
+		"dec %[bit]\n\t"                /* 1      T= 4                            */   \
+		"nop\n\t"                       /* 1      T= 5                            */   \
+		"out %[PORT], %[next]\n\t"      /* 1      T= 6  low for a 0               */   \
+		"mov %[next], %[lo]\n\t"        /* 1      T= 7                            */   \
+		"breq B" #N "_%=\n\t"           /* 1-2    T= 8 (T= 9 at end of byte)      */   \
+		"lsl %[b]\n\t"                  /* 1      T= 9                            */   \
+		"rjmp .+0\n\t"                  /* 2      T=11                            */   \
+		"rjmp .+0\n\t"                  /* 2      T=13                            */   \
+		"out %[PORT], %[lo]\n\t"        /* 1      T=14  low for a 1               */   \
+		"rjmp .+0\n\t"                  /* 2      T=16                            */   \
+		"rjmp .+0\n\t"                  /* 2      T=18                            */   \
+		"rjmp H" #N "_%=\n\t"           /* 2      T=20                            */   \
+		"B" #N "_%=:\n\t"                                                               \
+		"ldi %[bit], 8\n\t"             /* 1      T=10                            */   \
+		"mov %[b], %[" #NEXT_BYTE "]\n\t" /* 1    T=11                            */
+
+		asm __volatile__(
+			RUNS_BIT_LOOP(0, c1)
+			"rjmp .+0\n\t"                  // 2      T=13
+			"out %[PORT], %[lo]\n\t"        // 1      T=14
+			"rjmp .+0\n\t"                  // 2      T=16
+			"rjmp .+0\n\t"                  // 2      T=18
+			"rjmp .+0\n\t"                  // 2      T=20, fall through to H1
+			RUNS_BIT_LOOP(1, c2)
+			"rjmp .+0\n\t"                  // 2      T=13
+			"out %[PORT], %[lo]\n\t"        // 1      T=14
+			"rjmp .+0\n\t"                  // 2      T=16
+			"rjmp .+0\n\t"                  // 2      T=18
+			"rjmp .+0\n\t"                  // 2      T=20, fall through to H2
+			RUNS_BIT_LOOP(2, c0)
+			"dec %[count]\n\t"              // 1      T=12
+			"nop\n\t"                       // 1      T=13
+			"out %[PORT], %[lo]\n\t"        // 1      T=14
+			"breq R_%=\n\t"                 // 1-2    T=15 (T=16 at end of run)
+			"rjmp .+0\n\t"                  // 2      T=17
+			"nop\n\t"                       // 1      T=18
+			"rjmp H0_%=\n\t"                // 2      T=20
+			"R_%=:\n\t"
+			"tst %[left]\n\t"               // 1      T=17
+			"breq D_%=\n\t"                 // 1      T=18
+			"dec %[left]\n\t"               // 1      T=19
+			"ld %[t], %a[x]+\n\t"           // 2      T=21
+			"movw %[z], %[wire]\n\t"        // 1      T=22
+			"add %A[z], %[t]\n\t"           // 1      T=23
+			"adc %B[z], __zero_reg__\n\t"   // 1      T=24
+			"ld %[c0], %a[z]+\n\t"          // 2      T=26
+			"ld %[c1], %a[z]+\n\t"          // 2      T=28
+			"ld %[c2], %a[z]\n\t"           // 2      T=30
+			"ld %[count], %a[x]+\n\t"       // 2      T=32
+			"mov %[b], %[c0]\n\t"           // 1      T=33
+			"rjmp H0_%=\n\t"                // 2      T=35
+			"D_%=:\n\t"
+			: [b] "+r" (b), [bit] "+d" (bit), [next] "+r" (next),
+			  [c0] "+r" (c0), [c1] "+r" (c1), [c2] "+r" (c2),
+			  [count] "+r" (count), [left] "+r" (left), [t] "=&r" (t),
+			  [x] "+x" (x), [z] "=&z" (z)
+			: [PORT] ASM_VAR_PORT, [hi] "r" (hi), [lo] "r" (lo), [wire] "r" (wire)
+			: "cc", "memory");
+#undef RUNS_BIT_LOOP
+	}
+
+#if FASTLED_AVR_INTERRUPT_WINDOWS
+	static uint16_t sRetriedFrames;
+
+	// Send the run table in chunks of at most FASTLED_AVR_CHUNK_LEDS pixels with interrupts
+	// enabled in between. A run crossing a chunk border is split by shortening the first and
+	// last table entry of the chunk for the duration of the chunk; the table is unchanged on
+	// return. Returns false if a gap was longer than FASTLED_AVR_CHUNK_SLACK_US.
+	static bool showRunsChunked(const uint8_t *wire, uint8_t *runs, uint8_t nRuns) {
+		uint8_t r = 0;       // first run of the next chunk
+		uint8_t done = 0;    // pixels of run r sent in earlier chunks
+		uint32_t lowSince = 0;
+
+		while(r < nRuns) {
+			// Last run e of this chunk and the number of its pixels that fit
+			uint8_t e = r;
+			uint8_t room = FASTLED_AVR_CHUNK_LEDS;
+			uint8_t part = runs[2 * r + 1] - done;
+			while(part < room && e + 1 < nRuns) {
+				room -= part;
+				e++;
+				part = runs[2 * e + 1];
+			}
+			if(part > room) { part = room; }
+
+			uint8_t lenR = runs[2 * r + 1];
+			uint8_t lenE = runs[2 * e + 1];
+			uint8_t skip = (e == r) ? done : 0;
+			runs[2 * r + 1] = lenR - done;
+			runs[2 * e + 1] = part;
+
+			cli();
+			bool late = (r > 0 || done > 0) && (micros() - lowSince) > FASTLED_AVR_CHUNK_SLACK_US;
+			if(!late) {
+				showRunsInternal(wire, runs + 2 * r, e - r + 1);
+				lowSince = micros();
+			}
+			sei();
+
+			runs[2 * r + 1] = lenR;
+			runs[2 * e + 1] = lenE;
+			if(late) { return false; }
+
+			if(skip + part == lenE) {
+				r = e + 1;
+				done = 0;
+			} else {
+				r = e;
+				done = skip + part;
+			}
+		}
+		return true;
+	}
+#endif
+#endif
+
 };
 
+#if FASTLED_HAS_CLOCKLESS_RUNS && FASTLED_AVR_INTERRUPT_WINDOWS
+template <uint8_t DATA_PIN, int T1, int T2, int T3, EOrder RGB_ORDER, int XTRA0, bool FLIP, int WAIT_TIME>
+uint16_t ClocklessController<DATA_PIN, T1, T2, T3, RGB_ORDER, XTRA0, FLIP, WAIT_TIME>::sRetriedFrames = 0;
+#endif
+
 #endif
 
 FASTLED_NAMESPACE_END
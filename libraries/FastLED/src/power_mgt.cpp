@@ -87,14 +87,40 @@ uint32_t calculate_unscaled_power_mW( const CRGB* ledbuffer, uint16_t numLeds )
     return total;
 }
 
+uint32_t calculate_unscaled_power_mW( const CRGB* palette, const uint8_t* indices, const uint8_t* lengths, uint8_t nRuns )
+{
+    uint32_t red32 = 0, green32 = 0, blue32 = 0;
+    uint16_t numLeds = 0;
+
+    for( uint8_t r = 0; r < nRuns; ++r) {
+        const CRGB& color = palette[indices[r]];
+        uint8_t len = lengths[r];
+        red32   += (uint16_t)color.r * len;
+        green32 += (uint16_t)color.g * len;
+        blue32  += (uint16_t)color.b * len;
+        numLeds += len;
+    }
+
+    red32   *= gRed_mW;
+    green32 *= gGreen_mW;
+    blue32  *= gBlue_mW;
+
+    red32   >>= 8;
+    green32 >>= 8;
+    blue32  >>= 8;
+
+    uint32_t total = red32 + green32 + blue32 + (gDark_mW * numLeds);
+
+    return total;
+}
+
 
 uint8_t calculate_max_brightness_for_power_vmA(const CRGB* ledbuffer, uint16_t numLeds, uint8_t target_brightness, uint32_t max_power_V, uint32_t max_power_mA) {
 	return calculate_max_brightness_for_power_mW(ledbuffer, numLeds, target_brightness, max_power_V * max_power_mA);
 }
 
-uint8_t calculate_max_brightness_for_power_mW(const CRGB* ledbuffer, uint16_t numLeds, uint8_t target_brightness, uint32_t max_power_mW) {
- 	uint32_t total_mW = calculate_unscaled_power_mW( ledbuffer, numLeds);
-
+// scales target_brightness down so that total_mW (at brightness 255) stays below max_power_mW
+static uint8_t limit_brightness_for_power_mW(uint32_t total_mW, uint8_t target_brightness, uint32_t max_power_mW) {
 	uint32_t requested_power_mW = ((uint32_t)total_mW * target_brightness) / 256;
 
 	uint8_t recommended_brightness = target_brightness;
@@ -105,6 +131,14 @@ uint8_t calculate_max_brightness_for_power_mW(const CRGB* ledbuffer, uint16_t nu
 	return recommended_brightness;
 }
 
+uint8_t calculate_max_brightness_for_power_mW(const CRGB* ledbuffer, uint16_t numLeds, uint8_t target_brightness, uint32_t max_power_mW) {
+	return limit_brightness_for_power_mW(calculate_unscaled_power_mW( ledbuffer, numLeds), target_brightness, max_power_mW);
+}
+
+uint8_t calculate_max_brightness_for_power_mW(const CRGB* palette, const uint8_t* indices, const uint8_t* lengths, uint8_t nRuns, uint8_t target_brightness, uint32_t max_power_mW) {
+	return limit_brightness_for_power_mW(calculate_unscaled_power_mW( palette, indices, lengths, nRuns), target_brightness, max_power_mW);
+}
+
 // sets brightness to
 //  - no more than target_brightness
 //  - no more than max_mW milliwatts
@@ -67,6 +67,15 @@ void delay_at_max_brightness_for_power( uint16_t ms);
 /// @returns the number of milliwatts the LED data would consume at max brightness
 uint32_t calculate_unscaled_power_mW( const CRGB* ledbuffer, uint16_t numLeds);
 
+/// Determines how many milliwatts a strip made of runs of equally coloured LEDs
+/// would draw at max brightness (255). Costs one step per run instead of one per LED.
+/// @param palette the colours referenced by @p indices
+/// @param indices palette index of each run
+/// @param lengths number of LEDs of each run
+/// @param nRuns the number of runs
+/// @returns the number of milliwatts the LED data would consume at max brightness
+uint32_t calculate_unscaled_power_mW( const CRGB* palette, const uint8_t* indices, const uint8_t* lengths, uint8_t nRuns);
+
 /// Determines the highest brightness level you can use and still stay under
 /// the specified power budget for a given set of LEDs.
 /// @param ledbuffer the LED data to check
@@ -87,6 +96,18 @@ uint8_t calculate_max_brightness_for_power_mW(const CRGB* ledbuffer, uint16_t nu
 /// but may be lower depending on the power limit.
 uint8_t calculate_max_brightness_for_power_vmA(const CRGB* ledbuffer, uint16_t numLeds, uint8_t target_brightness, uint32_t max_power_V, uint32_t max_power_mA);
 
+/// @copybrief calculate_max_brightness_for_power_mW()
+/// Variant for run-length data, see calculate_unscaled_power_mW(const CRGB*, const uint8_t*, const uint8_t*, uint8_t).
+/// @param palette the colours referenced by @p indices
+/// @param indices palette index of each run
+/// @param lengths number of LEDs of each run
+/// @param nRuns the number of runs
+/// @param target_brightness the brightness you'd ideally like to use
+/// @param max_power_mW the max power draw desired, in milliwatts
+/// @returns a limited brightness value. No higher than the target brightness,
+/// but may be lower depending on the power limit.
+uint8_t calculate_max_brightness_for_power_mW(const CRGB* palette, const uint8_t* indices, const uint8_t* lengths, uint8_t nRuns, uint8_t target_brightness, uint32_t max_power_mW);
+
 /// Determines the highest brightness level you can use and still stay under
 /// the specified power budget for all sets of LEDs. 
 /// Unlike the other internal power functions which use a pointer to a
@@ -1529,6 +1529,13 @@ uint8_t RF24::getDynamicPayloadSize(void)
 
 /****************************************************************************/
 
+bool RF24::isDynamicPayloads(void)
+{
+    return dynamic_payloads_enabled;
+}
+
+/****************************************************************************/
+
 bool RF24::available(void)
 {
     return (read_register(FIFO_STATUS) & 1) == 0;
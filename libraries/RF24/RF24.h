@@ -1578,6 +1578,18 @@ public:
      */
     uint8_t getDynamicPayloadSize(void);
 
+    /**
+     * Are dynamic payloads enabled?
+     *
+     * Tells a receive handler (e.g. RF24RxQueue) whether the length of the
+     * next payload comes from getDynamicPayloadSize() or getPayloadSize().
+     *
+     * @see enableDynamicPayloads(), enableAckPayload()
+     *
+     * @return true if dynamic payloads are enabled
+     */
+    bool isDynamicPayloads(void);
+
     /**
      * Enable custom payloads in the acknowledge packets
      *
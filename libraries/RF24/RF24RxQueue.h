@@ -0,0 +1,303 @@
+/**
+ * @file RF24RxQueue.h
+ *
+ * Interrupt-driven receive queue for RF24 (header only)
+ */
+
+#ifndef RF24_RX_QUEUE_H_
+#define RF24_RX_QUEUE_H_
+
+#include "RF24.h"
+
+/**
+ * Interrupt-driven receive queue
+ *
+ * Instead of polling available() (one SPI transaction per call) the
+ * application attaches the radio's IRQ pin to an interrupt and calls fetch()
+ * from its ISR. fetch() moves every payload from the RX FIFO into a
+ * single-producer/single-consumer ring buffer and stamps it with the time of
+ * the interrupt. The main context takes the packets with read() or process()
+ * without any SPI traffic.
+ *
+ * - Only the RX_DR interrupt is used (begin() masks TX_DS and MAX_RT).
+ * - The ring buffer is lock-free: fetch() only advances the head, read() and
+ *   process() only advance the tail.
+ * - When the ring buffer is full, fetch() stops reading and overflows() counts
+ *   the event. The payloads stay in the RX FIFO (they were acknowledged and
+ *   must not be lost); once the FIFO is full the radio stops acknowledging, so
+ *   the sender retries. Call fetch() again after read()/process() made room
+ *   (see stalled()). Payloads the radio could not store because its own FIFO
+ *   was full are counted as well.
+ * - A payload longer than PAYLOAD_SIZE is truncated, Packet::length keeps the
+ *   real length. A corrupt dynamic payload (see getDynamicPayloadSize()) is
+ *   queued with Packet::length 0.
+ *
+ * @warning While the interrupt is attached, the application must not call
+ * RF24::available() or RF24::read() itself, and fetch() from the main context
+ * must run with interrupts disabled (it is the only producer).
+ *
+ * @tparam SLOTS Number of packets in the ring buffer (power of 2, 2 to 128)
+ * @tparam PAYLOAD_SIZE Bytes stored per packet (1 to 32)
+ *
+ * @code
+ * RF24 radio(CE_PIN, CSN_PIN);
+ * RF24RxQueue<4, sizeof(Message)> rxQueue(radio);
+ *
+ * void onRadioIrq() { rxQueue.fetch(); }
+ *
+ * void setup() {
+ *   radio.begin();
+ *   // ... pipes, startListening()
+ *   rxQueue.begin(digitalPinToInterrupt(IRQ_PIN));
+ *   attachInterrupt(digitalPinToInterrupt(IRQ_PIN), onRadioIrq, FALLING);
+ * }
+ *
+ * void loop() {
+ *   RF24RxQueue<4, sizeof(Message)>::Packet packet;
+ *   while (rxQueue.read(packet)) {
+ *     // packet.timestamp, packet.pipe, packet.length, packet.payload
+ *   }
+ *   if (rxQueue.stalled()) {
+ *     noInterrupts();
+ *     rxQueue.fetch();   // No falling edge while payloads wait in the FIFO
+ *     interrupts();
+ *   }
+ * }
+ * @endcode
+ */
+template<uint8_t SLOTS, uint8_t PAYLOAD_SIZE = 32>
+class RF24RxQueue
+{
+    static_assert(SLOTS >= 2 && SLOTS <= 128 && (SLOTS & (SLOTS - 1)) == 0, "SLOTS must be a power of 2 (2 to 128)");
+    static_assert(PAYLOAD_SIZE >= 1 && PAYLOAD_SIZE <= 32, "PAYLOAD_SIZE must be 1 to 32 bytes");
+
+public:
+    /**
+     * A received payload
+     */
+    struct Packet
+    {
+        /** Time of the interrupt that fetched the payload (see Clock) */
+        uint32_t timestamp;
+        /** Pipe the payload was received on */
+        uint8_t pipe;
+        /** Length of the payload on air (0 = corrupt payload, flushed by the radio) */
+        uint8_t length;
+        /** The first PAYLOAD_SIZE bytes of the payload */
+        uint8_t payload[PAYLOAD_SIZE];
+    };
+
+    /**
+     * Time source for Packet::timestamp (called from the ISR)
+     */
+    typedef uint32_t (*Clock)(void);
+
+    /**
+     * Packet handler for process()
+     * @param context The pointer passed to process()
+     * @param packet The packet (only valid during the call)
+     */
+    typedef void (*Callback)(void* context, const Packet& packet);
+
+    /**
+     * @param radio The radio, initialized and listening before begin()
+     * @param clock Time source for Packet::timestamp (e.g. micros or millis)
+     */
+    RF24RxQueue(RF24& radio, Clock clock)
+        : radio(radio), clock(clock), head(0), tail(0), overflowCount(0), stall(false)
+    {
+    }
+
+#if defined(ARDUINO)
+    explicit RF24RxQueue(RF24& radio)
+        : RF24RxQueue(radio, micros)
+    {
+    }
+#endif
+
+    /**
+     * Prepare the radio for interrupt mode and empty the queue
+     *
+     * Masks TX_DS and MAX_RT, so the IRQ pin only reports RX_DR. Call this
+     * before the interrupt is attached.
+     *
+     * @param interruptNumber Interrupt used for the IRQ pin
+     * (digitalPinToInterrupt()), or 255 for pin change interrupts. On AVR,
+     * SPI.usingInterrupt() makes sure the main context never shares the bus
+     * with fetch() (the radio must use the default SPI instance). Other
+     * platforms must guard the main context's radio calls themselves.
+     */
+    void begin(uint8_t interruptNumber)
+    {
+        head = 0;
+        tail = 0;
+        overflowCount = 0;
+        stall = false;
+        radio.maskIRQ(true, true, false);
+#if defined(__AVR__) && defined(RF24_SPI_TRANSACTIONS)
+        SPI.usingInterrupt(interruptNumber);
+#else
+        (void)interruptNumber;
+#endif
+    }
+
+    /**
+     * Move all payloads from the RX FIFO into the queue (producer)
+     *
+     * Call this from the ISR of the IRQ pin. Without an IRQ line it may also
+     * be polled from the main context. RF24::read() clears RX_DR after every
+     * payload, so the loop only ends after the FIFO was seen empty with RX_DR
+     * cleared - the next payload always causes a new falling edge.
+     *
+     * If the queue fills up, the remaining payloads stay in the RX FIFO with
+     * RX_DR set (stalled() returns true). The IRQ line then stays low and
+     * causes no further edge: the main context must call fetch() again once
+     * the queue has room. Those payloads get the timestamp of that call.
+     */
+    void fetch()
+    {
+        uint32_t timestamp = clock();
+        bool dynamic = radio.isDynamicPayloads();
+
+        // Full RX FIFO: further payloads were not acknowledged
+        // (after a stall the FIFO was left full on purpose, already counted)
+        if (!stall && radio.rxFifoFull()) {
+            countOverflow();
+        }
+        stall = false;
+
+        uint8_t pipe;
+        while (radio.available(&pipe)) {
+            uint8_t length = dynamic ? radio.getDynamicPayloadSize() : radio.getPayloadSize();
+
+            if ((uint8_t)(head - tail) == SLOTS) {
+                // Consumer too slow: leave the payloads in the RX FIFO. They are
+                // already acknowledged; a full FIFO stops further ACKs instead.
+                stall = true;
+                countOverflow();
+                break;
+            }
+
+            Packet& slot = slots[head & MASK];
+            slot.timestamp = timestamp;
+            slot.pipe = pipe;
+            slot.length = length;
+            if (length > 0) {
+                radio.read(slot.payload, length > PAYLOAD_SIZE ? PAYLOAD_SIZE : length);
+            }
+            else {
+                // getDynamicPayloadSize() already flushed the corrupt payload
+                radio.clearStatusFlags(RF24_RX_DR);
+            }
+
+            barrier();
+            head = head + 1;
+        }
+    }
+
+    /**
+     * @return true if at least one packet is queued
+     */
+    bool available() const
+    {
+        return head != tail;
+    }
+
+    /**
+     * @return Number of queued packets
+     */
+    uint8_t count() const
+    {
+        return (uint8_t)(head - tail);
+    }
+
+    /**
+     * Take the oldest packet (consumer)
+     * @param[out] packet Copy of the packet
+     * @return false if the queue is empty
+     */
+    bool read(Packet& packet)
+    {
+        if (head == tail) {
+            return false;
+        }
+        barrier();
+        packet = slots[tail & MASK];
+        barrier();
+        tail = tail + 1;
+        return true;
+    }
+
+    /**
+     * Hand all queued packets to a callback, oldest first (consumer)
+     *
+     * The packets are not copied. Packets that arrive while the callback runs
+     * are handled in the same call.
+     *
+     * @param callback Called once per packet
+     * @param context Passed to the callback
+     * @return Number of packets handled
+     */
+    uint8_t process(Callback callback, void* context)
+    {
+        uint8_t handled = 0;
+        while (head != tail) {
+            barrier();
+            callback(context, slots[tail & MASK]);
+            barrier();
+            tail = tail + 1;
+            handled++;
+        }
+        return handled;
+    }
+
+    /**
+     * @return true if the last fetch() stopped at a full queue and payloads
+     * wait in the RX FIFO (call fetch() again once there is room)
+     */
+    bool stalled() const
+    {
+        return stall;
+    }
+
+    /**
+     * @return Full RX FIFO or full queue seen by fetch() (stops at 65535)
+     */
+    uint16_t overflows() const
+    {
+        // Written by the ISR: read until two reads agree (no torn 16 bit value)
+        uint16_t value;
+        do {
+            value = overflowCount;
+        } while (value != overflowCount);
+        return value;
+    }
+
+private:
+    static constexpr uint8_t MASK = SLOTS - 1;
+
+    RF24& radio;
+    Clock clock;
+    Packet slots[SLOTS];
+    volatile uint8_t head;           // Next slot to write (free running, fetch() only)
+    volatile uint8_t tail;           // Next slot to read (free running, consumer only)
+    volatile uint16_t overflowCount;
+    volatile bool stall;             // fetch() left payloads in the RX FIFO
+
+    void countOverflow()
+    {
+        if (overflowCount != 0xFFFF) {
+            overflowCount = overflowCount + 1;
+        }
+    }
+
+    /**
+     * Compiler barrier: slot accesses stay between the index check and the index update
+     */
+    static inline void barrier()
+    {
+        __asm__ __volatile__("" ::: "memory");
+    }
+};
+
+#endif // RF24_RX_QUEUE_H_